@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/CacheContentionBenchmark.dir/CacheContentionBenchmark.cpp.o"
+  "CMakeFiles/CacheContentionBenchmark.dir/CacheContentionBenchmark.cpp.o.d"
+  "CacheContentionBenchmark"
+  "CacheContentionBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/CacheContentionBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
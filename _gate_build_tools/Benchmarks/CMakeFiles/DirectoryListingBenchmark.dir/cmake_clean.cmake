@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/DirectoryListingBenchmark.dir/DirectoryListingBenchmark.cpp.o"
+  "CMakeFiles/DirectoryListingBenchmark.dir/DirectoryListingBenchmark.cpp.o.d"
+  "DirectoryListingBenchmark"
+  "DirectoryListingBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DirectoryListingBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
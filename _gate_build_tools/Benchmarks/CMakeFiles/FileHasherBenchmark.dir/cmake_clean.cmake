@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/FileHasherBenchmark.dir/FileHasherBenchmark.cpp.o"
+  "CMakeFiles/FileHasherBenchmark.dir/FileHasherBenchmark.cpp.o.d"
+  "FileHasherBenchmark"
+  "FileHasherBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/FileHasherBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
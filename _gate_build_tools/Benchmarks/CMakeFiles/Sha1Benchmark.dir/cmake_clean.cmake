@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/Sha1Benchmark.dir/Sha1Benchmark.cpp.o"
+  "CMakeFiles/Sha1Benchmark.dir/Sha1Benchmark.cpp.o.d"
+  "Sha1Benchmark"
+  "Sha1Benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Sha1Benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
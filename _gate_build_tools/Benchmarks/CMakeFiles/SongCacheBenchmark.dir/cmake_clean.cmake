@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SongCacheBenchmark.dir/SongCacheBenchmark.cpp.o"
+  "CMakeFiles/SongCacheBenchmark.dir/SongCacheBenchmark.cpp.o.d"
+  "SongCacheBenchmark"
+  "SongCacheBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SongCacheBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/WorkDistributionBenchmark.dir/WorkDistributionBenchmark.cpp.o"
+  "CMakeFiles/WorkDistributionBenchmark.dir/WorkDistributionBenchmark.cpp.o.d"
+  "WorkDistributionBenchmark"
+  "WorkDistributionBenchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/WorkDistributionBenchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
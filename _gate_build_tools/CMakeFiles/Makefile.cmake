@@ -0,0 +1,73 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/miniconda/lib/cmake/fmt/fmt-config-version.cmake"
+  "/root/miniconda/lib/cmake/fmt/fmt-config.cmake"
+  "/root/miniconda/lib/cmake/fmt/fmt-targets-release.cmake"
+  "/root/miniconda/lib/cmake/fmt/fmt-targets.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/tools/Benchmarks/CMakeLists.txt"
+  "/root/repo/tools/CMakeLists.txt"
+  "/root/repo/tools/CachePrebuilder/CMakeLists.txt"
+  "/root/repo/tools/Tests/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "CachePrebuilder/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "Benchmarks/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "Tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/SongCoreHostUtils.dir/DependInfo.cmake"
+  "CachePrebuilder/CMakeFiles/CachePrebuilder.dir/DependInfo.cmake"
+  "Benchmarks/CMakeFiles/DirectoryListingBenchmark.dir/DependInfo.cmake"
+  "Benchmarks/CMakeFiles/WorkDistributionBenchmark.dir/DependInfo.cmake"
+  "Benchmarks/CMakeFiles/FileHasherBenchmark.dir/DependInfo.cmake"
+  "Benchmarks/CMakeFiles/Sha1Benchmark.dir/DependInfo.cmake"
+  "Benchmarks/CMakeFiles/SongCacheBenchmark.dir/DependInfo.cmake"
+  "Benchmarks/CMakeFiles/CacheContentionBenchmark.dir/DependInfo.cmake"
+  "Tests/CMakeFiles/PrebuiltCacheTest.dir/DependInfo.cmake"
+  "Tests/CMakeFiles/DirectoryTest.dir/DependInfo.cmake"
+  "Tests/CMakeFiles/DirectoryManifestTest.dir/DependInfo.cmake"
+  "Tests/CMakeFiles/LibraryWatcherTest.dir/DependInfo.cmake"
+  "Tests/CMakeFiles/WorkStealingTest.dir/DependInfo.cmake"
+  "Tests/CMakeFiles/FileHasherTest.dir/DependInfo.cmake"
+  "Tests/CMakeFiles/Sha1Test.dir/DependInfo.cmake"
+  "Tests/CMakeFiles/SongCacheJournalTest.dir/DependInfo.cmake"
+  "Tests/CMakeFiles/SongCacheChecksumTest.dir/DependInfo.cmake"
+  "Tests/CMakeFiles/RelocationTest.dir/DependInfo.cmake"
+  "Tests/CMakeFiles/RelocationScaleTest.dir/DependInfo.cmake"
+  "Tests/CMakeFiles/LevelHashFileTest.dir/DependInfo.cmake"
+  "Tests/CMakeFiles/WarmRefreshTest.dir/DependInfo.cmake"
+  )
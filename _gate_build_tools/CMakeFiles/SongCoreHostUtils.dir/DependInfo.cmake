@@ -0,0 +1,36 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/SongLoader/LevelMetadata.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/SongLoader/LevelMetadata.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/SongLoader/LevelMetadata.cpp.o.d"
+  "/root/repo/src/SongLoader/LibraryWatcher.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/SongLoader/LibraryWatcher.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/SongLoader/LibraryWatcher.cpp.o.d"
+  "/root/repo/src/Utils/Cache.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Cache.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Cache.cpp.o.d"
+  "/root/repo/src/Utils/Directory.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Directory.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Directory.cpp.o.d"
+  "/root/repo/src/Utils/DirectoryManifest.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/DirectoryManifest.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/DirectoryManifest.cpp.o.d"
+  "/root/repo/src/Utils/File.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/File.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/File.cpp.o.d"
+  "/root/repo/src/Utils/FileHasher.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/FileHasher.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/FileHasher.cpp.o.d"
+  "/root/repo/src/Utils/Fingerprint.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Fingerprint.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Fingerprint.cpp.o.d"
+  "/root/repo/src/Utils/HashedLevelFiles.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/HashedLevelFiles.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/HashedLevelFiles.cpp.o.d"
+  "/root/repo/src/Utils/LevelHashFile.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/LevelHashFile.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/LevelHashFile.cpp.o.d"
+  "/root/repo/src/Utils/OggVorbis.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/OggVorbis.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/OggVorbis.cpp.o.d"
+  "/root/repo/src/Utils/Sha1.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Sha1.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Sha1.cpp.o.d"
+  "/root/repo/src/Utils/SongCacheFile.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/SongCacheFile.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/SongCacheFile.cpp.o.d"
+  "/root/repo/src/Utils/ThreadPool.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/ThreadPool.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/ThreadPool.cpp.o.d"
+  "/root/repo/src/Utils/WavRiff.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/WavRiff.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/WavRiff.cpp.o.d"
+  "/root/repo/src/Utils/WorkStealing.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/WorkStealing.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/WorkStealing.cpp.o.d"
+  "/root/repo/src/Utils/XXHash64.cpp" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/XXHash64.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/XXHash64.cpp.o.d"
+  "/root/repo/tools/shim/config.cpp" "CMakeFiles/SongCoreHostUtils.dir/shim/config.cpp.o" "gcc" "CMakeFiles/SongCoreHostUtils.dir/shim/config.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
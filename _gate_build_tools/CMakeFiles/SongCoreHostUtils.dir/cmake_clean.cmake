@@ -0,0 +1,45 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/SongLoader/LevelMetadata.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/SongLoader/LevelMetadata.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/SongLoader/LibraryWatcher.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/SongLoader/LibraryWatcher.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Cache.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Cache.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Directory.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Directory.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/DirectoryManifest.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/DirectoryManifest.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/File.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/File.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/FileHasher.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/FileHasher.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Fingerprint.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Fingerprint.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/HashedLevelFiles.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/HashedLevelFiles.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/LevelHashFile.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/LevelHashFile.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/OggVorbis.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/OggVorbis.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Sha1.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/Sha1.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/SongCacheFile.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/SongCacheFile.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/ThreadPool.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/ThreadPool.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/WavRiff.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/WavRiff.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/WorkStealing.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/WorkStealing.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/XXHash64.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/root/repo/src/Utils/XXHash64.cpp.o.d"
+  "CMakeFiles/SongCoreHostUtils.dir/shim/config.cpp.o"
+  "CMakeFiles/SongCoreHostUtils.dir/shim/config.cpp.o.d"
+  "libSongCoreHostUtils.a"
+  "libSongCoreHostUtils.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SongCoreHostUtils.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
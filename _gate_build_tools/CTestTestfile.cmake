@@ -0,0 +1,9 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tools
+# Build directory: /root/repo/_gate_build_tools
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("CachePrebuilder")
+subdirs("Benchmarks")
+subdirs("Tests")
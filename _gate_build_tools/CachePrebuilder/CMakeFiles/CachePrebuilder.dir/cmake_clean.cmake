@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/CachePrebuilder.dir/main.cpp.o"
+  "CMakeFiles/CachePrebuilder.dir/main.cpp.o.d"
+  "CachePrebuilder"
+  "CachePrebuilder.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/CachePrebuilder.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/DirectoryManifestTest.dir/DirectoryManifestTest.cpp.o"
+  "CMakeFiles/DirectoryManifestTest.dir/DirectoryManifestTest.cpp.o.d"
+  "DirectoryManifestTest"
+  "DirectoryManifestTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DirectoryManifestTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/DirectoryTest.dir/DirectoryTest.cpp.o"
+  "CMakeFiles/DirectoryTest.dir/DirectoryTest.cpp.o.d"
+  "DirectoryTest"
+  "DirectoryTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/DirectoryTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/FileHasherTest.dir/FileHasherTest.cpp.o"
+  "CMakeFiles/FileHasherTest.dir/FileHasherTest.cpp.o.d"
+  "FileHasherTest"
+  "FileHasherTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/FileHasherTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
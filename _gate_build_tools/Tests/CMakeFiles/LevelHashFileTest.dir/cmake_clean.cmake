@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/LevelHashFileTest.dir/LevelHashFileTest.cpp.o"
+  "CMakeFiles/LevelHashFileTest.dir/LevelHashFileTest.cpp.o.d"
+  "LevelHashFileTest"
+  "LevelHashFileTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/LevelHashFileTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
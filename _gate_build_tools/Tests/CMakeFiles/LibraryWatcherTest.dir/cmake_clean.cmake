@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/LibraryWatcherTest.dir/LibraryWatcherTest.cpp.o"
+  "CMakeFiles/LibraryWatcherTest.dir/LibraryWatcherTest.cpp.o.d"
+  "LibraryWatcherTest"
+  "LibraryWatcherTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/LibraryWatcherTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/PrebuiltCacheTest.dir/PrebuiltCacheTest.cpp.o"
+  "CMakeFiles/PrebuiltCacheTest.dir/PrebuiltCacheTest.cpp.o.d"
+  "PrebuiltCacheTest"
+  "PrebuiltCacheTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/PrebuiltCacheTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
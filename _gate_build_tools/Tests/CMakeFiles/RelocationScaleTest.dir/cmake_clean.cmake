@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/RelocationScaleTest.dir/RelocationScaleTest.cpp.o"
+  "CMakeFiles/RelocationScaleTest.dir/RelocationScaleTest.cpp.o.d"
+  "RelocationScaleTest"
+  "RelocationScaleTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/RelocationScaleTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/RelocationTest.dir/RelocationTest.cpp.o"
+  "CMakeFiles/RelocationTest.dir/RelocationTest.cpp.o.d"
+  "RelocationTest"
+  "RelocationTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/RelocationTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/Sha1Test.dir/Sha1Test.cpp.o"
+  "CMakeFiles/Sha1Test.dir/Sha1Test.cpp.o.d"
+  "Sha1Test"
+  "Sha1Test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Sha1Test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SongCacheChecksumTest.dir/SongCacheChecksumTest.cpp.o"
+  "CMakeFiles/SongCacheChecksumTest.dir/SongCacheChecksumTest.cpp.o.d"
+  "SongCacheChecksumTest"
+  "SongCacheChecksumTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SongCacheChecksumTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
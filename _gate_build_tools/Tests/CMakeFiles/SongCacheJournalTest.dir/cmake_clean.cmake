@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/SongCacheJournalTest.dir/SongCacheJournalTest.cpp.o"
+  "CMakeFiles/SongCacheJournalTest.dir/SongCacheJournalTest.cpp.o.d"
+  "SongCacheJournalTest"
+  "SongCacheJournalTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SongCacheJournalTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/WarmRefreshTest.dir/WarmRefreshTest.cpp.o"
+  "CMakeFiles/WarmRefreshTest.dir/WarmRefreshTest.cpp.o.d"
+  "WarmRefreshTest"
+  "WarmRefreshTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/WarmRefreshTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/WorkStealingTest.dir/WorkStealingTest.cpp.o"
+  "CMakeFiles/WorkStealingTest.dir/WorkStealingTest.cpp.o.d"
+  "WorkStealingTest"
+  "WorkStealingTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/WorkStealingTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
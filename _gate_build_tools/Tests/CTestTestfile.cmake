@@ -0,0 +1,32 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/tools/Tests
+# Build directory: /root/repo/_gate_build_tools/Tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test([=[PrebuiltCacheTest]=] "/root/repo/_gate_build_tools/Tests/PrebuiltCacheTest" "/root/repo/_gate_build_tools/CachePrebuilder/CachePrebuilder")
+set_tests_properties([=[PrebuiltCacheTest]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tools/Tests/CMakeLists.txt;5;add_test;/root/repo/tools/Tests/CMakeLists.txt;8;songcore_add_test;/root/repo/tools/Tests/CMakeLists.txt;0;")
+add_test([=[DirectoryTest]=] "/root/repo/_gate_build_tools/Tests/DirectoryTest")
+set_tests_properties([=[DirectoryTest]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tools/Tests/CMakeLists.txt;5;add_test;/root/repo/tools/Tests/CMakeLists.txt;9;songcore_add_test;/root/repo/tools/Tests/CMakeLists.txt;0;")
+add_test([=[DirectoryManifestTest]=] "/root/repo/_gate_build_tools/Tests/DirectoryManifestTest")
+set_tests_properties([=[DirectoryManifestTest]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tools/Tests/CMakeLists.txt;5;add_test;/root/repo/tools/Tests/CMakeLists.txt;10;songcore_add_test;/root/repo/tools/Tests/CMakeLists.txt;0;")
+add_test([=[LibraryWatcherTest]=] "/root/repo/_gate_build_tools/Tests/LibraryWatcherTest")
+set_tests_properties([=[LibraryWatcherTest]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tools/Tests/CMakeLists.txt;5;add_test;/root/repo/tools/Tests/CMakeLists.txt;11;songcore_add_test;/root/repo/tools/Tests/CMakeLists.txt;0;")
+add_test([=[WorkStealingTest]=] "/root/repo/_gate_build_tools/Tests/WorkStealingTest")
+set_tests_properties([=[WorkStealingTest]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tools/Tests/CMakeLists.txt;5;add_test;/root/repo/tools/Tests/CMakeLists.txt;12;songcore_add_test;/root/repo/tools/Tests/CMakeLists.txt;0;")
+add_test([=[FileHasherTest]=] "/root/repo/_gate_build_tools/Tests/FileHasherTest")
+set_tests_properties([=[FileHasherTest]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tools/Tests/CMakeLists.txt;5;add_test;/root/repo/tools/Tests/CMakeLists.txt;13;songcore_add_test;/root/repo/tools/Tests/CMakeLists.txt;0;")
+add_test([=[Sha1Test]=] "/root/repo/_gate_build_tools/Tests/Sha1Test")
+set_tests_properties([=[Sha1Test]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tools/Tests/CMakeLists.txt;5;add_test;/root/repo/tools/Tests/CMakeLists.txt;14;songcore_add_test;/root/repo/tools/Tests/CMakeLists.txt;0;")
+add_test([=[SongCacheJournalTest]=] "/root/repo/_gate_build_tools/Tests/SongCacheJournalTest")
+set_tests_properties([=[SongCacheJournalTest]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tools/Tests/CMakeLists.txt;5;add_test;/root/repo/tools/Tests/CMakeLists.txt;15;songcore_add_test;/root/repo/tools/Tests/CMakeLists.txt;0;")
+add_test([=[SongCacheChecksumTest]=] "/root/repo/_gate_build_tools/Tests/SongCacheChecksumTest")
+set_tests_properties([=[SongCacheChecksumTest]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tools/Tests/CMakeLists.txt;5;add_test;/root/repo/tools/Tests/CMakeLists.txt;16;songcore_add_test;/root/repo/tools/Tests/CMakeLists.txt;0;")
+add_test([=[RelocationTest]=] "/root/repo/_gate_build_tools/Tests/RelocationTest")
+set_tests_properties([=[RelocationTest]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tools/Tests/CMakeLists.txt;5;add_test;/root/repo/tools/Tests/CMakeLists.txt;17;songcore_add_test;/root/repo/tools/Tests/CMakeLists.txt;0;")
+add_test([=[RelocationScaleTest]=] "/root/repo/_gate_build_tools/Tests/RelocationScaleTest")
+set_tests_properties([=[RelocationScaleTest]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tools/Tests/CMakeLists.txt;5;add_test;/root/repo/tools/Tests/CMakeLists.txt;18;songcore_add_test;/root/repo/tools/Tests/CMakeLists.txt;0;")
+add_test([=[LevelHashFileTest]=] "/root/repo/_gate_build_tools/Tests/LevelHashFileTest")
+set_tests_properties([=[LevelHashFileTest]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tools/Tests/CMakeLists.txt;5;add_test;/root/repo/tools/Tests/CMakeLists.txt;19;songcore_add_test;/root/repo/tools/Tests/CMakeLists.txt;0;")
+add_test([=[WarmRefreshTest]=] "/root/repo/_gate_build_tools/Tests/WarmRefreshTest")
+set_tests_properties([=[WarmRefreshTest]=] PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/tools/Tests/CMakeLists.txt;5;add_test;/root/repo/tools/Tests/CMakeLists.txt;20;songcore_add_test;/root/repo/tools/Tests/CMakeLists.txt;0;")
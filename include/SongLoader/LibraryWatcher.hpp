@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "Utils/Directory.hpp"
+
+namespace SongCore::SongLoader {
+    /// @brief watches the root level folders through inotify, and reports level folders that were added, changed or removed after they settled down.
+    /// Pack folders, folders without an info.dat that hold other folders, are watched like roots so levels in them are reported as well.
+    /// Only folders created while watching are watched for changes inside them, existing levels are left to refreshes.
+    class LibraryWatcher : public std::enable_shared_from_this<LibraryWatcher> {
+        public:
+            /// @brief callback invoked on the watcher thread for every settled level path, one at a time
+            using LevelChangedCallback = std::function<void(std::filesystem::path const& levelPath, bool isWip)>;
+            /// @brief callback invoked on the watcher thread if the changed levels can't be told apart, because the kernel dropped events or a pack folder went away with its levels, after which a refresh is needed to catch up
+            using RefreshNeededCallback = std::function<void()>;
+
+            LibraryWatcher(LevelChangedCallback levelChanged, RefreshNeededCallback refreshNeeded, std::chrono::milliseconds debounce = std::chrono::milliseconds(1500));
+            ~LibraryWatcher();
+
+            /// @brief starts watching the given roots on a new thread
+            /// @return false if inotify could not be set up
+            bool Start(std::span<const std::filesystem::path> roots, std::span<const std::filesystem::path> wipRoots);
+
+            /// @brief stops watching, the watcher thread exits on its own and no callbacks are invoked after this returns unless one is already running
+            void Stop();
+
+            /// @brief whether the watcher thread is running
+            bool get_IsRunning() const { return _running; }
+            __declspec(property(get=get_IsRunning)) bool IsRunning;
+        private:
+            enum class WatchKind {
+                /// @brief a root, folders in it are levels or packs
+                Root,
+                /// @brief a pack folder, folders in it are levels or packs, and a file appearing in it might make it a level
+                Pack,
+                /// @brief a level folder, or a folder that isn't known to be anything else yet
+                Level
+            };
+
+            struct WatchedDirectory {
+                std::filesystem::path path;
+                bool isWip;
+                WatchKind kind;
+            };
+
+            struct PendingLevel {
+                bool isWip;
+                std::chrono::steady_clock::time_point deadline;
+            };
+
+            /// @brief adds an inotify watch for a directory, or changes the kind of an existing one
+            bool AddWatch(std::filesystem::path const& path, bool isWip, WatchKind kind);
+
+            /// @brief watches a pack folder and the pack folders nested in it
+            /// @param scheduleLevels whether the folders in it are new and have to be reported, instead of being left to refreshes
+            void WatchPack(std::filesystem::path const& path, bool isWip, std::span<Utils::DirectoryEntry const> entries, bool scheduleLevels);
+
+            /// @brief watches the pack folders among the folders in a listing, and the ones nested in those
+            void WatchNestedPacks(std::filesystem::path const& path, bool isWip, std::span<Utils::DirectoryEntry const> entries);
+
+            /// @brief watches the pack folders that already exist in the roots
+            void WatchExistingPacks();
+
+            /// @brief reports a folder that settled down as a level, or starts watching it as a pack if it holds other folders instead
+            void ReportSettled(std::filesystem::path const& path, bool isWip);
+
+            /// @brief (re)schedules a level path to be reported after the debounce time
+            void Schedule(std::filesystem::path const& levelPath, bool isWip);
+
+            /// @brief reads all available inotify events
+            void ReadEvents();
+
+            /// @brief reports every pending level whose deadline passed
+            void ReportSettledLevels();
+
+            /// @brief the thread polling for events
+            void WatchThread();
+
+            LevelChangedCallback _levelChanged;
+            RefreshNeededCallback _refreshNeeded;
+            std::chrono::milliseconds _debounce;
+
+            int _inotifyFd = -1;
+            int _stopFd = -1;
+            std::atomic<bool> _running = false;
+            std::atomic<bool> _stopRequested = false;
+
+            std::unordered_map<int, WatchedDirectory> _watches;
+            std::map<std::filesystem::path, PendingLevel> _pendingLevels;
+            /// @brief paths of the pack folders, watches only know where a folder is now and not what used to be at a path
+            std::set<std::filesystem::path> _packs;
+    };
+}
@@ -23,10 +23,16 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, NavigationControllerUpdat
     DECLARE_INSTANCE_FIELD_PRIVATE(GlobalNamespace::LevelFilteringNavigationController*, _levelFilteringNavigationController);
     DECLARE_INSTANCE_FIELD_PRIVATE(GlobalNamespace::LevelCollectionNavigationController*, _levelCollectionNavigationController);
     DECLARE_INSTANCE_FIELD_PRIVATE(GlobalNamespace::LevelCollectionViewController*, _levelCollectionViewController);
+    DECLARE_INSTANCE_FIELD_PRIVATE(bool, _showedBatches);
 
     DECLARE_CTOR(ctor, GlobalNamespace::BeatmapLevelsModel* beatmapLevelsModel, RuntimeSongLoader* runtimeSongLoader, GlobalNamespace::LevelFilteringNavigationController* levelFilteringNavigationController, GlobalNamespace::LevelCollectionNavigationController* levelCollectionNavigationViewController, GlobalNamespace::LevelCollectionViewController* levelCollectionViewController);
 
     private:
         void SongsWillRefresh();
         void SongsLoaded(std::span<SongLoader::CustomBeatmapLevel* const> levels);
+        void SongsBatchLoaded(std::span<SongLoader::CustomBeatmapLevel* const> levels);
+
+        /// @brief keeps the selected level and scroll position across a reload of the custom songs
+        /// @param reload whether to start the reload here, instead of waiting on one that is already running
+        void ReselectAfterReload(bool reload);
 )
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace SongCore::Utils {
+    /// @brief decides how many workers should be active while loading, by hill climbing on songs per second and watching the I/O wait of the system.
+    /// Workers above the target park until they are needed again or the work is finished, their remaining work gets stolen by the active workers.
+    class AdaptiveConcurrency {
+        public:
+            /// @param maxWorkers amount of workers that exist, the target never goes above this
+            /// @param initialWorkers amount of workers that start out active
+            AdaptiveConcurrency(size_t maxWorkers, size_t initialWorkers);
+
+            /// @brief called by a worker before claiming work, parks it while it's above the target
+            /// @return false if the work is finished and the worker should exit
+            bool WaitUntilActive(size_t workerIndex);
+
+            /// @brief called by a worker after it finished a single item
+            void ReportCompleted() { _completed.fetch_add(1, std::memory_order_relaxed); }
+
+            /// @brief marks the work as finished, waking every parked worker so they can exit
+            void Finish();
+
+            /// @brief measures throughput since the last decision and adjusts the target if there were enough samples. Called periodically from a single thread
+            void Sample();
+
+            /// @brief amount of workers that should be active right now
+            size_t get_TargetWorkers() const { return _targetWorkers.load(std::memory_order_relaxed); }
+            __declspec(property(get=get_TargetWorkers)) size_t TargetWorkers;
+
+            /// @brief highest throughput seen in songs per second
+            float get_BestThroughput() const { return _bestThroughput; }
+            __declspec(property(get=get_BestThroughput)) float BestThroughput;
+
+            /// @brief amount of workers that were active when the best throughput was seen
+            size_t get_BestWorkers() const { return _bestWorkers; }
+            __declspec(property(get=get_BestWorkers)) size_t BestWorkers;
+        private:
+            /// @brief cpu time counters from /proc/stat, in clock ticks
+            struct CpuTimes {
+                uint64_t total;
+                uint64_t ioWait;
+            };
+
+            /// @brief reads the aggregate cpu line of /proc/stat, which isn't always readable on android
+            static std::optional<CpuTimes> ReadCpuTimes();
+
+            /// @brief changes the target and wakes parked workers if it grew
+            void SetTarget(size_t target);
+
+            size_t _maxWorkers;
+            std::atomic<size_t> _targetWorkers;
+            std::atomic<size_t> _completed = 0;
+            bool _finished = false;
+
+            std::mutex _parkMutex;
+            std::condition_variable _parkCondition;
+
+            // sampling state, only touched by the thread calling Sample
+            std::chrono::steady_clock::time_point _sampleStart;
+            size_t _sampleStartCompleted = 0;
+            std::optional<CpuTimes> _sampleStartCpuTimes;
+            float _lastThroughput = 0;
+            int _direction = 1;
+            float _bestThroughput = 0;
+            size_t _bestWorkers = 0;
+    };
+}
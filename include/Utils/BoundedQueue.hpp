@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace SongCore::Utils {
+    /// @brief statistics of a bounded queue, useful to see which side of the queue is the bottleneck
+    struct BoundedQueueStats {
+        size_t pushed;
+        size_t peakDepth;
+        /// @brief average depth seen by pushes
+        float averageDepth;
+        /// @brief total time producers spent waiting because the queue was full
+        std::chrono::nanoseconds producerWait;
+        /// @brief total time consumers spent waiting because the queue was empty
+        std::chrono::nanoseconds consumerWait;
+    };
+
+    /// @brief blocking multi producer multi consumer queue with a maximum size, used between the stages of a pipeline
+    template<typename T>
+    class BoundedQueue {
+        public:
+            explicit BoundedQueue(size_t capacity) : _capacity(capacity > 0 ? capacity : 1) {}
+
+            /// @brief pushes an item, waiting while the queue is full
+            /// @return false if the queue was closed, in which case the item is dropped
+            bool Push(T item) {
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (_items.size() >= _capacity && !_closed) {
+                    auto waitStart = std::chrono::steady_clock::now();
+                    _notFull.wait(lock, [this](){ return _items.size() < _capacity || _closed; });
+                    _producerWait += std::chrono::steady_clock::now() - waitStart;
+                }
+                if (_closed) return false;
+
+                _items.emplace_back(std::move(item));
+                _pushed++;
+                _depthSum += _items.size();
+                if (_items.size() > _peakDepth) _peakDepth = _items.size();
+
+                lock.unlock();
+                _notEmpty.notify_one();
+                return true;
+            }
+
+            /// @brief pops an item, waiting while the queue is empty
+            /// @return the item, or nullopt if the queue was closed and no items are left
+            std::optional<T> Pop() {
+                std::unique_lock<std::mutex> lock(_mutex);
+                if (_items.empty() && !_closed) {
+                    auto waitStart = std::chrono::steady_clock::now();
+                    _notEmpty.wait(lock, [this](){ return !_items.empty() || _closed; });
+                    _consumerWait += std::chrono::steady_clock::now() - waitStart;
+                }
+                if (_items.empty()) return std::nullopt;
+
+                auto item = std::move(_items.front());
+                _items.pop_front();
+
+                lock.unlock();
+                _notFull.notify_one();
+                return item;
+            }
+
+            /// @brief closes the queue, consumers still get the remaining items but pushes are rejected
+            void Close() {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _closed = true;
+                }
+                _notEmpty.notify_all();
+                _notFull.notify_all();
+            }
+
+            BoundedQueueStats GetStats() {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return {
+                    .pushed = _pushed,
+                    .peakDepth = _peakDepth,
+                    .averageDepth = _pushed > 0 ? static_cast<float>(_depthSum) / _pushed : 0.0f,
+                    .producerWait = _producerWait,
+                    .consumerWait = _consumerWait
+                };
+            }
+
+            size_t get_Capacity() const { return _capacity; }
+            __declspec(property(get=get_Capacity)) size_t Capacity;
+        private:
+            size_t _capacity;
+            bool _closed = false;
+            std::deque<T> _items;
+            std::mutex _mutex;
+            std::condition_variable _notEmpty;
+            std::condition_variable _notFull;
+
+            size_t _pushed = 0;
+            size_t _peakDepth = 0;
+            size_t _depthSum = 0;
+            std::chrono::nanoseconds _producerWait{0};
+            std::chrono::nanoseconds _consumerWait{0};
+    };
+}
@@ -1,15 +1,32 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <filesystem>
+#include "Utils/Directory.hpp"
 #include "beatsaber-hook/shared/config/rapidjson-utils.hpp"
 
 namespace SongCore::Utils {
+    /// @brief name of the cache a library can be prebuilt into on another machine, kept in the root folder the library is copied into. Its entries are keyed on the level path relative to that root
+    static constexpr std::string_view PREBUILT_CACHE_FILE_NAME = "SongCorePrebuiltCache.bin";
+
     struct CachedSongData {
-        int directoryHash;
+        /// @brief fingerprint of the level folder the data was calculated for, the data is stale once it changes
+        uint64_t directoryFingerprint = 0;
+        /// @brief directory hash of entries from cache files written before fingerprints, checked once and then replaced by the fingerprint
+        std::optional<int> legacyDirectoryHash = std::nullopt;
+        /// @brief sampled fingerprint of the file contents, only kept for levels in the content fingerprinted roots
+        std::optional<uint64_t> contentFingerprint = std::nullopt;
         std::optional<std::string> sha1 = std::nullopt;
         std::optional<float> songDuration = std::nullopt;
+        /// @brief serialized SongLoader::LevelMetadata, so the level can be constructed without parsing its info.dat. Not kept in the json cache
+        std::optional<std::string> levelMetadata = std::nullopt;
+
+        bool operator==(CachedSongData const& other) const = default;
 
         /// @brief serializes the data to a rapidjson value using the provided allocator
         rapidjson::Value Serialize(rapidjson::Document::AllocatorType& allocator) const;
@@ -23,19 +40,47 @@ namespace SongCore::Utils {
     /// @return optional song info entry, if the info isn't able to provided this returns nullopt (i.e. no song found at path)
     std::optional<CachedSongData> GetCachedInfo(std::filesystem::path const& levelPath);
 
+    /// @brief gets the cached info for the level, fingerprinting the folder from a listing that was already made
+    /// @return optional song info entry, if the info isn't able to provided this returns nullopt (i.e. no song found at path)
+    std::optional<CachedSongData> GetCachedInfo(std::filesystem::path const& levelPath, std::span<DirectoryEntry const> entries);
+
+    /// @brief makes levels in content fingerprinted roots sample their files again on their next lookup, instead of trusting the check from earlier this session
+    void RevalidateCachedContent();
+
     /// @brief sets the cached info for a path
     void SetCachedInfo(std::filesystem::path const& levelPath, CachedSongData const& newInfo);
 
+    /// @brief changes the cached info for a path in place, so updates of different fields from different threads don't overwrite each other
+    /// @return false if there is no cached info for the path
+    bool UpdateCachedInfo(std::filesystem::path const& levelPath, std::function<void(CachedSongData&)> const& update);
+
     /// @brief just removes cached info if it exists
     void RemoveCachedInfo(std::filesystem::path const& levelPath);
 
+    /// @brief removes the cached info of every level the function says doesn't exist anymore, so the refresh can decide that from its listing instead of every entry being checked on disk
+    void RemoveMissingCachedInfo(std::function<bool(std::string_view levelPath)> const& exists);
+
     /// @brief clears all entries from song info cache
     void ClearSongInfoCache();
 
     /// @brief saves the current state of the cache to disk storage
     void SaveSongInfoCache();
 
-    /// @brief loads the current state of the cache from disk storage
+    /// @brief loads the current state of the cache from disk storage, importing the old json cache if there is no binary cache yet
     /// @return boolean whether cache loaded succesfully
     bool LoadSongInfoCache();
+
+    /// @brief starts loading the cache on a background thread, everything else that uses the cache waits until it's loaded
+    void LoadSongInfoCacheAsync();
+
+    /// @brief maps the prebuilt caches of the roots that have one, levels that aren't cached yet take their hash and duration from those if their content matches
+    void LoadPrebuiltSongCaches(std::span<std::filesystem::path const> roots);
+
+    /// @brief writes the current state of the cache as json, for debugging
+    /// @return false if the file could not be written
+    bool ExportSongInfoCacheJson(std::filesystem::path const& filePath);
+
+    /// @brief merges the entries from a json cache into the cache, they're written in the binary format with the next save
+    /// @return false if the file doesn't exist, or something required wasn't found
+    bool ImportSongInfoCacheJson(std::filesystem::path const& filePath);
 }
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SongCore::Utils {
+    /// @brief a single entry of a directory listing, straight from the kernel without any stat calls
+    struct DirectoryEntry {
+        std::string name;
+        uint64_t inode;
+        /// @brief DT_* type of the entry, DT_UNKNOWN if the filesystem did not report one
+        unsigned char type;
+
+        bool IsDirectory() const;
+    };
+
+    /// @brief lists an already opened directory fd through raw getdents64 reads
+    /// @return false if the directory could not be read
+    bool ListOpenDirectory(int fd, std::vector<DirectoryEntry>& out);
+
+    /// @brief lists a directory through raw getdents64 reads
+    /// @param dirFd fd to resolve a relative path against, AT_FDCWD for absolute paths
+    /// @param out entries found in the directory, "." and ".." excluded
+    /// @return false if the directory could not be opened or read
+    bool ListDirectory(int dirFd, std::string_view path, std::vector<DirectoryEntry>& out);
+
+    /// @brief lists a directory through raw getdents64 reads
+    /// @return false if the directory could not be opened or read
+    bool ListDirectory(std::filesystem::path const& directoryPath, std::vector<DirectoryEntry>& out);
+
+    /// @brief finds the info.dat in a directory listing, in any casing
+    /// @return the name of the info file as it exists on disk, or nullopt if this listing is not a level
+    std::optional<std::string_view> FindInfoDat(std::span<DirectoryEntry const> entries);
+
+    /// @brief finds the info.dat of a level folder by listing it, in any casing
+    /// @return the path of the info file as it exists on disk, or nullopt if the folder could not be listed or is not a level
+    std::optional<std::filesystem::path> FindInfoDatPath(std::filesystem::path const& levelPath);
+
+    /// @brief hints the kernel to start reading the regular files of a directory listing into the page cache, so later reads don't wait on storage.
+    /// Large files only get their head and tail prefetched, as that is all that's read of audio files
+    /// @return total size of the regular files, which is about what hashing the level reads
+    uint64_t PrefetchDirectoryFiles(std::filesystem::path const& directoryPath, std::span<DirectoryEntry const> entries);
+
+    /// @brief whether a directory with this name should never be descended into while looking for levels
+    bool IsPrunedDirectory(std::string_view name);
+
+    /// @brief recursively collects all level folders below root, deciding whether a folder is a level from its single listing
+    /// @param root the root to start looking from, not considered a level folder itself
+    /// @param out output for the found level folders
+    /// @return false if the root itself could not be listed
+    bool CollectLevelFolders(std::filesystem::path const& root, std::vector<std::filesystem::path>& out);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace SongCore::Utils {
+    /// @brief recorded state of a directory the loader walked during a refresh
+    struct DirectoryState {
+        struct Subdirectory {
+            std::string name;
+            /// @brief symlinked directories are checked for being a level but never descended into
+            bool isSymlink;
+        };
+
+        uint64_t device;
+        uint64_t inode;
+        /// @brief modification time in nanoseconds, changes whenever an entry is added, removed or renamed in this directory
+        int64_t modifiedTime;
+        bool isLevel;
+        std::vector<Subdirectory> subdirectories;
+
+        bool operator ==(DirectoryState const&) const = default;
+    };
+
+    /// @brief walks the root like CollectLevelFolders, but only lists directories whose identity or modification time changed since the last walk.
+    /// Unchanged directories cost a single stat. Note that editing a file in place does not update the directory, so that is not picked up.
+    /// @param root the root to walk
+    /// @param relistAll ignore the recorded state and list every directory, used for full refreshes
+    /// @param levels output for every level folder below the root
+    /// @param changedLevels output for the level folders that were added or modified since the last walk
+    void CollectLevelFoldersIncremental(std::filesystem::path const& root, bool relistAll, std::vector<std::filesystem::path>& levels, std::vector<std::filesystem::path>& changedLevels);
+
+    /// @brief drops every directory that was not walked since the last prune, call after all roots were walked
+    void PruneDirectoryManifest();
+
+    /// @brief clears the directory manifest, causing the next walk to list everything again
+    void ClearDirectoryManifest();
+
+    /// @brief saves the directory manifest next to the song info cache
+    void SaveDirectoryManifest();
+
+    /// @brief loads the directory manifest from disk storage
+    /// @return boolean whether the manifest loaded succesfully
+    bool LoadDirectoryManifest();
+
+    /// @brief starts loading the directory manifest on a background thread, walks and saves wait until it's loaded
+    void LoadDirectoryManifestAsync();
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <span>
 #include <vector>
 #include <string>
 #include <string_view>
@@ -13,4 +16,12 @@ namespace SongCore::Utils {
     std::u16string ReadText(std::filesystem::path path);
 
     const char* ReadBytes(std::string_view path, size_t& size_out);
+
+    /// @brief writes everything to the fd, retrying short and interrupted writes
+    /// @return false if not everything could be written
+    bool WriteAll(int fd, uint8_t const* data, size_t size);
+
+    /// @brief replaces the file through a temporary file that is synced and renamed over it, so a crash leaves either the old or the new contents
+    /// @return false if the file could not be replaced, errno tells why
+    bool WriteFileAtomically(std::filesystem::path const& filePath, std::span<uint8_t const> data);
 }
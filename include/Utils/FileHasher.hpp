@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include "Utils/Sha1.hpp"
+
+namespace SongCore::Utils {
+    /// @brief hashes files into a single running SHA1 state by reading them in large blocks
+    class FileHasher {
+        public:
+            /// @brief adds the entire contents of the file to the hash
+            /// @return false if the file could not be opened or read, the hash should be discarded then
+            bool AddFile(std::filesystem::path const& filePath);
+
+            /// @brief finishes the hash, after which the hasher is reset
+            /// @return the digest as uppercase hex, the same as cryptopp's HexEncoder gives
+            std::string FinalHex();
+
+            /// @brief amount of bytes added since construction
+            uint64_t get_BytesHashed() const { return _bytesHashed; }
+            __declspec(property(get=get_BytesHashed)) uint64_t BytesHashed;
+        private:
+            Sha1 _sha1;
+            uint64_t _bytesHashed = 0;
+    };
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Utils/Directory.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace SongCore::Utils {
+    /// @brief name of the file a downloader can put in a level folder with the level's hash, so it isn't hashed on first sight.
+    /// It's a json object with "hash", the sha1 as hex, and "files", the name and size in bytes of every file directly in the folder besides this one, like { "info.dat": 1234 }.
+    /// The hash is only trusted while the folder has exactly those files with those sizes, so it doesn't matter whether it's written before or after the rest of the level. It's left out of the fingerprints, so writing it doesn't change them
+    static constexpr std::string_view LEVEL_HASH_FILE_NAME = "SongCoreHash.json";
+
+    /// @brief fingerprint of the files directly in a level folder, mixing their names, sizes, nanosecond modification times and inodes into a 64 bit hash
+    /// @param entries listing of the folder, so a folder that was just listed doesn't get listed again
+    /// @return the fingerprint, or nullopt if the folder could not be read or has no files
+    std::optional<uint64_t> GetDirectoryFingerprint(std::filesystem::path const& directoryPath, std::span<DirectoryEntry const> entries);
+
+    /// @brief fingerprint of the contents of the files directly in a level folder, from their names, sizes and a few sampled blocks of each.
+    /// Catches files being replaced by ones of the same size where modification times are unreliable, at a fraction of the cost of hashing them fully
+    /// @param entries listing of the folder
+    /// @return the fingerprint, or nullopt if the folder could not be read or has no files
+    std::optional<uint64_t> GetContentFingerprint(std::filesystem::path const& directoryPath, std::span<DirectoryEntry const> entries);
+
+    /// @brief the xor of file sizes and modification seconds that cache entries were keyed on before fingerprints, only used to migrate those entries
+    std::optional<int> GetLegacyDirectoryHash(std::filesystem::path const& directoryPath);
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "beatsaber-hook/shared/config/rapidjson-utils.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace SongCore::Utils {
+    /// @brief the files the hash of a v2 or v3 level is made of, in the order they're hashed: the info.dat and every beatmap that exists
+    /// @param info the parsed info.dat
+    std::vector<std::filesystem::path> GetHashedLevelFilesV2(std::filesystem::path const& levelPath, std::filesystem::path const& infoPath, rapidjson::Value const& info);
+
+    /// @brief the files the hash of a v4 level is made of, in the order they're hashed: the info.dat, the audio data and per difficulty its beatmap and lightshow.
+    /// A difficulty whose beatmap is missing is skipped along with its lightshow
+    /// @param info the parsed info.dat
+    /// @return the files, or nullopt if the audio data is missing and the level can't be hashed
+    std::optional<std::vector<std::filesystem::path>> GetHashedLevelFilesV4(std::filesystem::path const& levelPath, std::filesystem::path const& infoPath, rapidjson::Value const& info);
+}
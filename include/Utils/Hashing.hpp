@@ -1,9 +1,16 @@
 #pragma once
 
 #include "CustomJSONData.hpp"
+#include "Utils/Directory.hpp"
+#include "Utils/LevelHashFile.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
 
 namespace SongCore::Utils {
     std::optional<std::string> GetCustomLevelHash(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData);
     std::optional<std::string> GetCustomLevelHash(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData);
-    std::optional<int> GetDirectoryHash(std::filesystem::path const& directoryPath);
 }
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+
+namespace SongCore::Utils {
+    /// @brief priority of hashing work, all interactive work runs before any background work
+    enum class HashPriority {
+        /// @brief a level something is waiting on right now, like one that is being looked up or was just added
+        Interactive = 0,
+        /// @brief the bulk of a refresh, which runs cheapest first so levels become visible as early as possible
+        Background = 1
+    };
+
+    /// @brief hashes levels apart from the rest of loading, so a level that is expensive to hash doesn't hold up the ones behind it.
+    /// Work is ordered on priority, then on how much it has to read, and runs on at most a fixed amount of thread pool threads
+    class HashingService {
+        public:
+            explicit HashingService(size_t maxWorkers);
+
+            /// @brief queues hashing work for a level
+            /// @param cost amount of bytes the work reads, cheaper work of the same priority runs first
+            void Enqueue(std::filesystem::path const& levelPath, HashPriority priority, uint64_t cost, std::function<void()> work);
+
+            /// @brief queues hashing work for a level
+            /// @return future that is ready once the work ran, which also gets exceptions thrown by it
+            template<typename F>
+            std::future<std::invoke_result_t<std::decay_t<F>>> Submit(std::filesystem::path const& levelPath, HashPriority priority, uint64_t cost, F&& func) {
+                using Ret = std::invoke_result_t<std::decay_t<F>>;
+                auto task = std::make_shared<std::packaged_task<Ret()>>(std::forward<F>(func));
+                auto future = task->get_future();
+                Enqueue(levelPath, priority, cost, [task](){ (*task)(); });
+                return future;
+            }
+
+            /// @brief moves work that is still queued for a level ahead of all background work
+            /// @return whether work for the level was queued
+            bool Prioritize(std::filesystem::path const& levelPath);
+
+            /// @brief amount of work waiting for a worker
+            size_t get_QueueLength();
+            __declspec(property(get=get_QueueLength)) size_t QueueLength;
+
+            /// @brief amount of threads the service never uses more of
+            size_t get_MaxWorkers() const { return _maxWorkers; }
+            __declspec(property(get=get_MaxWorkers)) size_t MaxWorkers;
+        private:
+            /// @brief priority, cost and then order of submission
+            using QueueKey = std::tuple<HashPriority, uint64_t, uint64_t>;
+
+            struct QueuedWork {
+                std::string levelPath;
+                std::function<void()> work;
+            };
+
+            /// @brief runs queued work until the queue is empty
+            void WorkerThread();
+
+            size_t _maxWorkers;
+            size_t _workers = 0;
+            uint64_t _nextSequence = 0;
+
+            std::mutex _mutex;
+            std::map<QueueKey, QueuedWork> _queue;
+            std::unordered_map<std::string, QueueKey> _queuedLevels;
+    };
+
+    /// @brief the service SongCore hashes levels on during refreshes
+    HashingService& GetHashingService();
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Utils/Directory.hpp"
+#include "Utils/Fingerprint.hpp"
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace SongCore::Utils {
+    /// @return the hash in uppercase hex, or nullopt if it isn't a sha1 as hex
+    std::optional<std::string> NormalizeLevelHash(std::string_view hash);
+
+    /// @brief whether a directory listing has a level hash file
+    bool HasLevelHashFile(std::span<DirectoryEntry const> entries);
+
+    /// @brief reads the hash from the level hash file of a folder
+    /// @return the hash in uppercase hex, or nullopt if there is no file or the files it lists aren't exactly the files in the folder now
+    std::optional<std::string> ReadLevelHashFile(std::filesystem::path const& levelPath);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace SongCore::Utils {
+    /// @brief SHA1 that runs on the cpu's SHA1 instructions when it has them (ARMv8 crypto extensions, x86 SHA-NI), and a portable implementation otherwise.
+    /// The kernel is picked once, and only used after it passes the known answer tests
+    class Sha1 {
+        public:
+            static constexpr size_t DIGEST_SIZE = 20;
+            static constexpr size_t BLOCK_SIZE = 64;
+
+            using Digest = std::array<uint8_t, DIGEST_SIZE>;
+            /// @brief compresses whole blocks into the state
+            using CompressFunction = void(*)(uint32_t* state, uint8_t const* blocks, size_t blockCount);
+
+            /// @brief a way to compress blocks, and what it runs on
+            struct Kernel {
+                std::string_view name;
+                CompressFunction compress;
+            };
+
+            /// @brief hashes with the kernel picked for this cpu
+            Sha1();
+
+            /// @brief hashes with the given kernel, for comparing them
+            explicit Sha1(CompressFunction compress);
+
+            void Update(uint8_t const* data, size_t size);
+
+            /// @brief finishes the hash, after which the state is reset
+            Digest Final();
+
+            /// @brief name of the kernel all hashing runs on
+            static std::string_view get_KernelName();
+            __declspec(property(get=get_KernelName)) std::string_view KernelName;
+
+            /// @brief every kernel this cpu can run, portable first, whether or not it passes the known answer tests
+            static std::vector<Kernel> GetAvailableKernels();
+        private:
+            void Reset();
+
+            CompressFunction _compress;
+            std::array<uint32_t, 5> _state;
+            std::array<uint8_t, BLOCK_SIZE> _buffer;
+            size_t _bufferSize;
+            uint64_t _totalSize;
+    };
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Utils/Cache.hpp"
+
+namespace SongCore::Utils {
+    /// @brief a single entry as it's laid out in the cache file
+    struct SongCacheFileRecord;
+    struct FingerprintIndexEntry;
+
+    /// @brief read only view of a binary song info cache file, which is mapped into memory so entries are looked up in place instead of being parsed on load.
+    /// The file is a header with a checksum of the rest, fixed size records sorted on level path, an index of the records on their fingerprints,
+    /// and a string table the records point into for their paths and level metadata
+    class MappedSongCache {
+        public:
+            MappedSongCache() = default;
+            ~MappedSongCache();
+
+            MappedSongCache(MappedSongCache const&) = delete;
+            MappedSongCache& operator=(MappedSongCache const&) = delete;
+
+            /// @brief maps the file, closing whatever was mapped before
+            /// @return false if the file doesn't exist, isn't a cache file of this version, or doesn't match its checksum
+            bool Open(std::filesystem::path const& filePath);
+
+            void Close();
+
+            /// @brief looks up the entry for a level path through a binary search over the records
+            std::optional<CachedSongData> Find(std::string_view levelPath) const;
+
+            /// @brief calls the function for every entry, in path order
+            void ForEach(std::function<void(std::string_view levelPath, CachedSongData const& data)> const& func) const;
+
+            /// @brief calls the function for every entry with this directory or content fingerprint, through a binary search over the fingerprint index
+            void ForEachWithFingerprint(uint64_t fingerprint, std::function<void(std::string_view levelPath, CachedSongData const& data)> const& func) const;
+
+            /// @brief calls the function for the path of every entry, in path order, without reading the rest of the entries
+            void ForEachPath(std::function<void(std::string_view levelPath)> const& func) const;
+
+            size_t get_Count() const { return _recordCount; }
+            __declspec(property(get=get_Count)) size_t Count;
+        private:
+            std::string_view PathOf(SongCacheFileRecord const& record) const;
+            std::string_view MetadataOf(SongCacheFileRecord const& record) const;
+
+            /// @brief start of the file, either mapped or read into _fallbackBuffer if the filesystem can't map it
+            uint8_t const* _data = nullptr;
+            size_t _size = 0;
+            bool _mapped = false;
+            std::vector<uint8_t> _fallbackBuffer;
+
+            SongCacheFileRecord const* _records = nullptr;
+            size_t _recordCount = 0;
+            FingerprintIndexEntry const* _fingerprintIndex = nullptr;
+            size_t _fingerprintIndexCount = 0;
+            char const* _strings = nullptr;
+            size_t _stringsSize = 0;
+    };
+
+    /// @brief writes entries to a binary song info cache file, through a temporary file that replaces the old one once it's complete so a mapped old file stays intact
+    /// @param entries the entries, sorted on path
+    /// @return false if the file could not be written
+    bool WriteSongCacheFile(std::filesystem::path const& filePath, std::span<std::pair<std::string, CachedSongData> const> entries);
+
+    /// @brief appends changes to the journal kept next to the cache file, in a single write
+    /// @param changes the changed entries, nullopt for removed ones
+    /// @return false if the changes could not be written
+    bool AppendSongCacheJournal(std::filesystem::path const& journalPath, std::span<std::pair<std::string, std::optional<CachedSongData>> const> changes);
+
+    /// @brief calls the function for every change in the journal, in the order they were appended. Everything from the first record that was cut off or doesn't match its checksum on is dropped from the journal
+    /// @return amount of changes replayed, nullopt if there is no journal
+    std::optional<size_t> ReplaySongCacheJournal(std::filesystem::path const& journalPath, std::function<void(std::string_view levelPath, std::optional<CachedSongData> const& data)> const& func);
+
+    /// @brief drops the changes that were compacted into the cache file from the journal, keeping the ones appended since. The journal is replaced like the cache file, so a crash leaves either one
+    /// @param compactedSize size the journal had when the entries were collected for the cache file
+    /// @return false if the journal could not be trimmed
+    bool TrimSongCacheJournal(std::filesystem::path const& journalPath, uint64_t compactedSize);
+}
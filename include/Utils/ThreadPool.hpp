@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+namespace SongCore::Utils {
+    /// @brief priority of work submitted to the thread pool, higher priorities are always picked up first
+    enum class TaskPriority {
+        /// @brief something is actively waiting on this, like the game awaiting a task
+        High = 0,
+        /// @brief refreshing and deleting songs
+        Normal = 1,
+        /// @brief work nothing waits on
+        Low = 2
+    };
+
+    /// @brief pool of il2cpp attached threads that is kept around, so submitting work doesn't attach and detach a new thread every time.
+    /// Work may block on other submitted work, so instead of queueing while every thread is busy the pool grows up to its maximum, and threads above the base count exit after idling for a while.
+    class ThreadPool {
+        public:
+            /// @param baseWorkers amount of threads that are kept alive while idle
+            /// @param maxWorkers amount of threads the pool never grows beyond, after which work queues up
+            /// @param idleTimeout how long threads above the base count idle before exiting
+            ThreadPool(size_t baseWorkers, size_t maxWorkers, std::chrono::milliseconds idleTimeout);
+
+            /// @brief queues work for the pool, exceptions thrown by it are logged
+            void Enqueue(TaskPriority priority, std::function<void()> work);
+
+            /// @brief queues work for the pool
+            /// @return future for the result of the work, which also gets exceptions thrown by it
+            template<typename F>
+            std::future<std::invoke_result_t<std::decay_t<F>>> Submit(TaskPriority priority, F&& func) {
+                using Ret = std::invoke_result_t<std::decay_t<F>>;
+                // std::function needs copyable functors, packaged tasks aren't
+                auto task = std::make_shared<std::packaged_task<Ret()>>(std::forward<F>(func));
+                auto future = task->get_future();
+                Enqueue(priority, [task](){ (*task)(); });
+                return future;
+            }
+
+            /// @brief amount of work waiting for a thread
+            size_t get_QueueLength();
+            __declspec(property(get=get_QueueLength)) size_t QueueLength;
+
+            /// @brief amount of threads currently running work
+            size_t get_ActiveWorkers();
+            __declspec(property(get=get_ActiveWorkers)) size_t ActiveWorkers;
+
+            /// @brief amount of threads currently alive
+            size_t get_WorkerCount();
+            __declspec(property(get=get_WorkerCount)) size_t WorkerCount;
+
+            /// @brief highest amount of threads that were alive at once
+            size_t get_PeakWorkerCount();
+            __declspec(property(get=get_PeakWorkerCount)) size_t PeakWorkerCount;
+
+            /// @brief amount of work that finished since the pool was created
+            size_t get_CompletedCount();
+            __declspec(property(get=get_CompletedCount)) size_t CompletedCount;
+
+            /// @brief amount of threads the pool never grows beyond
+            size_t get_MaxWorkers() const { return _maxWorkers; }
+            __declspec(property(get=get_MaxWorkers)) size_t MaxWorkers;
+        private:
+            /// @brief starts a new thread, has to be called with the mutex held
+            void SpawnWorker();
+
+            /// @brief loop of a single pool thread
+            void WorkerThread();
+
+            size_t _baseWorkers;
+            size_t _maxWorkers;
+            std::chrono::milliseconds _idleTimeout;
+
+            std::mutex _mutex;
+            std::condition_variable _workAvailable;
+            std::array<std::deque<std::function<void()>>, 3> _queues;
+
+            size_t _queued = 0;
+            size_t _idle = 0;
+            size_t _active = 0;
+            size_t _workers = 0;
+            size_t _peakWorkers = 0;
+            size_t _completed = 0;
+    };
+
+    /// @brief the pool SongCore runs its refreshes, deletes and tasks on.
+    /// Everything on it shares the same cap of max(maxLoaderThreads, 8) threads, including work that blocks while it waits on other work:
+    /// RefreshRequestedWhileRefreshing waiting for the running refresh, the refresh waiting on its read, parse and construct stages, the stages waiting on each other's queues,
+    /// and game tasks polling for the levels to be published. Work like that should never wait on something that itself needs a free pool thread to get started.
+    ThreadPool& GetThreadPool();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace SongCore::Utils {
+    /// @brief lock free distribution of a fixed amount of work items (indices into a contiguous array) over a set of workers.
+    /// Every worker owns a range of indices it claims from the front, and once it runs dry it steals the back half of another worker's range.
+    class WorkStealingRanges {
+        public:
+            /// @brief splits itemCount items into workerCount equally sized ranges
+            WorkStealingRanges(size_t itemCount, size_t workerCount);
+
+            /// @brief claims the next item for the worker, stealing from other workers if its own range is empty
+            /// @param workerIndex index of the calling worker, each index may only be used by one thread at a time
+            /// @return index of the claimed item, or nullopt if every range is empty
+            std::optional<size_t> Next(size_t workerIndex);
+
+            /// @brief amount of workers the items were split over
+            size_t get_WorkerCount() const { return _workerCount; }
+            __declspec(property(get=get_WorkerCount)) size_t WorkerCount;
+
+        private:
+            /// @brief begin in the upper 32 bits, end in the lower 32 bits, so both can be swapped at once. Own cache line to avoid false sharing
+            struct alignas(64) Range {
+                std::atomic<uint64_t> bounds;
+            };
+
+            static constexpr uint64_t Pack(uint32_t begin, uint32_t end) { return (static_cast<uint64_t>(begin) << 32) | end; }
+            static constexpr uint32_t Begin(uint64_t bounds) { return static_cast<uint32_t>(bounds >> 32); }
+            static constexpr uint32_t End(uint64_t bounds) { return static_cast<uint32_t>(bounds); }
+
+            /// @brief tries to steal half of another worker's range into the range of workerIndex
+            std::optional<size_t> Steal(size_t workerIndex);
+
+            size_t _workerCount;
+            std::unique_ptr<Range[]> _ranges;
+    };
+}
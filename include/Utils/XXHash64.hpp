@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace SongCore::Utils {
+    /// @brief streaming XXH64, a fast non cryptographic 64 bit hash for fingerprints where SHA1 would be overkill
+    class XXHash64 {
+        public:
+            explicit XXHash64(uint64_t seed = 0);
+
+            void Update(void const* data, size_t size);
+
+            /// @brief hash of everything added so far, more data may still be added afterwards
+            uint64_t Digest() const;
+
+            /// @brief hashes a single buffer
+            static uint64_t Hash(void const* data, size_t size, uint64_t seed = 0);
+        private:
+            static constexpr size_t STRIPE_SIZE = 32;
+
+            uint64_t _seed;
+            std::array<uint64_t, 4> _accumulators;
+            std::array<uint8_t, STRIPE_SIZE> _buffer;
+            size_t _bufferSize = 0;
+            uint64_t _totalSize = 0;
+    };
+}
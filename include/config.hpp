@@ -3,6 +3,11 @@
 #include <filesystem>
 #include <vector>
 
+/// @brief folder SongCore keeps its caches in, host builds point it somewhere writable
+#ifndef SONGCORE_DATA_PATH
+#define SONGCORE_DATA_PATH "/sdcard/ModData/com.beatgames.beatsaber/Mods/SongCore"
+#endif
+
 struct Config {
     /// @brief whether to apply note colors from diffs
     bool customSongNoteColors = true;
@@ -17,6 +22,18 @@ struct Config {
     /// @brief whether to not show the songloader warning again
     bool dontShowSongloaderWarningAgain = false;
 
+    /// @brief whether to watch the root folders for levels being added or removed, and load them without a refresh. Not exposed
+    bool enableLibraryWatcher = false;
+
+    /// @brief whether levels are published to the custom packs in batches while a refresh is still running, instead of all at once at the end. Not exposed
+    bool progressiveLoading = false;
+
+    /// @brief maximum amount of threads SongCore runs its refreshes, deletes and tasks on at once. Not exposed
+    int maxLoaderThreads = 64;
+
+    /// @brief whether hashes from level hash files are only used until the level's files were hashed in the background, instead of being trusted. Not exposed
+    bool verifyLevelHashFiles = false;
+
     /// @brief multiple paths to folders to load songs from, in case user has multiple folders. Not exposed
     std::vector<std::filesystem::path> RootCustomLevelPaths {
         "/sdcard/ModData/com.beatgames.beatsaber/Mods/SongCore/CustomLevels",
@@ -28,6 +45,9 @@ struct Config {
         "/sdcard/ModData/com.beatgames.beatsaber/Mods/SongCore/CustomWIPLevels",
         "/sdcard/ModData/com.beatgames.beatsaber/Mods/SongLoader/CustomWIPLevels"
     };
+
+    /// @brief root folders whose levels also get a sampled content fingerprint in the song cache, for storage where modification times can't be trusted (like FAT sdcards). Not exposed
+    std::vector<std::filesystem::path> ContentFingerprintRootPaths {};
 };
 
 extern Config config;
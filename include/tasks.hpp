@@ -1,9 +1,8 @@
 #pragma once
 
 #include "beatsaber-hook/shared/utils/il2cpp-utils.hpp"
+#include "Utils/ThreadPool.hpp"
 #include "System/Threading/Tasks/Task_1.hpp"
-#include <chrono>
-#include <thread>
 
 namespace SongCore {
     template<typename T>
@@ -16,18 +15,21 @@ namespace SongCore {
         task->TrySetResult(std::invoke(std::forward<T>(func)));
     }
 
+    /// @brief runs func on the calling pool thread instead of handing it to another one and waiting on it, so every task only ever takes a single thread of the pool.
+    /// func is never abandoned, it has to check the token itself and return early once cancellation is requested
     template<typename Ret, typename T>
     requires(std::is_invocable_r_v<Ret, T, CancellationToken>)
     static void task_cancel_func(Task<Ret>* task, T&& func, CancellationToken&& cancelToken) {
-        using namespace std::chrono_literals;
-        // start func as an std::future
-        auto fut = il2cpp_utils::il2cpp_async(std::forward<T>(func), std::forward<CancellationToken>(cancelToken));
-        // await the future
-        while (fut.wait_for(0ns) != std::future_status::ready && !cancelToken.IsCancellationRequested) std::this_thread::yield();
+        if (cancelToken.IsCancellationRequested) {
+            task->TrySetCanceled(cancelToken);
+            return;
+        }
+
+        auto result = std::invoke(std::forward<T>(func), cancelToken);
 
         // if cancellation wasn't requested, set result, else set canceled
         if (!cancelToken.IsCancellationRequested) {
-            task->TrySetResult(fut.get());
+            task->TrySetResult(result);
         } else {
             task->TrySetCanceled(cancelToken);
         }
@@ -37,7 +39,7 @@ namespace SongCore {
     requires(!std::is_same_v<Ret, void> && std::is_invocable_r_v<Ret, T>)
     static Task<Ret>* StartTask(T&& func) {
         auto t = Task<Ret>::New_ctor();
-        il2cpp_utils::il2cpp_aware_thread(&task_func<Ret, T>, t, std::forward<T>(func)).detach();
+        Utils::GetThreadPool().Enqueue(Utils::TaskPriority::High, [t, func = std::forward<T>(func)]() mutable { task_func<Ret, std::decay_t<T>>(t, std::move(func)); });
         return t;
     }
 
@@ -45,7 +47,7 @@ namespace SongCore {
     requires(!std::is_same_v<Ret, void> && std::is_invocable_r_v<Ret, T, CancellationToken>)
     static Task<Ret>* StartTask(T&& func, CancellationToken&& cancelToken) {
         auto t = Task<Ret>::New_ctor();
-        il2cpp_utils::il2cpp_aware_thread(&task_cancel_func<Ret, T>, t, std::forward<T>(func), std::forward<CancellationToken>(cancelToken)).detach();
+        Utils::GetThreadPool().Enqueue(Utils::TaskPriority::High, [t, func = std::forward<T>(func), cancelToken = std::forward<CancellationToken>(cancelToken)]() mutable { task_cancel_func<Ret, std::decay_t<T>>(t, std::move(func), std::move(cancelToken)); });
         return t;
     }
 }
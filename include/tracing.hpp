@@ -0,0 +1,51 @@
+#pragma once
+
+// trace points to look at a refresh in perfetto or chrome://tracing.
+// they compile to nothing unless SONGCORE_TRACING is defined (the SONGCORE_TRACING cmake option), so their arguments aren't even evaluated in normal builds.
+// names have to be string literals, details may be any string and are copied.
+
+#ifdef SONGCORE_TRACING
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace SongCore::Tracing {
+    /// @brief records a complete event spanning the lifetime of the scope
+    class Scope {
+        public:
+            explicit Scope(std::string_view name, std::string_view detail = {});
+            ~Scope();
+
+            Scope(Scope const&) = delete;
+            Scope& operator=(Scope const&) = delete;
+        private:
+            std::string_view _name;
+            std::string _detail;
+            std::chrono::steady_clock::time_point _start;
+    };
+
+    /// @brief records an event without duration
+    void Instant(std::string_view name, std::string_view detail = {});
+
+    /// @brief writes every event recorded since the last flush to a new trace file in the SongCore mod data folder
+    /// @param label start of the file name
+    void Flush(std::string_view label);
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#define TRACE_SCOPE(name) ::SongCore::Tracing::Scope TRACE_CONCAT(_traceScope, __COUNTER__)(name)
+#define TRACE_SCOPE_DETAIL(name, detail) ::SongCore::Tracing::Scope TRACE_CONCAT(_traceScope, __COUNTER__)(name, detail)
+#define TRACE_INSTANT(name, ...) ::SongCore::Tracing::Instant(name __VA_OPT__(, __VA_ARGS__))
+#define TRACE_FLUSH(label) ::SongCore::Tracing::Flush(label)
+
+#else
+
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_SCOPE_DETAIL(name, detail) ((void)0)
+#define TRACE_INSTANT(name, ...) ((void)0)
+#define TRACE_FLUSH(label) ((void)0)
+
+#endif
@@ -8,6 +8,7 @@
 #include "GlobalNamespace/BeatmapCharacteristicSO.hpp"
 
 #include "SongLoader/CustomLevelPack.hpp"
+#include "SongLoader/LoadTimings.hpp"
 #include "SongLoader/CustomBeatmapLevel.hpp"
 
 #include "CustomJSONData.hpp"
@@ -125,6 +126,9 @@ namespace SongCore::API {
         /// @brief event ran when songs are done refreshing
         SONGCORE_EXPORT UnorderedEventCallback<std::span<::SongCore::SongLoader::CustomBeatmapLevel* const>>& GetSongsLoadedEvent();
 
+        /// @brief event ran while songs are refreshing, each time a batch of newly loaded levels got published to the custom packs. Only ran when progressive loading is enabled, `GetSongsLoadedEvent` still runs once refreshing is done. Batches after the first are appended to the end of the packs, they're only sorted once refreshing is done
+        SONGCORE_EXPORT UnorderedEventCallback<std::span<::SongCore::SongLoader::CustomBeatmapLevel* const>>& GetSongsBatchLoadedEvent();
+
         /// @brief event ran when song refreshing will start
         SONGCORE_EXPORT UnorderedEventCallback<>& GetSongsWillRefreshEvent();
 
@@ -162,6 +166,13 @@ namespace SongCore::API {
         /// @param wipPath whether this path is a wipPath
         SONGCORE_EXPORT void RemoveLevelPath(std::filesystem::path const& path, bool wipPath = false);
 
+        /// @brief registers the hash of a level, for downloaders that know it already so the level isn't hashed when it's loaded.
+        /// The hash is kept for the folder as it is now, changing its files makes it get hashed again
+        /// @param levelPath the folder of the level, once all its files are in place
+        /// @param hash the sha1 of the level as hex
+        /// @return false if the hash isn't a sha1, or the folder could not be read
+        SONGCORE_EXPORT bool RegisterLevelHash(std::filesystem::path const& levelPath, std::string_view hash);
+
         /// @brief whether the songloader is currently refreshing songs
         SONGCORE_EXPORT bool AreSongsRefreshing();
 
@@ -175,6 +186,10 @@ namespace SongCore::API {
         /// @return if songloader not setup returns an empty span
         SONGCORE_EXPORT std::span<::SongCore::SongLoader::CustomBeatmapLevel* const> GetAllLevels();
 
+        /// @brief load timings of the last refresh, with a histogram per load stage and the slowest levels
+        /// @return copy of the report, empty if the songloader didn't exist or hasn't refreshed yet
+        SONGCORE_EXPORT SongLoader::RefreshTimingReport GetLastRefreshTimings();
+
         /// @brief Getter for the custom level pack songcore creates
         /// @return created pack, or nullptr if the songloader didn't exist
         SONGCORE_EXPORT SongLoader::CustomLevelPack* GetCustomLevelPack();
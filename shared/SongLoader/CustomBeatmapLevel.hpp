@@ -5,6 +5,10 @@
 #include "GlobalNamespace/IBeatmapLevelData.hpp"
 #include "../CustomJSONData.hpp"
 
+namespace SongCore::SongLoader {
+    class RuntimeSongLoader;
+}
+
 // type which is basically a beatmaplevel but one made by songcore, helps with identification
 DECLARE_CLASS_CODEGEN(SongCore::SongLoader, CustomBeatmapLevel, GlobalNamespace::BeatmapLevel,
     DECLARE_CTOR(ctor,
@@ -40,10 +44,12 @@ DECLARE_CLASS_CODEGEN(SongCore::SongLoader, CustomBeatmapLevel, GlobalNamespace:
         __declspec(property(get=get_CustomSaveDataInfo)) std::optional<std::reference_wrapper<CustomJSONData::CustomSaveDataInfo>> CustomSaveDataInfo;
 
         /// @brief level info.dat save data. Set for V2-V3 levels.
+        /// Levels a refresh constructed from the song info cache get it parsed in the background right after the refresh publishes them, until then it's nullopt
         std::optional<CustomJSONData::CustomLevelInfoSaveDataV2*> get_standardLevelInfoSaveDataV2() { return _customLevelSaveDataV2 ? std::optional(_customLevelSaveDataV2) : std::nullopt; }
         __declspec(property(get=get_standardLevelInfoSaveDataV2)) std::optional<CustomJSONData::CustomLevelInfoSaveDataV2*> standardLevelInfoSaveDataV2;
 
         /// @brief level info.dat save data. Set for V4 levels.
+        /// Levels a refresh constructed from the song info cache get it parsed in the background right after the refresh publishes them, until then it's nullopt
         std::optional<CustomJSONData::CustomBeatmapLevelSaveDataV4*> get_beatmapLevelSaveDataV4() { return _customBeatmapLevelSaveDataV4 ? std::optional(_customBeatmapLevelSaveDataV4) : std::nullopt; }
         __declspec(property(get=get_beatmapLevelSaveDataV4)) std::optional<CustomJSONData::CustomBeatmapLevelSaveDataV4*> beatmapLevelSaveDataV4;
 
@@ -75,6 +81,7 @@ DECLARE_CLASS_CODEGEN(SongCore::SongLoader, CustomBeatmapLevel, GlobalNamespace:
             ::System::Collections::Generic::IReadOnlyDictionary_2<::System::ValueTuple_2<::UnityW<::GlobalNamespace::BeatmapCharacteristicSO>, ::GlobalNamespace::BeatmapDifficulty>, ::GlobalNamespace::BeatmapBasicData*>* beatmapBasicData
         );
     private:
+        friend class RuntimeSongLoader;
         CustomJSONData::CustomLevelInfoSaveDataV2* _customLevelSaveDataV2;
         CustomJSONData::CustomBeatmapLevelSaveDataV4* _customBeatmapLevelSaveDataV4;
         GlobalNamespace::IBeatmapLevelData* _beatmapLevelData;
@@ -17,6 +17,8 @@ DECLARE_CLASS_CODEGEN(SongCore::SongLoader, CustomBeatmapLevelsRepository, Globa
         void ClearLevelPacks();
         /// @brief takes the level packs list and fixes all the backing dictionaries. This is a somewhat expensive operation as it involves a lot of inserts into dicts
         void FixBackingDictionaries();
+        /// @brief adds levels that were just added to one of the level packs to the backing dictionaries, without going over every other level like FixBackingDictionaries
+        void AddToBackingDictionaries(GlobalNamespace::BeatmapLevelPack* pack, std::span<CustomBeatmapLevel* const> levels);
 
         std::span<GlobalNamespace::BeatmapLevelPack* const> GetBeatmapLevelPacks() const { return _levelPacks; }
         __declspec(property(get=GetBeatmapLevelPacks)) std::span<GlobalNamespace::BeatmapLevelPack* const> BeatmapLevelPacks;
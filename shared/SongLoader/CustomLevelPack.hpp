@@ -26,4 +26,7 @@ DECLARE_CLASS_CODEGEN(SongCore::SongLoader, CustomLevelPack, GlobalNamespace::Be
 
         /// @brief sets the levels in the collection based on the inputted span
         void SetLevels(std::span<CustomBeatmapLevel* const> levels);
+
+        /// @brief adds the inputted levels after the levels already in the collection, without sorting
+        void AddLevels(std::span<CustomBeatmapLevel* const> levels);
 )
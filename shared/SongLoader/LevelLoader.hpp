@@ -3,6 +3,8 @@
 #include "custom-types/shared/macros.hpp"
 #include "../CustomJSONData.hpp"
 #include "CustomBeatmapLevel.hpp"
+#include "LevelMetadata.hpp"
+#include "LoadTimings.hpp"
 
 #include "GlobalNamespace/EnvironmentInfoSO.hpp"
 #include "GlobalNamespace/ColorScheme.hpp"
@@ -20,6 +22,7 @@
 #include "System/ValueTuple_2.hpp"
 #include "System/Collections/Generic/Dictionary_2.hpp"
 #include <filesystem>
+#include <optional>
 
 DECLARE_CLASS_CODEGEN(SongCore::SongLoader, LevelLoader, System::Object,
     DECLARE_CTOR(ctor, GlobalNamespace::SpriteAsyncLoader* spriteAsyncLoader, GlobalNamespace::BeatmapCharacteristicCollection* beatmapCharacteristicCollection, GlobalNamespace::IAdditionalContentModel* additionalContentModel, GlobalNamespace::EnvironmentsListModel* environmentsListModel);
@@ -37,9 +40,15 @@ DECLARE_CLASS_CODEGEN(SongCore::SongLoader, LevelLoader, System::Object,
         /// @brief gets the v3 savedata from the path
         SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* GetSaveDataFromV3(std::filesystem::path const& path);
 
+        /// @brief gets the v3 savedata from already read info.dat contents
+        SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* GetSaveDataFromV3(std::filesystem::path const& path, std::u16string_view infoText);
+
         /// @brief gets the v4 savedata from the path
         SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* GetSaveDataFromV4(std::filesystem::path const& path);
 
+        /// @brief gets the v4 savedata from already read info.dat contents
+        SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* GetSaveDataFromV4(std::filesystem::path const& path, std::u16string_view infoText);
+
         /// @brief Loads song at given path
         /// @param path the path to the song
         /// @param isWip is this a wip song
@@ -56,7 +65,67 @@ DECLARE_CLASS_CODEGEN(SongCore::SongLoader, LevelLoader, System::Object,
         /// @return loaded beatmap level, or nullptr if failed
         CustomBeatmapLevel* LoadCustomBeatmapLevel(std::filesystem::path const& levelPath, bool wip, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData, std::string& hashOut);
 
+        /// @brief verifies the map and calculates its hash and duration, which is the part of loading a level that touches the filesystem
+        /// @param outHash output for the hash of this level
+        /// @param songDurationOut output for the duration of the song
+        /// @param timing optional output the time spent verifying, hashing and getting the duration is added to
+        /// @return whether the level can be constructed
+        bool PrepareCustomBeatmapLevel(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData, std::string& hashOut, float& songDurationOut, LevelLoadTiming* timing = nullptr);
+
+        /// @brief verifies the map and calculates its hash and duration, which is the part of loading a level that touches the filesystem
+        /// @param outHash output for the hash of this level
+        /// @param songDurationOut output for the duration of the song
+        /// @param timing optional output the time spent verifying, hashing and getting the duration is added to
+        /// @return whether the level can be constructed
+        bool PrepareCustomBeatmapLevel(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData, std::string& hashOut, float& songDurationOut, LevelLoadTiming* timing = nullptr);
+
+        /// @brief the part of PrepareCustomBeatmapLevel besides hashing, verifies the map and calculates its duration
+        /// @param songDurationOut output for the duration of the song
+        /// @param timing optional output the time spent verifying and getting the duration is added to
+        /// @return whether the level can be hashed and constructed
+        bool VerifyCustomBeatmapLevel(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData, float& songDurationOut, LevelLoadTiming* timing = nullptr);
+
+        /// @brief the part of PrepareCustomBeatmapLevel besides hashing, verifies the map and calculates its duration
+        /// @param songDurationOut output for the duration of the song
+        /// @param timing optional output the time spent verifying and getting the duration is added to
+        /// @return whether the level can be hashed and constructed
+        bool VerifyCustomBeatmapLevel(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData, float& songDurationOut, LevelLoadTiming* timing = nullptr);
+
+        /// @brief calculates the hash of a level that passed VerifyCustomBeatmapLevel
+        /// @param timing optional output the time spent hashing is added to
+        /// @return the hash, or nullopt if the level could not be hashed
+        std::optional<std::string> HashCustomBeatmapLevel(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData, LevelLoadTiming* timing = nullptr);
+
+        /// @brief calculates the hash of a level that passed VerifyCustomBeatmapLevel
+        /// @param timing optional output the time spent hashing is added to
+        /// @return the hash, or nullopt if the level could not be hashed
+        std::optional<std::string> HashCustomBeatmapLevel(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData, LevelLoadTiming* timing = nullptr);
+
+        /// @brief constructs the level objects for a level that was prepared with PrepareCustomBeatmapLevel
+        /// @return constructed beatmap level
+        CustomBeatmapLevel* ConstructCustomBeatmapLevel(std::filesystem::path const& levelPath, bool wip, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData, std::string_view hash, float songDuration);
+
+        /// @brief constructs the level objects for a level that was prepared with PrepareCustomBeatmapLevel
+        /// @return constructed beatmap level
+        CustomBeatmapLevel* ConstructCustomBeatmapLevel(std::filesystem::path const& levelPath, bool wip, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData, std::string_view hash, float songDuration);
+
+        /// @brief constructs the level objects from cached metadata, without reading the info.dat. The level gets its savedata once the refresh parses it in the background
+        /// @return constructed beatmap level
+        CustomBeatmapLevel* ConstructCustomBeatmapLevel(std::filesystem::path const& levelPath, bool wip, LevelMetadata const& metadata, std::string_view hash, float songDuration);
+
+        /// @brief gets everything constructing the level needs from the savedata
+        static LevelMetadata GetLevelMetadata(SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData);
+
+        /// @brief gets everything constructing the level needs from the savedata
+        static LevelMetadata GetLevelMetadata(SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData);
+
     private:
+        /// @brief constructs the level objects from the metadata, with whatever savedata the level was constructed from
+        CustomBeatmapLevel* CreateCustomBeatmapLevel(std::filesystem::path const& levelPath, bool wip, LevelMetadata const& metadata, std::string_view hash, float songDuration, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveDataV2, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveDataV4);
+
+        /// @brief stores the metadata of a constructed level in the song info cache
+        static void CacheLevelMetadata(std::filesystem::path const& levelPath, LevelMetadata const& metadata);
+
         /// @brief does basic verification on a map to catch any problems before they actually occur
         bool BasicVerifyMap(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData);
         /// @brief does basic verification on a map to catch any problems before they actually occur
@@ -69,20 +138,17 @@ DECLARE_CLASS_CODEGEN(SongCore::SongLoader, LevelLoader, System::Object,
         /// @brief preview media data from filesystem
         GlobalNamespace::FileSystemPreviewMediaData* GetPreviewMediaData(std::filesystem::path const& levelPath, StringW coverImageFilename, StringW songFilename);
 
-        /// @brief beatmap level data from filesystem & basic beatmap data from savedata
-        std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, BeatmapBasicDataDict*> GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, std::span<GlobalNamespace::EnvironmentName const> environmentNames, std::span<GlobalNamespace::ColorScheme* const> colorSchemes, CustomJSONData::CustomLevelInfoSaveDataV2* saveData);
-
-        /// @brief beatmap level data from filesystem & basic beatmap data from savedata
-        std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, BeatmapBasicDataDict*> GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData);
+        /// @brief beatmap level data from filesystem & basic beatmap data from the level metadata
+        std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, BeatmapBasicDataDict*> GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, std::span<GlobalNamespace::EnvironmentName const> environmentNames, std::span<GlobalNamespace::ColorScheme* const> colorSchemes, LevelMetadata const& metadata);
 
         /// @brief gets the environment info for the environmentName and whether it's all directions or not
         GlobalNamespace::EnvironmentInfoSO* GetEnvironmentInfo(StringW environmentName, bool allDirections);
 
         /// @brief gets the environmentinfos for the environmentNames
-        ArrayW<GlobalNamespace::EnvironmentInfoSO*> GetEnvironmentInfos(std::span<StringW const> environmentsNames);
+        ArrayW<GlobalNamespace::EnvironmentInfoSO*> GetEnvironmentInfos(std::span<std::string const> environmentsNames);
 
-        /// @brief creates the color schemes for the savedata
-        ArrayW<GlobalNamespace::ColorScheme*> GetColorSchemes(std::span<GlobalNamespace::BeatmapLevelColorSchemeSaveData* const> colorSchemeDatas);
+        /// @brief creates the color schemes for the level metadata
+        ArrayW<GlobalNamespace::ColorScheme*> GetColorSchemes(std::span<LevelMetadata::ColorScheme const> colorSchemeDatas);
 
         /// @brief gets the length for a level
         static float GetLengthForLevel(std::filesystem::path const& levelPath, CustomJSONData::CustomLevelInfoSaveDataV2* saveData);
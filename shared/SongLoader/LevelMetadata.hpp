@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SongCore::Utils {
+    struct CachedSongData;
+}
+
+namespace SongCore::SongLoader {
+    /// @brief everything constructing a level needs from its info.dat, kept in the song info cache so unchanged levels are constructed without parsing it.
+    /// Custom data isn't part of it, the refresh parses the savedata for that in the background once the levels are published
+    struct LevelMetadata {
+        /// @brief the arguments a ColorScheme is constructed with
+        struct ColorScheme {
+            std::string colorSchemeId;
+            std::string localizationKey;
+            bool useNonLocalizedName = false;
+            std::string nonLocalizedName;
+            /// @brief saber a, saber b, environment 0, environment 1, environment 0 boost, environment 1 boost and obstacles, as rgba
+            std::array<std::array<float, 4>, 7> colors {};
+
+            bool operator==(ColorScheme const& other) const = default;
+        };
+
+        struct Difficulty {
+            std::string characteristic;
+            std::string difficulty;
+            std::string beatmapFilename;
+            /// @brief empty for levels before v4
+            std::string lightshowFilename;
+            float noteJumpMovementSpeed = 0;
+            float noteJumpStartBeatOffset = 0;
+            int environmentNameIdx = 0;
+            int beatmapColorSchemeIdx = 0;
+            std::vector<std::string> mappers;
+            std::vector<std::string> lighters;
+
+            bool operator==(Difficulty const& other) const = default;
+        };
+
+        bool isV4 = false;
+        std::string songName;
+        std::string songSubName;
+        std::string songAuthorName;
+        /// @brief only set for levels before v4, which have one author for the whole level
+        std::string levelAuthorName;
+        float beatsPerMinute = 0;
+        float integratedLufs = -6.0f;
+        float songTimeOffset = 0;
+        float previewStartTime = 0;
+        float previewDuration = 0;
+        std::string coverImageFilename;
+        std::string songFilename;
+        /// @brief only set for v4 levels
+        std::string audioDataFilename;
+        /// @brief only set for levels before v4
+        std::string environmentName;
+        /// @brief only set for levels before v4
+        std::string allDirectionsEnvironmentName;
+        std::vector<std::string> environmentNames;
+        std::vector<ColorScheme> colorSchemes;
+        std::vector<Difficulty> difficulties;
+
+        bool operator==(LevelMetadata const& other) const = default;
+
+        /// @brief serializes the metadata to a compact binary form for the song info cache
+        std::string Serialize() const;
+
+        /// @brief deserializes metadata that was serialized with Serialize
+        /// @return the metadata, or nullopt if it was written by another version or is damaged
+        static std::optional<LevelMetadata> Deserialize(std::string_view data);
+
+        /// @brief the metadata a level is constructed from without reading its info.dat
+        /// @param cachedInfo the cached info of the level folder as it is now
+        /// @return the metadata, or nullopt if the hash, duration or metadata isn't cached
+        static std::optional<LevelMetadata> FromCachedInfo(Utils::CachedSongData const& cachedInfo);
+    };
+}
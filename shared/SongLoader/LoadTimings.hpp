@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace SongCore::SongLoader {
+    /// @brief the steps a level goes through while it is loaded during a refresh
+    enum class LoadStage {
+        /// @brief listing the level folder and reading the info.dat
+        Discovery = 0,
+        /// @brief getting the savedata version from the info.dat
+        VersionSniff = 1,
+        /// @brief deserializing and verifying the savedata
+        InfoParse = 2,
+        /// @brief hashing the level, or getting the hash from the cache
+        Hash = 3,
+        /// @brief getting the song duration, or getting it from the cache
+        DurationProbe = 4,
+        /// @brief creating the level objects
+        Construction = 5
+    };
+
+    static constexpr size_t LOAD_STAGE_COUNT = 6;
+
+    /// @brief gets a readable name for a load stage
+    constexpr std::string_view LoadStageName(LoadStage stage) {
+        switch (stage) {
+            case LoadStage::Discovery: return "discovery";
+            case LoadStage::VersionSniff: return "version sniff";
+            case LoadStage::InfoParse: return "info parse";
+            case LoadStage::Hash: return "hash";
+            case LoadStage::DurationProbe: return "duration probe";
+            case LoadStage::Construction: return "construction";
+        }
+        return "unknown";
+    }
+
+    /// @brief how long each stage took for a single level
+    struct LevelLoadTiming {
+        std::filesystem::path levelPath;
+        std::array<std::chrono::nanoseconds, LOAD_STAGE_COUNT> stages {};
+
+        void Add(LoadStage stage, std::chrono::nanoseconds time) { stages[static_cast<size_t>(stage)] += time; }
+
+        std::chrono::nanoseconds get_Total() const {
+            std::chrono::nanoseconds total{0};
+            for (auto time : stages) total += time;
+            return total;
+        }
+        __declspec(property(get=get_Total)) std::chrono::nanoseconds Total;
+
+        /// @brief the stage that took the longest for this level
+        LoadStage get_DominantStage() const {
+            size_t dominant = 0;
+            for (size_t i = 1; i < LOAD_STAGE_COUNT; i++) {
+                if (stages[i] > stages[dominant]) dominant = i;
+            }
+            return static_cast<LoadStage>(dominant);
+        }
+        __declspec(property(get=get_DominantStage)) LoadStage DominantStage;
+    };
+
+    /// @brief histogram of load times with exponentially growing buckets, bucket 0 holds everything below the first bound and every next bucket doubles it
+    class LoadTimeHistogram {
+        public:
+            static constexpr size_t BUCKET_COUNT = 16;
+            static constexpr std::chrono::microseconds FIRST_BUCKET_BOUND{64};
+
+            /// @brief exclusive upper bound of a bucket, the last bucket has no upper bound and returns nanoseconds::max
+            static constexpr std::chrono::nanoseconds BucketUpperBound(size_t bucket) {
+                if (bucket >= BUCKET_COUNT - 1) return std::chrono::nanoseconds::max();
+                return FIRST_BUCKET_BOUND * (int64_t(1) << bucket);
+            }
+
+            void Add(std::chrono::nanoseconds time) {
+                size_t bucket = 0;
+                while (bucket < BUCKET_COUNT - 1 && time >= BucketUpperBound(bucket)) bucket++;
+                _buckets[bucket]++;
+                _count++;
+                _total += time;
+                if (time > _max) _max = time;
+            }
+
+            /// @brief approximates a percentile as the upper bound of the bucket it falls in, clamped to the highest time seen
+            /// @param percentile between 0 and 1
+            std::chrono::nanoseconds Percentile(float percentile) const {
+                if (_count == 0) return std::chrono::nanoseconds{0};
+                size_t target = static_cast<size_t>(percentile * _count);
+                size_t seen = 0;
+                for (size_t i = 0; i < BUCKET_COUNT; i++) {
+                    seen += _buckets[i];
+                    if (seen > target) return std::min(BucketUpperBound(i), _max);
+                }
+                return _max;
+            }
+
+            std::span<size_t const> get_Buckets() const { return _buckets; }
+            __declspec(property(get=get_Buckets)) std::span<size_t const> Buckets;
+
+            size_t get_Count() const { return _count; }
+            __declspec(property(get=get_Count)) size_t Count;
+
+            std::chrono::nanoseconds get_TotalTime() const { return _total; }
+            __declspec(property(get=get_TotalTime)) std::chrono::nanoseconds TotalTime;
+
+            std::chrono::nanoseconds get_MaxTime() const { return _max; }
+            __declspec(property(get=get_MaxTime)) std::chrono::nanoseconds MaxTime;
+        private:
+            std::array<size_t, BUCKET_COUNT> _buckets {};
+            size_t _count = 0;
+            std::chrono::nanoseconds _total{0};
+            std::chrono::nanoseconds _max{0};
+    };
+
+    /// @brief timings of the levels loaded during a single refresh, levels kept from an earlier refresh aren't included
+    struct RefreshTimingReport {
+        /// @brief histogram per load stage, indexed by LoadStage
+        std::array<LoadTimeHistogram, LOAD_STAGE_COUNT> stages;
+        /// @brief histogram of the total time per level
+        LoadTimeHistogram total;
+        /// @brief the slowest levels of the refresh, slowest first
+        std::vector<LevelLoadTiming> slowestLevels;
+    };
+}
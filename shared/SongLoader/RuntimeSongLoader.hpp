@@ -4,13 +4,17 @@
 #include <string_view>
 #include <filesystem>
 #include <vector>
+#include <memory>
 #include <mutex>
 #include <set>
+#include <span>
 
 #include "custom-types/shared/macros.hpp"
 
 #include "LevelLoader.hpp"
+#include "LevelMetadata.hpp"
 #include "CustomLevelPack.hpp"
+#include "LoadTimings.hpp"
 #include "CustomBeatmapLevel.hpp"
 #include "CustomBeatmapLevelsRepository.hpp"
 
@@ -28,6 +32,7 @@
 #include "System/IDisposable.hpp"
 
 namespace SongCore::SongLoader {
+    class LibraryWatcher;
     using SongDict = ::System::Collections::Concurrent::ConcurrentDictionary_2<StringW, CustomBeatmapLevel*>;
 }
 
@@ -113,6 +118,10 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         bool get_AreSongsLoaded() const { return _areSongsLoaded; }
         __declspec(property(get=get_AreSongsLoaded)) bool AreSongsLoaded;
 
+        /// @brief whether the custom packs hold levels of the current refresh, which with progressive loading happens before songs are done loading
+        bool get_AreLevelsPublished() const { return _areLevelsPublished; }
+        __declspec(property(get=get_AreLevelsPublished)) bool AreLevelsPublished;
+
         /// @brief gets the current song loading progress
         float get_Progress() const { return (float)_loadedSongs / (float)_totalSongs; }
         __declspec(property(get=get_Progress)) float Progress;
@@ -135,6 +144,9 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         /// @brief event invoked after song loading has completed, ran on main thread. the provided span is a readonly reference to all levels
         UnorderedEventCallback<std::span<CustomBeatmapLevel* const>> SongsLoaded;
 
+        /// @brief event invoked while songs are refreshing with progressive loading, after a batch of levels got published to the custom packs. ran on main thread, the provided span holds only the levels new in this batch
+        UnorderedEventCallback<std::span<CustomBeatmapLevel* const>> SongsBatchLoaded;
+
         /// @brief event invoked before the beatmaplevelsmodel is updated with the new collections
         UnorderedEventCallback<SongCore::SongLoader::CustomBeatmapLevelsRepository*> CustomLevelPacksWillRefresh;
 
@@ -147,6 +159,10 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         /// @brief event invoked after a song got deleted, so you may redo certain operations
         UnorderedEventCallback<> SongDeleted;
 
+        /// @brief gets the load timings of the last finished or cancelled refresh
+        /// @return copy of the report, empty if no refresh happened yet
+        RefreshTimingReport GetLastRefreshTimings();
+
         /// @brief gets a level by the levelpath
         /// @return nullptr if level not found
         CustomBeatmapLevel* GetLevelByPath(std::filesystem::path const& levelPath);
@@ -197,20 +213,98 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         /// @return constructed color schemes
         ArrayW<GlobalNamespace::ColorScheme*> GetColorSchemes(std::span<GlobalNamespace::BeatmapLevelColorSchemeSaveData* const> colorSchemeDatas);
 
-        /// @brief collects levels from the root into the given set, and keeps the wip status
-        static void CollectLevels(std::filesystem::path const& root, bool isWip, std::set<LevelPathAndWip>& out);
+        /// @brief collects levels from the root into the given vector, and keeps the wip status
+        /// @param relistAll whether to list every folder again instead of only the ones that changed since the last refresh
+        /// @param changedOut output for levels that were added or modified since the last refresh
+        static void CollectLevels(std::filesystem::path const& root, bool isWip, bool relistAll, std::vector<LevelPathAndWip>& out, std::set<std::filesystem::path>& changedOut);
+
+        /// @brief collects levels from the roots into the given vector, and keeps the wip status
+        /// @param relistAll whether to list every folder again instead of only the ones that changed since the last refresh
+        /// @param changedOut output for levels that were added or modified since the last refresh
+        static void CollectLevels(std::span<const std::filesystem::path> roots, bool isWip, bool relistAll, std::vector<LevelPathAndWip>& out, std::set<std::filesystem::path>& changedOut);
 
-        /// @brief collects levels from the roots into the given set, and keeps the wip status
-        static void CollectLevels(std::span<const std::filesystem::path> roots, bool isWip, std::set<LevelPathAndWip>& out);
+        /// @brief removes levels from the dictionaries whose folders were removed or modified since the last refresh
+        /// @param levels every collected level, sorted by path
+        void RemoveStaleLevels(std::span<LevelPathAndWip const> levels, std::set<std::filesystem::path> const& changedLevels);
 
         /// @brief method used when a double (or triple, quadruple...) refresh is requested
         void RefreshRequestedWhileRefreshing();
 
+        /// @brief submits a refresh that starts once whatever is currently loading finished, has to be called with _currentRefreshMutex held
+        /// @return the future of the refresh, which is now the current one
+        std::shared_future<void> StartRefresh(bool fullRefresh);
+
         /// @brief method kicked of by RefreshSongs on an il2cpp async
         void RefreshSongs_internal(bool fullRefresh);
 
-        /// @brief worker thread for loading songs from a set
-        void RefreshSongWorkerThread(std::mutex* levelsItrMutex, std::set<LevelPathAndWip>::const_iterator* levelsItr, std::set<LevelPathAndWip>::const_iterator* levelsEnd);
+        /// @brief a level whose info.dat was read by the read stage of the refresh pipeline
+        struct ReadLevel {
+            std::filesystem::path levelPath;
+            bool isWip;
+            std::u16string infoText;
+            bool isV4;
+            /// @brief amount of bytes hashing the level reads, 0 if its hash was cached
+            uint64_t hashCost;
+            LevelLoadTiming timing;
+        };
+
+        /// @brief a level that was parsed, hashed and timed by the refresh pipeline, ready to be constructed
+        struct PreparedLevel {
+            std::filesystem::path levelPath;
+            bool isWip;
+            bool isV4;
+            /// @brief kept in safe pointers as nothing else references the savedata while it waits in the queue
+            SafePtr<SongCore::CustomJSONData::CustomLevelInfoSaveDataV2> saveDataV3;
+            SafePtr<SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4> saveDataV4;
+            std::string hash;
+            float songDuration;
+            /// @brief set instead of the savedata for levels whose info.dat wasn't parsed because everything was in the song info cache
+            std::optional<LevelMetadata> metadata;
+            LevelLoadTiming timing;
+        };
+
+        /// @brief queues, work distribution and statistics of a single refresh pipeline
+        struct RefreshPipeline;
+
+        /// @brief logs the exception currently being handled for a level that failed to load, and removes it from the total
+        void LogLevelLoadFailure(std::filesystem::path const& levelPath);
+
+        /// @brief read stage of the refresh pipeline: claims levels through the work ranges while the concurrency controller keeps it active, reads info.dat and prefetches the other files.
+        /// Levels with everything in the song info cache go straight to the construct stage
+        void RefreshReadWorkerThread(RefreshPipeline* pipeline, size_t workerIndex);
+
+        /// @brief parse stage of the refresh pipeline: deserializes the savedata and times the level, levels that have to be read to be hashed are handed to the hashing service
+        void RefreshParseWorkerThread(RefreshPipeline* pipeline);
+
+        /// @brief hashes a parsed level and passes it on to the construct stage, run by the parse stage for cached hashes and by the hashing service otherwise
+        void RefreshHashLevel(RefreshPipeline* pipeline, PreparedLevel prepared);
+
+        /// @brief construct stage of the refresh pipeline: creates the level objects and adds them to the dictionaries
+        void RefreshConstructWorkerThread(RefreshPipeline* pipeline);
+
+        /// @brief rebuilds the custom packs and the level collections from the dictionaries, only swapping them in happens on the main thread
+        void UpdateLevelCollections();
+
+        /// @brief publishes the levels the construct stage added since the last batch to the custom packs and repository, and invokes SongsBatchLoaded
+        /// @return whether there were levels to publish
+        bool PublishLevelBatch(RefreshPipeline* pipeline);
+
+        /// @brief appends a batch of levels to a pack and the level collections, without rebuilding everything else in them. levels that are already in them are removed from the batch
+        void AppendLevelBatch(CustomLevelPack* pack, std::vector<CustomBeatmapLevel*>& levels);
+
+        /// @brief parses the savedata of the published levels that were constructed from the song info cache on a low priority pool task, and hands it to them on the main thread.
+        /// stops once another refresh starts, which picks up whatever is left after it publishes
+        void LoadCachedLevelSaveData();
+
+        /// @brief loads a single level by sniffing its version and loading the matching savedata
+        /// @return loaded level, or nullptr if loading failed
+        CustomBeatmapLevel* LoadLevel(std::filesystem::path const& levelPath, bool isWip);
+
+        /// @brief queues loading, reloading or removing the single level at the path behind the current refresh, called by the library watcher
+        void RefreshLevel(std::filesystem::path const& levelPath, bool isWip);
+
+        /// @brief loads, reloads or removes the single level at the path and updates the collections and packs, without a full refresh. Ran in turn with refreshes
+        void RefreshLevel_internal(std::filesystem::path const& levelPath, bool isWip);
 
         /// @brief internal method for deleting a song, ran through il2cpp async
         void DeleteSong_internal(std::filesystem::path levelPath);
@@ -226,6 +320,12 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         std::shared_future<void> _doubleRefreshRequestedFuture;
         /// @brief whether the double refresh should be a full refresh
         bool _doubleRefreshIsFull;
+        /// @brief set when a full refresh is requested while refreshing, makes the current refresh stop at the next level
+        std::atomic<bool> _cancelRefreshRequested;
+        /// @brief whether a full refresh cleared the dictionaries and got cancelled before finishing, so the next full refresh can continue from its results instead of starting over
+        std::atomic<bool> _resumeCancelledFullRefresh;
+        /// @brief levels a soft refresh was going to load when it got cancelled, the ones it got to are kept by the full refresh that superseded it instead of being loaded again
+        std::set<std::filesystem::path> _cancelledRefreshLevels;
 
         /// @brief how many songs have already been loaded
         std::atomic<size_t> _loadedSongs;
@@ -233,6 +333,8 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         std::atomic<size_t> _totalSongs;
         /// @brief are songs done loading
         std::atomic<bool> _areSongsLoaded;
+        /// @brief have levels of the current refresh been published to the packs
+        std::atomic<bool> _areLevelsPublished;
         /// @brief all loaded levels
         std::vector<CustomBeatmapLevel*> _allLoadedLevels;
         /// @brief collection holding the level ids to levels
@@ -240,12 +342,22 @@ DECLARE_CLASS_CODEGEN_INTERFACES(SongCore::SongLoader, RuntimeSongLoader, System
         /// @brief collection holding the hashes to levels
         std::unordered_map<std::string, CustomBeatmapLevel*> _hashesToLevels;
 
+        /// @brief mutex for accessing the last refresh timings
+        std::mutex _lastRefreshTimingsMutex;
+        /// @brief load timings of the last refresh
+        RefreshTimingReport _lastRefreshTimings;
+
+        /// @brief watches the roots for levels being added or removed, only set if enabled in the config
+        std::shared_ptr<LibraryWatcher> _libraryWatcher;
+
         static RuntimeSongLoader* _instance;
 
         /// @brief invoker method for SongsWillRefresh event
         void InvokeSongsWillRefresh() const;
         /// @brief invoker method for SongsLoaded event
         void InvokeSongsLoaded(std::span<CustomBeatmapLevel* const> levels) const;
+        /// @brief invoker method for SongsBatchLoaded event
+        void InvokeSongsBatchLoaded(std::span<CustomBeatmapLevel* const> levels) const;
         /// @brief invoker method for CustomLevelPacksWillRefresh event
         void InvokeCustomLevelPacksWillRefresh(SongCore::SongLoader::CustomBeatmapLevelsRepository* beatmapLevelsRepository) const;
         /// @brief invoker method for CustomLevelPacksRefreshed event
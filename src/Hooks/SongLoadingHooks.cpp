@@ -1,6 +1,7 @@
 #include "SongLoader/RuntimeSongLoader.hpp"
 #include "hooking.hpp"
 #include "logging.hpp"
+#include "config.hpp"
 #include "tasks.hpp"
 
 #include "CustomJSONData.hpp"
@@ -34,7 +35,9 @@
 #include "BGLib/DotnetExtension/Collections/LRUCache_2.hpp"
 
 #include "utf8.h"
+#include <chrono>
 #include <string>
+#include <thread>
 #include "Utils/SaveDataVersion.hpp"
 
 // custom songs tab is disabled by default on quest, reenable
@@ -99,7 +102,8 @@ MAKE_AUTO_HOOK_ORIG_MATCH(BeatmapLevelsModel_ReloadCustomLevelPackCollectionAsyn
     return SongCore::StartTask<GlobalNamespace::BeatmapLevelsRepository*>([](SongCore::CancellationToken cancelToken) -> GlobalNamespace::BeatmapLevelsRepository* {
         using namespace std::chrono_literals;
         auto loader = SongCore::SongLoader::RuntimeSongLoader::get_instance();
-        while (loader->AreSongsRefreshing && !cancelToken.IsCancellationRequested) std::this_thread::sleep_for(100ms);
+        // with progressive loading the repository is usable as soon as the first batch got published, without it only once the refresh is done
+        while (loader->AreSongsRefreshing && !(config.progressiveLoading && loader->AreLevelsPublished) && !cancelToken.IsCancellationRequested) std::this_thread::sleep_for(100ms);
         return loader->CustomBeatmapLevelsRepository;
     }, std::forward<SongCore::CancellationToken>(cancellationToken));
 }
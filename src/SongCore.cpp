@@ -1,5 +1,7 @@
 #include "SongCore.hpp"
 #include "SongLoader/RuntimeSongLoader.hpp"
+#include "Utils/Cache.hpp"
+#include "Utils/Hashing.hpp"
 #include "logging.hpp"
 #include "config.hpp"
 
@@ -195,6 +197,7 @@ namespace SongCore::API {
 
     namespace Loading {
         static UnorderedEventCallback<std::span<SongCore::SongLoader::CustomBeatmapLevel* const>> _songsLoadedEvent;
+        static UnorderedEventCallback<std::span<SongCore::SongLoader::CustomBeatmapLevel* const>> _songsBatchLoadedEvent;
         static UnorderedEventCallback<> _songsWillRefreshEvent;
         static UnorderedEventCallback<SongCore::SongLoader::CustomBeatmapLevelsRepository*> _customLevelPacksWillRefreshEvent;
         static UnorderedEventCallback<SongCore::SongLoader::CustomBeatmapLevelsRepository*> _customLevelPacksRefreshedEvent;
@@ -229,6 +232,10 @@ namespace SongCore::API {
             return _songsLoadedEvent;
         }
 
+        UnorderedEventCallback<std::span<SongCore::SongLoader::CustomBeatmapLevel* const>>& GetSongsBatchLoadedEvent() {
+            return _songsBatchLoadedEvent;
+        }
+
         UnorderedEventCallback<>& GetSongsWillRefreshEvent() {
             return _songsWillRefreshEvent;
         }
@@ -289,6 +296,28 @@ namespace SongCore::API {
             }
         }
 
+        bool RegisterLevelHash(std::filesystem::path const& levelPath, std::string_view hash) {
+            auto normalized = Utils::NormalizeLevelHash(hash);
+            if (!normalized.has_value()) {
+                WARNING("Can't register {} as the hash of {}, it isn't a sha1", hash, levelPath.string());
+                return false;
+            }
+
+            // keyed the way the refresh finds the folder, a trailing separator would make it a different entry
+            auto normalPath = levelPath.lexically_normal();
+            if (!normalPath.has_filename()) normalPath = normalPath.parent_path();
+
+            // looking the level up makes an entry for the folder as it is now, the hash is stored with that.
+            // if that entry is gone again by the time the hash is stored, like the cache being cleared in between, it's stored as a new entry
+            auto cachedInfo = Utils::GetCachedInfo(normalPath);
+            if (!cachedInfo.has_value()) return false;
+            if (!Utils::UpdateCachedInfo(normalPath, [&normalized](Utils::CachedSongData& data){ data.sha1 = *normalized; })) {
+                cachedInfo->sha1 = *normalized;
+                Utils::SetCachedInfo(normalPath, *cachedInfo);
+            }
+            return true;
+        }
+
         bool AreSongsRefreshing() {
             auto instance = SongLoader::RuntimeSongLoader::get_instance();
             if (!instance) return false;
@@ -314,6 +343,12 @@ namespace SongCore::API {
             return instance->AllLevels;
         }
 
+        SongCore::SongLoader::RefreshTimingReport GetLastRefreshTimings() {
+            auto instance = SongLoader::RuntimeSongLoader::get_instance();
+            if (!instance) return {};
+            return instance->GetLastRefreshTimings();
+        }
+
         SongLoader::CustomLevelPack* GetCustomLevelPack() {
             auto instance = SongLoader::RuntimeSongLoader::get_instance();
             if (!instance) return nullptr;
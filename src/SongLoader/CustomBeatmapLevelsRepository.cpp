@@ -56,4 +56,14 @@ namespace SongCore::SongLoader {
             }
         }
     }
+
+    void CustomBeatmapLevelsRepository::AddToBackingDictionaries(GlobalNamespace::BeatmapLevelPack* pack, std::span<CustomBeatmapLevel* const> levels) {
+        auto packID = pack->packID;
+        for (auto level : levels) {
+            auto levelID = level->levelID;
+
+            _beatmapLevelIdToBeatmapLevelPackId->TryAdd(levelID, packID);
+            _idToBeatmapLevel->TryAdd(levelID, level);
+        }
+    }
 }
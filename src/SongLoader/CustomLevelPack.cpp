@@ -31,4 +31,10 @@ namespace SongCore::SongLoader {
         beatmapLevels = ArrayW<GlobalNamespace::BeatmapLevel*>(levels.size());
         std::copy(levels.begin(), levels.end(), beatmapLevels.begin());
     }
+
+    void CustomLevelPack::AddLevels(std::span<CustomBeatmapLevel* const> levels) {
+        auto oldLevels = beatmapLevels;
+        beatmapLevels = ArrayW<GlobalNamespace::BeatmapLevel*>(oldLevels.size() + levels.size());
+        std::copy(levels.begin(), levels.end(), std::copy(oldLevels.begin(), oldLevels.end(), beatmapLevels.begin()));
+    }
 }
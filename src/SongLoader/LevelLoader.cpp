@@ -7,11 +7,13 @@
 #include "UnityEngine/Color.hpp"
 #include "Utils/WavRiff.hpp"
 #include "logging.hpp"
+#include "tracing.hpp"
 #include "Utils/Hashing.hpp"
 #include "Utils/File.hpp"
 #include "Utils/OggVorbis.hpp"
 #include "Utils/WavRiff.hpp"
 #include "Utils/Cache.hpp"
+#include "Utils/Directory.hpp"
 
 #include "bsml/shared/Helpers/utilities.hpp"
 #include "GlobalNamespace/BeatmapDifficultySerializedMethods.hpp"
@@ -31,6 +33,7 @@
 #include "BeatmapLevelSaveDataVersion4/AudioSaveData.hpp"
 #include "Newtonsoft/Json/JsonConvert.hpp"
 #include "utf8.h"
+#include <array>
 #include <cmath>
 #include <exception>
 #include <filesystem>
@@ -56,24 +59,76 @@ namespace SongCore::SongLoader {
         return GetSaveDataFromV3(path);
     }
 
+    StringW EmptyString() {
+        static ConstString empty("");
+        return empty;
+    }
+
+    /// @brief sets what is missing from the info.dat to the defaults loading the level assumes, so anything else using the savedata sees the same
+    static void FillMissingFields(SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData) {
+        if (!saveData->difficultyBeatmapSets) saveData->_difficultyBeatmapSets = ArrayW<GlobalNamespace::StandardLevelInfoSaveData::DifficultyBeatmapSet*>::Empty();
+        if (!saveData->environmentName) saveData->_environmentName = EmptyString();
+        if (!saveData->allDirectionsEnvironmentName) saveData->_allDirectionsEnvironmentName = EmptyString();
+        if (!saveData->environmentNames) saveData->_environmentNames = ArrayW<StringW>::Empty();
+        if (!saveData->colorSchemes) saveData->_colorSchemes = ArrayW<GlobalNamespace::BeatmapLevelColorSchemeSaveData*>::Empty();
+    }
+
+    /// @brief strings missing from the savedata become empty
+    static std::string ToString(StringW value) {
+        return value ? static_cast<std::string>(value) : std::string();
+    }
+
+    static std::vector<std::string> ToStrings(ArrayW<StringW> values) {
+        std::vector<std::string> strings;
+        if (!values) return strings;
+        strings.reserve(values.size());
+        for (auto value : values) strings.emplace_back(ToString(value));
+        return strings;
+    }
+
+    static ArrayW<StringW> ToStringArray(std::span<std::string const> values) {
+        if (values.empty()) return ArrayW<StringW>::Empty();
+        auto array = ArrayW<StringW>(il2cpp_array_size_t(values.size()));
+        for (size_t i = 0; i < values.size(); i++) array[i] = values[i];
+        return array;
+    }
+
+    static std::array<float, 4> ToArray(UnityEngine::Color const& color) {
+        return { color.r, color.g, color.b, color.a };
+    }
+
+    static UnityEngine::Color ToColor(std::array<float, 4> const& color) {
+        return { color[0], color[1], color[2], color[3] };
+    }
+
+    static UnityEngine::Color ConvertHTMLStringToColor(std::string colorHtmlString) {
+        // if color does not start with # the library fails to parse the hex color. need to prepend that.
+        // this is different from PC where it just assumes a hex string means hex color
+        if (!colorHtmlString.starts_with('#')) colorHtmlString = fmt::format("#{}", colorHtmlString);
+        auto color = BSML::Utilities::ParseHTMLColorOpt(colorHtmlString);
+        if (!color)
+            return UnityEngine::Color::get_black();
+        return color.value();
+    }
+
     SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* LevelLoader::GetSaveDataFromV3(std::filesystem::path const& path) {
         if (path.empty()) {
             ERROR("Provided path was empty!");
             return nullptr;
         }
 
-        auto infoPath = path / "info.dat";
-        if (!std::filesystem::exists(infoPath)) {
-            infoPath = path / "Info.dat";
-            if (!std::filesystem::exists(infoPath)) {
-                ERROR("no info.dat found for song @ '{}', returning null!", path.string());
-                return nullptr;
-            }
+        auto infoPath = Utils::FindInfoDatPath(path);
+        if (!infoPath.has_value()) {
+            ERROR("no info.dat found for song @ '{}', returning null!", path.string());
+            return nullptr;
         }
 
+        return GetSaveDataFromV3(path, Utils::ReadText(*infoPath));
+    }
+
+    SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* LevelLoader::GetSaveDataFromV3(std::filesystem::path const& path, std::u16string_view infoText) {
         try {
-            auto text = Utils::ReadText(infoPath);
-            auto standardSaveData = LoadCustomSaveData(GlobalNamespace::StandardLevelInfoSaveData::DeserializeFromJSONString(text), text);
+            auto standardSaveData = LoadCustomSaveData(GlobalNamespace::StandardLevelInfoSaveData::DeserializeFromJSONString(infoText), infoText);
 
             if (!standardSaveData) {
                 ERROR("Cannot load file from path: {}!", path.string());
@@ -86,6 +141,7 @@ namespace SongCore::SongLoader {
                 return nullptr;
             }
 
+            FillMissingFields(opt.value());
             return opt.value();
         } catch(std::runtime_error& e) {
             ERROR("GetSaveDataFromV3 can't Load File {}: {}!", path.string(), e.what());
@@ -101,17 +157,17 @@ namespace SongCore::SongLoader {
             return nullptr;
         }
 
-        auto infoPath = path / "info.dat";
-        if (!std::filesystem::exists(infoPath)) {
-            infoPath = path / "Info.dat";
-            if (!std::filesystem::exists(infoPath)) {
-                ERROR("no info.dat found for song @ '{}', returning null!", path.string());
-                return nullptr;
-            }
+        auto infoPath = Utils::FindInfoDatPath(path);
+        if (!infoPath.has_value()) {
+            ERROR("no info.dat found for song @ '{}', returning null!", path.string());
+            return nullptr;
         }
 
+        return GetSaveDataFromV4(path, Utils::ReadText(*infoPath));
+    }
+
+    SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* LevelLoader::GetSaveDataFromV4(std::filesystem::path const& path, std::u16string_view infoText) {
         try {
-            auto infoText = Utils::ReadText(infoPath);
             auto beatmapLevelSaveData = LoadCustomSaveData(Newtonsoft::Json::JsonConvert::DeserializeObject<BeatmapLevelSaveDataVersion4::BeatmapLevelSaveData*>(infoText), infoText);
 
             if (!beatmapLevelSaveData) {
@@ -134,23 +190,32 @@ namespace SongCore::SongLoader {
         return nullptr;
     }
 
-    StringW EmptyString() {
-        static ConstString empty("");
-        return empty;
+    CustomBeatmapLevel* LevelLoader::LoadCustomBeatmapLevel(std::filesystem::path const& levelPath, bool wip, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData, std::string& hashOut) {
+        TRACE_SCOPE("LoadCustomBeatmapLevel");
+        float songDuration;
+        if (!PrepareCustomBeatmapLevel(levelPath, saveData, hashOut, songDuration)) return nullptr;
+        return ConstructCustomBeatmapLevel(levelPath, wip, saveData, hashOut, songDuration);
     }
 
-    #define FixEmptyString(name) \
-    if (!name) { \
-        name = EmptyString(); \
+    bool LevelLoader::PrepareCustomBeatmapLevel(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData, std::string& hashOut, float& songDurationOut, LevelLoadTiming* timing) {
+        TRACE_SCOPE("PrepareCustomBeatmapLevel");
+        if (!VerifyCustomBeatmapLevel(levelPath, saveData, songDurationOut, timing)) return false;
+
+        auto hashOpt = HashCustomBeatmapLevel(levelPath, saveData, timing);
+        if (!hashOpt.has_value()) return false;
+        hashOut = std::move(*hashOpt);
+        return true;
     }
 
-    CustomBeatmapLevel* LevelLoader::LoadCustomBeatmapLevel(std::filesystem::path const& levelPath, bool wip, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData, std::string& hashOut) {
+    bool LevelLoader::VerifyCustomBeatmapLevel(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData, float& songDurationOut, LevelLoadTiming* timing) {
+        auto verifyStartTime = std::chrono::high_resolution_clock::now();
+
         if (!saveData) {
             #ifdef THROW_ON_MISSING_DATA
             throw std::runtime_error(fmt::format("saveData was null for level @ {}", levelPath.string()));
             #else
             WARNING("saveData was null for level @ {}", levelPath.string());
-            return nullptr;
+            return false;
             #endif
         }
 
@@ -159,97 +224,124 @@ namespace SongCore::SongLoader {
             throw std::runtime_error(fmt::format("Map {} was missing files!", levelPath.string()));
             #else
             WARNING("Map {} was missing files!", levelPath);
-            return nullptr;
+            return false;
             #endif
         }
 
-        auto hashOpt = Utils::GetCustomLevelHash(levelPath, saveData);
-        hashOut = *hashOpt;
+        FillMissingFields(saveData);
 
-        std::string levelId = fmt::format("{}{}{}", RuntimeSongLoader::CUSTOM_LEVEL_PREFIX_ID, hashOut, wip ? " WIP" : "");
+        auto durationStartTime = std::chrono::high_resolution_clock::now();
+        if (timing) timing->Add(LoadStage::InfoParse, durationStartTime - verifyStartTime);
 
-        auto songName = saveData->songName;
-        FixEmptyString(songName)
-        auto songSubName = saveData->songSubName;
-        FixEmptyString(songSubName);
-        auto songAuthorName = saveData->songAuthorName;
-        FixEmptyString(songAuthorName);
-        auto levelAuthorName = saveData->levelAuthorName;
-        FixEmptyString(levelAuthorName);
+        songDurationOut = GetLengthForLevel(levelPath, saveData);
+        if (timing) timing->Add(LoadStage::DurationProbe, std::chrono::high_resolution_clock::now() - durationStartTime);
+        return true;
+    }
 
-        auto bpm = saveData->beatsPerMinute;
-        auto songTimeOffset = saveData->songTimeOffset;
-        auto previewStartTime = saveData->previewStartTime;
-        auto previewDuration = saveData->previewDuration;
+    std::optional<std::string> LevelLoader::HashCustomBeatmapLevel(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData, LevelLoadTiming* timing) {
+        auto hashStartTime = std::chrono::high_resolution_clock::now();
 
-        if (!saveData->environmentName) saveData->_environmentName = EmptyString();
-        auto environmentInfo = GetEnvironmentInfo(saveData->environmentName, false);
-        if (!saveData->allDirectionsEnvironmentName) saveData->_allDirectionsEnvironmentName = EmptyString();
-        auto allDirectionsEnvironmentInfo = GetEnvironmentInfo(saveData->allDirectionsEnvironmentName, true);
-        if (!saveData->environmentNames) saveData->_environmentNames = ArrayW<StringW>::Empty();
-        auto environmentInfos = GetEnvironmentInfos(saveData->environmentNames);
-        if (!saveData->colorSchemes) saveData->_colorSchemes = ArrayW<GlobalNamespace::BeatmapLevelColorSchemeSaveData*>::Empty();
-        auto colorSchemes = GetColorSchemes(saveData->colorSchemes);
-        if (!saveData->difficultyBeatmapSets) saveData->_difficultyBeatmapSets = ArrayW<GlobalNamespace::StandardLevelInfoSaveData::DifficultyBeatmapSet*>::Empty();
+        auto hashOpt = Utils::GetCustomLevelHash(levelPath, saveData);
+        if (timing) timing->Add(LoadStage::Hash, std::chrono::high_resolution_clock::now() - hashStartTime);
+        if (!hashOpt.has_value()) {
+            #ifdef THROW_ON_MISSING_DATA
+            throw std::runtime_error(fmt::format("Could not hash level @ {}", levelPath.string()));
+            #else
+            WARNING("Could not hash level @ {}", levelPath.string());
+            #endif
+        }
+        return hashOpt;
+    }
 
-        float songDuration = GetLengthForLevel(levelPath, saveData);
+    CustomBeatmapLevel* LevelLoader::ConstructCustomBeatmapLevel(std::filesystem::path const& levelPath, bool wip, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData, std::string_view hash, float songDuration) {
+        FillMissingFields(saveData);
+        auto metadata = GetLevelMetadata(saveData);
+        auto result = CreateCustomBeatmapLevel(levelPath, wip, metadata, hash, songDuration, saveData, nullptr);
+        CacheLevelMetadata(levelPath, metadata);
+        return result;
+    }
 
-        std::vector<GlobalNamespace::EnvironmentName> environmentNameList;
-        if (environmentInfos.size() == 0) {
-            environmentNameList.emplace_back(
-                environmentInfo->serializedName
-            );
-            environmentNameList.emplace_back(
-                allDirectionsEnvironmentInfo->serializedName
-            );
-        } else {
-            for (auto info : environmentInfos) {
-                environmentNameList.emplace_back(
-                    info->serializedName
-                );
+    LevelMetadata LevelLoader::GetLevelMetadata(SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData) {
+        LevelMetadata metadata;
+        metadata.songName = ToString(saveData->songName);
+        metadata.songSubName = ToString(saveData->songSubName);
+        metadata.songAuthorName = ToString(saveData->songAuthorName);
+        metadata.levelAuthorName = ToString(saveData->levelAuthorName);
+        metadata.beatsPerMinute = saveData->beatsPerMinute;
+        metadata.songTimeOffset = saveData->songTimeOffset;
+        metadata.previewStartTime = saveData->previewStartTime;
+        metadata.previewDuration = saveData->previewDuration;
+        metadata.coverImageFilename = ToString(saveData->coverImageFilename);
+        metadata.songFilename = ToString(saveData->songFilename);
+        metadata.environmentName = ToString(saveData->environmentName);
+        metadata.allDirectionsEnvironmentName = ToString(saveData->allDirectionsEnvironmentName);
+        metadata.environmentNames = ToStrings(saveData->environmentNames);
+
+        if (saveData->colorSchemes) {
+            for (auto colorSchemeData : saveData->colorSchemes) {
+                auto colorScheme = colorSchemeData->colorScheme;
+                if (!colorScheme) continue;
+                metadata.colorSchemes.push_back({
+                    .colorSchemeId = ToString(colorScheme->colorSchemeId),
+                    .colors = {
+                        ToArray(colorScheme->saberAColor),
+                        ToArray(colorScheme->saberBColor),
+                        ToArray(colorScheme->environmentColor0),
+                        ToArray(colorScheme->environmentColor1),
+                        ToArray(colorScheme->environmentColor0Boost),
+                        ToArray(colorScheme->environmentColor1Boost),
+                        ToArray(colorScheme->obstaclesColor)
+                    }
+                });
             }
         }
 
-        auto allMappers = ArrayW<StringW>({ levelAuthorName });
-        auto allLighters = ArrayW<StringW>::Empty();
-
-        auto previewMediaData = GetPreviewMediaData(levelPath, saveData->coverImageFilename, saveData->songFilename);
-        auto [beatmapLevelData, beatmapBasicData] = GetBeatmapLevelAndBasicData(levelPath, levelId, environmentNameList, colorSchemes, saveData);
-
-        auto result = CustomBeatmapLevel::New(
-            levelPath.string(),
-            saveData,
-            nullptr,
-            beatmapLevelData->i___GlobalNamespace__IBeatmapLevelData(),
-            false,
-            levelId,
-            songName,
-            songSubName,
-            songAuthorName,
-            allMappers,
-            allLighters,
-            bpm,
-            -6.0f,
-            songTimeOffset,
-            previewStartTime,
-            previewDuration,
-            songDuration,
-            GlobalNamespace::PlayerSensitivityFlag::Safe,
-            previewMediaData->i___GlobalNamespace__IPreviewMediaData(),
-            beatmapBasicData->i___System__Collections__Generic__IReadOnlyDictionary_2_TKey_TValue_()
-        );
+        if (saveData->difficultyBeatmapSets) {
+            for (auto beatmapSet : saveData->difficultyBeatmapSets) {
+                for (auto difficultyBeatmap : beatmapSet->difficultyBeatmaps) {
+                    metadata.difficulties.push_back({
+                        .characteristic = ToString(beatmapSet->beatmapCharacteristicName),
+                        .difficulty = ToString(difficultyBeatmap->difficulty),
+                        .beatmapFilename = ToString(difficultyBeatmap->beatmapFilename),
+                        .noteJumpMovementSpeed = difficultyBeatmap->noteJumpMovementSpeed,
+                        .noteJumpStartBeatOffset = difficultyBeatmap->noteJumpStartBeatOffset,
+                        .environmentNameIdx = difficultyBeatmap->environmentNameIdx,
+                        .beatmapColorSchemeIdx = difficultyBeatmap->beatmapColorSchemeIdx
+                    });
+                }
+            }
+        }
 
-        return result;
+        return metadata;
     }
 
     // LevelLoader.CreateBeatmapLevelFromV4
     CustomBeatmapLevel* LevelLoader::LoadCustomBeatmapLevel(std::filesystem::path const& levelPath, bool wip, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData, std::string& hashOut) {
+        TRACE_SCOPE("LoadCustomBeatmapLevel");
+        float songDuration;
+        if (!PrepareCustomBeatmapLevel(levelPath, saveData, hashOut, songDuration)) return nullptr;
+        return ConstructCustomBeatmapLevel(levelPath, wip, saveData, hashOut, songDuration);
+    }
+
+    bool LevelLoader::PrepareCustomBeatmapLevel(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData, std::string& hashOut, float& songDurationOut, LevelLoadTiming* timing) {
+        TRACE_SCOPE("PrepareCustomBeatmapLevel");
+        if (!VerifyCustomBeatmapLevel(levelPath, saveData, songDurationOut, timing)) return false;
+
+        auto hashOpt = HashCustomBeatmapLevel(levelPath, saveData, timing);
+        if (!hashOpt.has_value()) return false;
+        hashOut = std::move(*hashOpt);
+        return true;
+    }
+
+    bool LevelLoader::VerifyCustomBeatmapLevel(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData, float& songDurationOut, LevelLoadTiming* timing) {
+        auto verifyStartTime = std::chrono::high_resolution_clock::now();
+
         if (!saveData) {
             WARNING("saveData was null for level @ {}", levelPath.string());
             #ifdef THROW_ON_MISSING_DATA
             throw std::runtime_error(fmt::format("saveData was null for level @ {}", levelPath.string()));
             #else
-            return nullptr;
+            return false;
             #endif
         }
 
@@ -258,59 +350,164 @@ namespace SongCore::SongLoader {
             #ifdef THROW_ON_MISSING_DATA
             throw std::runtime_error(fmt::format("Map {} was missing files!", levelPath.string()));
             #else
-            return nullptr;
+            return false;
             #endif
         }
 
+        auto durationStartTime = std::chrono::high_resolution_clock::now();
+        if (timing) timing->Add(LoadStage::InfoParse, durationStartTime - verifyStartTime);
+
+        songDurationOut = GetLengthForLevel(levelPath, saveData);
+        if (timing) timing->Add(LoadStage::DurationProbe, std::chrono::high_resolution_clock::now() - durationStartTime);
+        return true;
+    }
+
+    std::optional<std::string> LevelLoader::HashCustomBeatmapLevel(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData, LevelLoadTiming* timing) {
+        auto hashStartTime = std::chrono::high_resolution_clock::now();
+
         auto hashOpt = Utils::GetCustomLevelHash(levelPath, saveData);
-        hashOut = *hashOpt;
+        if (timing) timing->Add(LoadStage::Hash, std::chrono::high_resolution_clock::now() - hashStartTime);
+        if (!hashOpt.has_value()) {
+            WARNING("Could not hash level @ {}", levelPath.string());
+            #ifdef THROW_ON_MISSING_DATA
+            throw std::runtime_error(fmt::format("Could not hash level @ {}", levelPath.string()));
+            #endif
+        }
+        return hashOpt;
+    }
 
-        std::string levelId = fmt::format("{}{}{}", RuntimeSongLoader::CUSTOM_LEVEL_PREFIX_ID, hashOut, wip ? " WIP" : "");
+    CustomBeatmapLevel* LevelLoader::ConstructCustomBeatmapLevel(std::filesystem::path const& levelPath, bool wip, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData, std::string_view hash, float songDuration) {
+        auto metadata = GetLevelMetadata(saveData);
+        auto result = CreateCustomBeatmapLevel(levelPath, wip, metadata, hash, songDuration, nullptr, saveData);
+        CacheLevelMetadata(levelPath, metadata);
+        return result;
+    }
 
+    LevelMetadata LevelLoader::GetLevelMetadata(SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData) {
+        LevelMetadata metadata;
+        metadata.isV4 = true;
         auto [songName, songSubName, songAuthorName] = saveData->song;
-        FixEmptyString(songName)
-        FixEmptyString(songSubName);
-        FixEmptyString(songAuthorName);
+        metadata.songName = ToString(songName);
+        metadata.songSubName = ToString(songSubName);
+        metadata.songAuthorName = ToString(songAuthorName);
+        metadata.beatsPerMinute = saveData->audio.bpm;
+        metadata.integratedLufs = (saveData->audio.lufs != 0.0f) ? saveData->audio.lufs : (-6.0f);
+        metadata.previewStartTime = saveData->audio.previewStartTime;
+        metadata.previewDuration = saveData->audio.previewDuration;
+        metadata.coverImageFilename = ToString(saveData->coverImageFilename);
+        metadata.songFilename = ToString(saveData->audio.songFilename);
+        metadata.audioDataFilename = ToString(saveData->audio.audioDataFilename);
+        metadata.environmentNames = ToStrings(saveData->environmentNames);
+
+        if (saveData->colorSchemes) {
+            for (auto colorScheme : saveData->colorSchemes) {
+                auto name = ToString(colorScheme->colorSchemeName);
+                metadata.colorSchemes.push_back({
+                    .colorSchemeId = name,
+                    .localizationKey = name,
+                    .useNonLocalizedName = true,
+                    .nonLocalizedName = name,
+                    .colors = {
+                        ToArray(ConvertHTMLStringToColor(ToString(colorScheme->saberAColor))),
+                        ToArray(ConvertHTMLStringToColor(ToString(colorScheme->saberBColor))),
+                        ToArray(ConvertHTMLStringToColor(ToString(colorScheme->environmentColor0))),
+                        ToArray(ConvertHTMLStringToColor(ToString(colorScheme->environmentColor1))),
+                        ToArray(ConvertHTMLStringToColor(ToString(colorScheme->environmentColor0Boost))),
+                        ToArray(ConvertHTMLStringToColor(ToString(colorScheme->environmentColor1Boost))),
+                        ToArray(ConvertHTMLStringToColor(ToString(colorScheme->obstaclesColor)))
+                    }
+                });
+            }
+        }
 
-        auto bpm = saveData->audio.bpm;
-        auto lufs = (saveData->audio.lufs != 0.0f) ? saveData->audio.lufs : (-6.0f);
-        auto previewStartTime = saveData->audio.previewStartTime;
-        auto previewDuration = saveData->audio.previewDuration;
+        for (auto diffBeatmap : saveData->difficultyBeatmaps) {
+            metadata.difficulties.push_back({
+                .characteristic = ToString(diffBeatmap->characteristic),
+                .difficulty = ToString(diffBeatmap->difficulty),
+                .beatmapFilename = ToString(diffBeatmap->beatmapDataFilename),
+                .lightshowFilename = ToString(diffBeatmap->lightshowDataFilename),
+                .noteJumpMovementSpeed = diffBeatmap->noteJumpMovementSpeed,
+                .noteJumpStartBeatOffset = diffBeatmap->noteJumpStartBeatOffset,
+                .environmentNameIdx = diffBeatmap->environmentNameIdx,
+                .beatmapColorSchemeIdx = diffBeatmap->beatmapColorSchemeIdx,
+                .mappers = ToStrings(diffBeatmap->beatmapAuthors.mappers),
+                .lighters = ToStrings(diffBeatmap->beatmapAuthors.lighters)
+            });
+        }
 
-        float songDuration = GetLengthForLevel(levelPath, saveData);
+        return metadata;
+    }
+
+    CustomBeatmapLevel* LevelLoader::ConstructCustomBeatmapLevel(std::filesystem::path const& levelPath, bool wip, LevelMetadata const& metadata, std::string_view hash, float songDuration) {
+        return CreateCustomBeatmapLevel(levelPath, wip, metadata, hash, songDuration, nullptr, nullptr);
+    }
 
-        auto previewMediaData = GetPreviewMediaData(levelPath, saveData->coverImageFilename, saveData->audio.songFilename);
-        auto [beatmapLevelData, beatmapBasicData] = GetBeatmapLevelAndBasicData(levelPath, levelId, saveData);
+    void LevelLoader::CacheLevelMetadata(std::filesystem::path const& levelPath, LevelMetadata const& metadata) {
+        // the next refresh constructs the level from this instead of parsing its info.dat
+        auto serialized = metadata.Serialize();
+        Utils::UpdateCachedInfo(levelPath, [&serialized](Utils::CachedSongData& data){ data.levelMetadata = std::move(serialized); });
+    }
 
-        auto allMappers = ListW<StringW>::New();
-        auto allLighters = ListW<StringW>::New();
+    // LevelLoader.CreateBeatmapLevelFromV4, levels before v4 go through the same with what they don't have left empty
+    CustomBeatmapLevel* LevelLoader::CreateCustomBeatmapLevel(std::filesystem::path const& levelPath, bool wip, LevelMetadata const& metadata, std::string_view hash, float songDuration, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveDataV2, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveDataV4) {
+        TRACE_SCOPE("ConstructCustomBeatmapLevel");
+        std::string levelId = fmt::format("{}{}{}", RuntimeSongLoader::CUSTOM_LEVEL_PREFIX_ID, hash, wip ? " WIP" : "");
 
-        for (auto diffBeatmap : saveData->difficultyBeatmaps) {
-            for (auto author : diffBeatmap->beatmapAuthors.mappers) {
-                allMappers->Add(author);
+        std::vector<GlobalNamespace::EnvironmentName> environmentNameList;
+        if (metadata.isV4) {
+            for (auto const& name : metadata.environmentNames) {
+                environmentNameList.emplace_back(
+                    GetEnvironmentInfo(name, false)->serializedName
+                );
             }
-            for (auto author : diffBeatmap->beatmapAuthors.lighters) {
-                allLighters->Add(author);
+        } else {
+            auto environmentInfos = GetEnvironmentInfos(metadata.environmentNames);
+            if (environmentInfos.size() == 0) {
+                environmentNameList.emplace_back(
+                    GetEnvironmentInfo(metadata.environmentName, false)->serializedName
+                );
+                environmentNameList.emplace_back(
+                    GetEnvironmentInfo(metadata.allDirectionsEnvironmentName, true)->serializedName
+                );
+            } else {
+                for (auto info : environmentInfos) {
+                    environmentNameList.emplace_back(
+                        info->serializedName
+                    );
+                }
             }
         }
+        auto colorSchemes = GetColorSchemes(metadata.colorSchemes);
+
+        // levels before v4 have a single author for the whole level
+        std::vector<std::string> allMappers;
+        std::vector<std::string> allLighters;
+        if (!metadata.isV4) allMappers.emplace_back(metadata.levelAuthorName);
+        for (auto const& difficulty : metadata.difficulties) {
+            allMappers.insert(allMappers.end(), difficulty.mappers.begin(), difficulty.mappers.end());
+            allLighters.insert(allLighters.end(), difficulty.lighters.begin(), difficulty.lighters.end());
+        }
+
+        auto previewMediaData = GetPreviewMediaData(levelPath, metadata.coverImageFilename, metadata.songFilename);
+        auto [beatmapLevelData, beatmapBasicData] = GetBeatmapLevelAndBasicData(levelPath, levelId, environmentNameList, colorSchemes, metadata);
 
         auto result = CustomBeatmapLevel::New(
             levelPath.string(),
-            nullptr,
-            saveData,
+            saveDataV2,
+            saveDataV4,
             beatmapLevelData->i___GlobalNamespace__IBeatmapLevelData(),
             false,
             levelId,
-            songName,
-            songSubName,
-            songAuthorName,
-            allMappers.to_array(),
-            allLighters.to_array(),
-            bpm,
-            lufs,
-            0.0f,
-            previewStartTime,
-            previewDuration,
+            metadata.songName,
+            metadata.songSubName,
+            metadata.songAuthorName,
+            ToStringArray(allMappers),
+            ToStringArray(allLighters),
+            metadata.beatsPerMinute,
+            metadata.integratedLufs,
+            metadata.songTimeOffset,
+            metadata.previewStartTime,
+            metadata.previewDuration,
             songDuration,
             GlobalNamespace::PlayerSensitivityFlag::Safe,
             previewMediaData->i___GlobalNamespace__IPreviewMediaData(),
@@ -320,169 +517,18 @@ namespace SongCore::SongLoader {
         return result;
     }
 
-
-    // V2 | V3
-    std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, LevelLoader::BeatmapBasicDataDict*> LevelLoader::GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, std::span<GlobalNamespace::EnvironmentName const> environmentNames, std::span<GlobalNamespace::ColorScheme* const> colorSchemes, CustomJSONData::CustomLevelInfoSaveDataV2* saveData) {
-        auto fileDifficultyBeatmapsDict = System::Collections::Generic::Dictionary_2<CharacteristicDifficultyPair, GlobalNamespace::FileDifficultyBeatmap*>::New_ctor();
-        auto basicDataDict = LevelLoader::BeatmapBasicDataDict::New_ctor();
-        bool saveDataHadEnvNames = saveData->environmentNames.size() > 0;
-
-        for (auto beatmapSet : saveData->difficultyBeatmapSets) {
-            auto characteristic = _beatmapCharacteristicCollection->GetBeatmapCharacteristicBySerializedName(beatmapSet->beatmapCharacteristicName);
-            if (!characteristic) {
-                #ifdef THROW_ON_MISSING_DATA
-                    throw std::runtime_error(fmt::format("Got null characteristic for characteristic name {}", beatmapSet->beatmapCharacteristicName));
-                #else
-                    WARNING("Got null characteristic for characteristic name {}, skipping...", beatmapSet->beatmapCharacteristicName);
-                    continue;
-                #endif
-            }
-
-            for (auto difficultyBeatmap : beatmapSet->difficultyBeatmaps) {
-                GlobalNamespace::BeatmapDifficulty difficulty;
-                auto parseSuccess = GlobalNamespace::BeatmapDifficultySerializedMethods::BeatmapDifficultyFromSerializedName(
-                    difficultyBeatmap->difficulty,
-                    byref(difficulty)
-                );
-
-                if (!parseSuccess) {
-                    #ifdef THROW_ON_MISSING_DATA
-                        throw std::runtime_error(fmt::format("Failed to parse a diff string: {}", difficultyBeatmap->difficulty));
-                    #else
-                        WARNING("Failed to parse a diff string: {}, skipping...", difficultyBeatmap->difficulty);
-                        continue;
-                    #endif
-                }
-
-                auto beatmapPath = levelPath / std::string(difficultyBeatmap->beatmapFilename);
-                if (!std::filesystem::exists(beatmapPath)) {
-                    #ifdef THROW_ON_MISSING_DATA
-                        throw std::runtime_error(fmt::format("Diff file '{}' does not exist", beatmapPath.string()));
-                    #else
-                        WARNING("Diff file '{}' does not exist, skipping...", beatmapPath.string());
-                        continue;
-                    #endif
-                }
-
-                auto const dictKey = CharacteristicDifficultyPair(
-                    characteristic,
-                    difficulty
-                );
-
-                // This is v3 apparently so no need for a lightshow
-                fileDifficultyBeatmapsDict->Add(
-                    dictKey,
-                    GlobalNamespace::FileDifficultyBeatmap::New_ctor(
-                        beatmapPath.string(),
-                        ""
-                    )
-                );
-
-                // if we have env names, use the idx, otherwise use whether the char had rotation (no rot means use default env, otherwise use rotation env)
-                int envNameIndex = saveDataHadEnvNames ? difficultyBeatmap->environmentNameIdx : characteristic->containsRotationEvents ? 1 : 0;
-                envNameIndex = std::clamp<int>(envNameIndex, 0, environmentNames.size());
-                int colorSchemeIndex = difficultyBeatmap->beatmapColorSchemeIdx;
-                auto colorScheme = (colorSchemeIndex >= 0 && colorSchemeIndex < colorSchemes.size()) ? colorSchemes[colorSchemeIndex] : nullptr;
-
-                basicDataDict->Add(
-                    dictKey,
-                    GlobalNamespace::BeatmapBasicData::New_ctor(
-                        difficultyBeatmap->noteJumpMovementSpeed,
-                        difficultyBeatmap->noteJumpStartBeatOffset,
-                        environmentNames[envNameIndex],
-                        colorScheme,
-                        0,
-                        0,
-                        0,
-                        ArrayW<StringW>::Empty(),
-                        ArrayW<StringW>::Empty()
-                    )
-                );
-            }
-        }
-
-        return {
-            GlobalNamespace::FileSystemBeatmapLevelData::New_ctor(
-                levelID,
-                (levelPath / std::string(saveData->songFilename)).string(),
-                "",
-                fileDifficultyBeatmapsDict
-            ),
-            basicDataDict
-        };
-    }
-
-    // V4
     // implementation of CustomLevelLoader.CreateBeatmapLevelDataFromV4
-    std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, LevelLoader::BeatmapBasicDataDict*> LevelLoader::GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData) {
+    std::pair<GlobalNamespace::FileSystemBeatmapLevelData*, LevelLoader::BeatmapBasicDataDict*> LevelLoader::GetBeatmapLevelAndBasicData(std::filesystem::path const& levelPath, std::string_view levelID, std::span<GlobalNamespace::EnvironmentName const> environmentNames, std::span<GlobalNamespace::ColorScheme* const> colorSchemes, LevelMetadata const& metadata) {
         auto fileDifficultyBeatmapsDict = System::Collections::Generic::Dictionary_2<CharacteristicDifficultyPair, GlobalNamespace::FileDifficultyBeatmap*>::New_ctor();
         auto basicDataDict = LevelLoader::BeatmapBasicDataDict::New_ctor();
+        bool saveDataHadEnvNames = metadata.environmentNames.size() > 0;
 
-        std::vector<GlobalNamespace::EnvironmentName> environmentNames;
-        INFO("Environments {}", fmt::join(saveData->environmentNames, ";"));
-
-        for (StringW name : saveData->environmentNames) {
-            environmentNames.emplace_back(
-                GetEnvironmentInfo(name, false)->serializedName
-            );
-            INFO("Environment {}",
-                 GetEnvironmentInfo(name, false)->serializedName);
-        }
-
-        auto colorSchemes = ListW<GlobalNamespace::ColorScheme*>::New();
-        static auto ConvertHTMLStringToColor = [](std::string colorHtmlString) {
-            // if color does not start with # the library fails to parse the hex color. need to prepend that.
-            // this is different from PC where it just assumes a hex string means hex color
-            if (!colorHtmlString.starts_with('#')) colorHtmlString = fmt::format("#{}", colorHtmlString);
-            auto color = BSML::Utilities::ParseHTMLColorOpt(colorHtmlString);
-            if (!color)
-                return UnityEngine::Color::get_black();
-            return color.value();
-        };
-        if (saveData->colorSchemes) {
-            for (int i = 0; i < saveData->colorSchemes.size(); i++) {
-                auto colorScheme = saveData->colorSchemes[i];
-                auto name = colorScheme->colorSchemeName;
-                bool nonLocalized = true;
-                bool editable = false;
-                auto saberAColor = ConvertHTMLStringToColor(colorScheme->saberAColor);
-                auto saberBColor = ConvertHTMLStringToColor(colorScheme->saberBColor);
-                auto obstaclesColor = ConvertHTMLStringToColor(colorScheme->obstaclesColor);
-                auto envColor0 = ConvertHTMLStringToColor(colorScheme->environmentColor0);
-                auto envColor1 = ConvertHTMLStringToColor(colorScheme->environmentColor1);
-                auto envColor0Boost = ConvertHTMLStringToColor(colorScheme->environmentColor0Boost);
-                auto envColor1Boost = ConvertHTMLStringToColor(colorScheme->environmentColor1Boost);
-
-                auto scheme = GlobalNamespace::ColorScheme::New_ctor(
-                    name,
-                    name,
-                    nonLocalized,
-                    name,
-                    editable,
-                    saberAColor,
-                    saberBColor,
-                    envColor0,
-                    envColor1,
-                    {1, 1, 1, 1},
-                    true,
-                    envColor0Boost,
-                    envColor1Boost,
-                    {1, 1, 1, 1},
-                    obstaclesColor
-                );
-
-                INFO("ColorScheme ptr: {}", fmt::ptr(scheme));
-
-                colorSchemes->Add(scheme);
-            }
-        }
-
-        for (auto diffBeatmap : saveData->difficultyBeatmaps) {
-            auto characteristic = _beatmapCharacteristicCollection->GetBeatmapCharacteristicBySerializedName(diffBeatmap->characteristic);
+        for (auto const& diffBeatmap : metadata.difficulties) {
+            auto characteristic = _beatmapCharacteristicCollection->GetBeatmapCharacteristicBySerializedName(diffBeatmap.characteristic);
             if (!characteristic) {
-                WARNING("Got null characteristic for characteristic name {}, skipping...", diffBeatmap->characteristic);
+                WARNING("Got null characteristic for characteristic name {}, skipping...", diffBeatmap.characteristic);
                 #ifdef THROW_ON_MISSING_DATA
-                    throw std::runtime_error(fmt::format("Got null characteristic for characteristic name {}", diffBeatmap->characteristic));
+                    throw std::runtime_error(fmt::format("Got null characteristic for characteristic name {}", diffBeatmap.characteristic));
                 #else
                     continue;
                 #endif
@@ -490,20 +536,20 @@ namespace SongCore::SongLoader {
 
             GlobalNamespace::BeatmapDifficulty difficulty;
             auto parseSuccess = GlobalNamespace::BeatmapDifficultySerializedMethods::BeatmapDifficultyFromSerializedName(
-                diffBeatmap->difficulty,
+                diffBeatmap.difficulty,
                 byref(difficulty)
             );
 
             if (!parseSuccess) {
-                WARNING("Failed to parse a diff string: {}, skipping...", diffBeatmap->difficulty);
+                WARNING("Failed to parse a diff string: {}, skipping...", diffBeatmap.difficulty);
                 #ifdef THROW_ON_MISSING_DATA
-                    throw std::runtime_error(fmt::format("Failed to parse a diff string: {}", diffBeatmap->difficulty));
+                    throw std::runtime_error(fmt::format("Failed to parse a diff string: {}", diffBeatmap.difficulty));
                 #else
                     continue;
                 #endif
             }
 
-            auto beatmapPath = levelPath / std::string(diffBeatmap->beatmapDataFilename);
+            auto beatmapPath = levelPath / diffBeatmap.beatmapFilename;
             if (!std::filesystem::exists(beatmapPath)) {
                 WARNING("Diff file '{}' does not exist, skipping...", beatmapPath.string());
                 #ifdef THROW_ON_MISSING_DATA
@@ -513,14 +559,19 @@ namespace SongCore::SongLoader {
                 #endif
             }
 
-            auto lightingPath = levelPath / std::string(diffBeatmap->lightshowDataFilename);
-            if (!std::filesystem::exists(lightingPath)) {
-                WARNING("Diff Lighting file '{}' does not exist, skipping...", lightingPath.string());
-                #ifdef THROW_ON_MISSING_DATA
-                    throw std::runtime_error(fmt::format("Diff Lighting file '{}' does not exist", lightingPath.string()));
-                #else
-                    continue;
-                #endif
+            // levels before v4 have no lightshow
+            std::string lightshowPath;
+            if (metadata.isV4) {
+                auto lightingPath = levelPath / diffBeatmap.lightshowFilename;
+                if (!std::filesystem::exists(lightingPath)) {
+                    WARNING("Diff Lighting file '{}' does not exist, skipping...", lightingPath.string());
+                    #ifdef THROW_ON_MISSING_DATA
+                        throw std::runtime_error(fmt::format("Diff Lighting file '{}' does not exist", lightingPath.string()));
+                    #else
+                        continue;
+                    #endif
+                }
+                lightshowPath = lightingPath.string();
             }
 
             auto const dictKey = CharacteristicDifficultyPair(
@@ -532,46 +583,40 @@ namespace SongCore::SongLoader {
                 dictKey,
                 GlobalNamespace::FileDifficultyBeatmap::New_ctor(
                     beatmapPath.string(),
-                    lightingPath.string()
+                    lightshowPath
                 )
             );
 
-            ListW<StringW> mappers = ListW<StringW>::New();
-            ListW<StringW> lighters = ListW<StringW>::New();
-
-            for (auto author : diffBeatmap->beatmapAuthors.mappers) {
-                mappers->Add(author);
-            }
-            for (auto author : diffBeatmap->beatmapAuthors.lighters) {
-                lighters->Add(author);
+            int envNameIndex = diffBeatmap.environmentNameIdx;
+            if (!metadata.isV4) {
+                // if we have env names, use the idx, otherwise use whether the char had rotation (no rot means use default env, otherwise use rotation env)
+                envNameIndex = saveDataHadEnvNames ? envNameIndex : characteristic->containsRotationEvents ? 1 : 0;
+                envNameIndex = std::clamp<int>(envNameIndex, 0, environmentNames.size());
             }
-
-            auto environmentName = environmentNames[diffBeatmap->environmentNameIdx];
-			auto colorScheme = ((diffBeatmap->beatmapColorSchemeIdx >= 0 && diffBeatmap->beatmapColorSchemeIdx < colorSchemes.size()) ? colorSchemes[diffBeatmap->beatmapColorSchemeIdx] : nullptr);
-
-            INFO("Creating basic data with env name {} and color scheme {}", environmentName._environmentName, colorScheme ? colorScheme->colorSchemeId : "null");
+            int colorSchemeIndex = diffBeatmap.beatmapColorSchemeIdx;
+            auto colorScheme = (colorSchemeIndex >= 0 && colorSchemeIndex < colorSchemes.size()) ? colorSchemes[colorSchemeIndex] : nullptr;
 
             basicDataDict->Add(
-                    dictKey,
-                    GlobalNamespace::BeatmapBasicData::New_ctor(
-                        diffBeatmap->noteJumpMovementSpeed,
-                        diffBeatmap->noteJumpStartBeatOffset,
-                        environmentName,
-                        colorScheme,
-                        0,
-                        0,
-                        0,
-                        mappers.to_array(),
-                        lighters.to_array()
-                    )
-                );
+                dictKey,
+                GlobalNamespace::BeatmapBasicData::New_ctor(
+                    diffBeatmap.noteJumpMovementSpeed,
+                    diffBeatmap.noteJumpStartBeatOffset,
+                    environmentNames[envNameIndex],
+                    colorScheme,
+                    0,
+                    0,
+                    0,
+                    ToStringArray(diffBeatmap.mappers),
+                    ToStringArray(diffBeatmap.lighters)
+                )
+            );
         }
 
         return {
             GlobalNamespace::FileSystemBeatmapLevelData::New_ctor(
                 levelID,
-                (levelPath / std::string(saveData->audio.songFilename)).string(),
-                (levelPath / std::string(saveData->audio.audioDataFilename)).string(),
+                (levelPath / metadata.songFilename).string(),
+                metadata.isV4 ? (levelPath / metadata.audioDataFilename).string() : "",
                 fileDifficultyBeatmapsDict
             ),
             basicDataDict
@@ -595,11 +640,11 @@ namespace SongCore::SongLoader {
         return env;
     }
 
-    ArrayW<GlobalNamespace::EnvironmentInfoSO*> LevelLoader::GetEnvironmentInfos(std::span<StringW const> environmentsNames) {
+    ArrayW<GlobalNamespace::EnvironmentInfoSO*> LevelLoader::GetEnvironmentInfos(std::span<std::string const> environmentsNames) {
         if (environmentsNames.empty()) return ArrayW<GlobalNamespace::EnvironmentInfoSO*>::Empty();
         auto envs = ListW<GlobalNamespace::EnvironmentInfoSO*>::New();
 
-        for (auto environmentName : environmentsNames) {
+        for (auto const& environmentName : environmentsNames) {
             auto env = _environmentsListModel->GetEnvironmentInfoBySerializedName(environmentName);
             if (env) envs->Add(env);
         }
@@ -607,38 +652,37 @@ namespace SongCore::SongLoader {
         return envs->ToArray();
     }
 
-    ArrayW<GlobalNamespace::ColorScheme*> LevelLoader::GetColorSchemes(std::span<GlobalNamespace::BeatmapLevelColorSchemeSaveData* const> colorSchemeDatas) {
+    ArrayW<GlobalNamespace::ColorScheme*> LevelLoader::GetColorSchemes(std::span<LevelMetadata::ColorScheme const> colorSchemeDatas) {
         if (colorSchemeDatas.empty()) return ArrayW<GlobalNamespace::ColorScheme*>::Empty();
 
         auto colorSchemes = ListW<GlobalNamespace::ColorScheme*>::New();
-        for (auto saveData : colorSchemeDatas) {
-            auto colorScheme = saveData->colorScheme;
-            if (colorScheme) {
-                colorSchemes->Add(
-                    GlobalNamespace::ColorScheme::New_ctor(
-                        colorScheme->colorSchemeId,
-                        "",
-                        false,
-                        "",
-                        false,
-                        colorScheme->saberAColor,
-                        colorScheme->saberBColor,
-                        colorScheme->environmentColor0,
-                        colorScheme->environmentColor1,
-                        {1, 1, 1, 1},
-                        true,
-                        colorScheme->environmentColor0Boost,
-                        colorScheme->environmentColor1Boost,
-                        {1, 1, 1, 1},
-                        colorScheme->obstaclesColor
-                    )
-                );
-            }
+        for (auto const& colorScheme : colorSchemeDatas) {
+            auto const& [saberAColor, saberBColor, environmentColor0, environmentColor1, environmentColor0Boost, environmentColor1Boost, obstaclesColor] = colorScheme.colors;
+            colorSchemes->Add(
+                GlobalNamespace::ColorScheme::New_ctor(
+                    colorScheme.colorSchemeId,
+                    colorScheme.localizationKey,
+                    colorScheme.useNonLocalizedName,
+                    colorScheme.nonLocalizedName,
+                    false,
+                    ToColor(saberAColor),
+                    ToColor(saberBColor),
+                    ToColor(environmentColor0),
+                    ToColor(environmentColor1),
+                    {1, 1, 1, 1},
+                    true,
+                    ToColor(environmentColor0Boost),
+                    ToColor(environmentColor1Boost),
+                    {1, 1, 1, 1},
+                    ToColor(obstaclesColor)
+                )
+            );
         }
         return colorSchemes->ToArray();
     }
 
     float LevelLoader::GetLengthForLevel(std::filesystem::path const& levelPath, CustomJSONData::CustomLevelInfoSaveDataV2* saveData) {
+        TRACE_SCOPE("GetLengthForLevel");
         // check the cached info
         auto cachedInfoOpt = Utils::GetCachedInfo(levelPath);
         if (cachedInfoOpt.has_value() && cachedInfoOpt->songDuration.has_value()) {
@@ -650,31 +694,26 @@ namespace SongCore::SongLoader {
                 float songDuration = Utils::GetLengthFromOggVorbis(songFilePath);
                 if (songDuration >= 0 && !std::isnan(songDuration)) { // found duration was valid
                     // update cache with new duration
-                    auto info = cachedInfoOpt.value_or(Utils::CachedSongData());
-                    info.songDuration = songDuration;
-                    Utils::SetCachedInfo(levelPath, info);
+                    Utils::UpdateCachedInfo(levelPath, [songDuration](Utils::CachedSongData& data){ data.songDuration = songDuration; });
                     return songDuration;
                 }
                 songDuration = Utils::GetLengthFromWavRiff(songFilePath);
                 if (songDuration >= 0 && !std::isnan(songDuration)) { // found duration was valid
                     // update cache with new duration
-                    auto info = cachedInfoOpt.value_or(Utils::CachedSongData());
-                    info.songDuration = songDuration;
-                    Utils::SetCachedInfo(levelPath, info);
+                    Utils::UpdateCachedInfo(levelPath, [songDuration](Utils::CachedSongData& data){ data.songDuration = songDuration; });
                     return songDuration;
                 }
             }
 
             // if the file didn't exist or we didn't get a valid length from the ogg, we go and get it from the map
             float songDuration = GetLengthFromMap(levelPath, saveData);
-            auto info = cachedInfoOpt.value_or(Utils::CachedSongData());
-            info.songDuration = songDuration;
-            Utils::SetCachedInfo(levelPath, info);
+            Utils::UpdateCachedInfo(levelPath, [songDuration](Utils::CachedSongData& data){ data.songDuration = songDuration; });
             return songDuration;
         }
     }
 
     float LevelLoader::GetLengthForLevel(std::filesystem::path const& levelPath, CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData) {
+        TRACE_SCOPE("GetLengthForLevel");
         // check the cached info
         auto cachedInfoOpt = Utils::GetCachedInfo(levelPath);
         if (cachedInfoOpt.has_value() && cachedInfoOpt->songDuration.has_value()) {
@@ -686,26 +725,20 @@ namespace SongCore::SongLoader {
                 float songDuration = Utils::GetLengthFromOggVorbis(songFilePath);
                 if (songDuration >= 0 && !std::isnan(songDuration)) { // found duration was valid
                     // update cache with new duration
-                    auto info = cachedInfoOpt.value_or(Utils::CachedSongData());
-                    info.songDuration = songDuration;
-                    Utils::SetCachedInfo(levelPath, info);
+                    Utils::UpdateCachedInfo(levelPath, [songDuration](Utils::CachedSongData& data){ data.songDuration = songDuration; });
                     return songDuration;
                 }
                 songDuration = Utils::GetLengthFromWavRiff(songFilePath);
                 if (songDuration >= 0 && !std::isnan(songDuration)) { // found duration was valid
                     // update cache with new duration
-                    auto info = cachedInfoOpt.value_or(Utils::CachedSongData());
-                    info.songDuration = songDuration;
-                    Utils::SetCachedInfo(levelPath, info);
+                    Utils::UpdateCachedInfo(levelPath, [songDuration](Utils::CachedSongData& data){ data.songDuration = songDuration; });
                     return songDuration;
                 }
             }
 
             // if the file didn't exist or we didn't get a valid length from the ogg, we go and get it from the map
             float songDuration = GetLengthFromMap(levelPath, saveData);
-            auto info = cachedInfoOpt.value_or(Utils::CachedSongData());
-            info.songDuration = songDuration;
-            Utils::SetCachedInfo(levelPath, info);
+            Utils::UpdateCachedInfo(levelPath, [songDuration](Utils::CachedSongData& data){ data.songDuration = songDuration; });
             return songDuration;
         }
     }
@@ -0,0 +1,200 @@
+#include "SongLoader/LevelMetadata.hpp"
+#include "Utils/Cache.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace SongCore::SongLoader {
+    /// @brief bumped whenever the serialized layout changes, metadata of other versions is ignored and the level parsed again
+    static constexpr uint8_t METADATA_VERSION = 1;
+
+    class MetadataWriter {
+        public:
+            template<typename T> requires std::is_arithmetic_v<T>
+            void Write(T value) { _data.append(reinterpret_cast<char const*>(&value), sizeof(value)); }
+
+            void Write(std::string_view value) {
+                Write(static_cast<uint32_t>(value.size()));
+                _data.append(value);
+            }
+
+            void Write(std::vector<std::string> const& values) {
+                Write(static_cast<uint32_t>(values.size()));
+                for (auto const& value : values) Write(std::string_view(value));
+            }
+
+            std::string Finish() { return std::move(_data); }
+        private:
+            std::string _data;
+    };
+
+    /// @brief reads what MetadataWriter wrote, every read fails once anything was out of bounds
+    class MetadataReader {
+        public:
+            explicit MetadataReader(std::string_view data) : _data(data) {}
+
+            template<typename T> requires std::is_arithmetic_v<T>
+            bool Read(T& value) {
+                if (_data.size() < sizeof(value)) return Fail();
+                std::memcpy(&value, _data.data(), sizeof(value));
+                _data.remove_prefix(sizeof(value));
+                return true;
+            }
+
+            bool Read(std::string& value) {
+                uint32_t size;
+                if (!Read(size) || _data.size() < size) return Fail();
+                value.assign(_data.data(), size);
+                _data.remove_prefix(size);
+                return true;
+            }
+
+            bool Read(std::vector<std::string>& values) {
+                // every string takes at least its size, which bounds the count before anything is allocated
+                uint32_t count;
+                if (!ReadCount(count, sizeof(uint32_t))) return false;
+                values.resize(count);
+                for (auto& value : values) {
+                    if (!Read(value)) return false;
+                }
+                return true;
+            }
+
+            /// @brief reads the amount of elements of a list, each of which is at least minimumSize bytes
+            bool ReadCount(uint32_t& count, size_t minimumSize) {
+                if (Read(count) && count <= _data.size() / minimumSize) return true;
+                count = 0;
+                return Fail();
+            }
+
+            /// @brief whether everything was read without going out of bounds, and nothing is left
+            bool Succeeded() const { return !_failed && _data.empty(); }
+        private:
+            bool Fail() {
+                _failed = true;
+                _data = {};
+                return false;
+            }
+
+            std::string_view _data;
+            bool _failed = false;
+    };
+
+    std::string LevelMetadata::Serialize() const {
+        MetadataWriter writer;
+        writer.Write(METADATA_VERSION);
+        writer.Write(static_cast<uint8_t>(isV4));
+        writer.Write(songName);
+        writer.Write(songSubName);
+        writer.Write(songAuthorName);
+        writer.Write(levelAuthorName);
+        writer.Write(beatsPerMinute);
+        writer.Write(integratedLufs);
+        writer.Write(songTimeOffset);
+        writer.Write(previewStartTime);
+        writer.Write(previewDuration);
+        writer.Write(coverImageFilename);
+        writer.Write(songFilename);
+        writer.Write(audioDataFilename);
+        writer.Write(environmentName);
+        writer.Write(allDirectionsEnvironmentName);
+        writer.Write(environmentNames);
+
+        writer.Write(static_cast<uint32_t>(colorSchemes.size()));
+        for (auto const& colorScheme : colorSchemes) {
+            writer.Write(colorScheme.colorSchemeId);
+            writer.Write(colorScheme.localizationKey);
+            writer.Write(static_cast<uint8_t>(colorScheme.useNonLocalizedName));
+            writer.Write(colorScheme.nonLocalizedName);
+            for (auto const& color : colorScheme.colors) {
+                for (auto channel : color) writer.Write(channel);
+            }
+        }
+
+        writer.Write(static_cast<uint32_t>(difficulties.size()));
+        for (auto const& difficulty : difficulties) {
+            writer.Write(difficulty.characteristic);
+            writer.Write(difficulty.difficulty);
+            writer.Write(difficulty.beatmapFilename);
+            writer.Write(difficulty.lightshowFilename);
+            writer.Write(difficulty.noteJumpMovementSpeed);
+            writer.Write(difficulty.noteJumpStartBeatOffset);
+            writer.Write(static_cast<int32_t>(difficulty.environmentNameIdx));
+            writer.Write(static_cast<int32_t>(difficulty.beatmapColorSchemeIdx));
+            writer.Write(difficulty.mappers);
+            writer.Write(difficulty.lighters);
+        }
+
+        return writer.Finish();
+    }
+
+    std::optional<LevelMetadata> LevelMetadata::Deserialize(std::string_view data) {
+        MetadataReader reader(data);
+        LevelMetadata metadata;
+
+        uint8_t version = 0;
+        if (!reader.Read(version) || version != METADATA_VERSION) return std::nullopt;
+
+        uint8_t isV4 = 0;
+        reader.Read(isV4);
+        metadata.isV4 = isV4;
+        reader.Read(metadata.songName);
+        reader.Read(metadata.songSubName);
+        reader.Read(metadata.songAuthorName);
+        reader.Read(metadata.levelAuthorName);
+        reader.Read(metadata.beatsPerMinute);
+        reader.Read(metadata.integratedLufs);
+        reader.Read(metadata.songTimeOffset);
+        reader.Read(metadata.previewStartTime);
+        reader.Read(metadata.previewDuration);
+        reader.Read(metadata.coverImageFilename);
+        reader.Read(metadata.songFilename);
+        reader.Read(metadata.audioDataFilename);
+        reader.Read(metadata.environmentName);
+        reader.Read(metadata.allDirectionsEnvironmentName);
+        reader.Read(metadata.environmentNames);
+
+        uint32_t colorSchemeCount = 0;
+        reader.ReadCount(colorSchemeCount, sizeof(ColorScheme::colors));
+        metadata.colorSchemes.resize(colorSchemeCount);
+        for (auto& colorScheme : metadata.colorSchemes) {
+            reader.Read(colorScheme.colorSchemeId);
+            reader.Read(colorScheme.localizationKey);
+            uint8_t useNonLocalizedName = 0;
+            reader.Read(useNonLocalizedName);
+            colorScheme.useNonLocalizedName = useNonLocalizedName;
+            reader.Read(colorScheme.nonLocalizedName);
+            for (auto& color : colorScheme.colors) {
+                for (auto& channel : color) reader.Read(channel);
+            }
+        }
+
+        uint32_t difficultyCount = 0;
+        reader.ReadCount(difficultyCount, 4 * sizeof(uint32_t) + 4 * sizeof(float));
+        metadata.difficulties.resize(difficultyCount);
+        for (auto& difficulty : metadata.difficulties) {
+            reader.Read(difficulty.characteristic);
+            reader.Read(difficulty.difficulty);
+            reader.Read(difficulty.beatmapFilename);
+            reader.Read(difficulty.lightshowFilename);
+            reader.Read(difficulty.noteJumpMovementSpeed);
+            reader.Read(difficulty.noteJumpStartBeatOffset);
+            int32_t environmentNameIdx = 0, beatmapColorSchemeIdx = 0;
+            reader.Read(environmentNameIdx);
+            reader.Read(beatmapColorSchemeIdx);
+            difficulty.environmentNameIdx = environmentNameIdx;
+            difficulty.beatmapColorSchemeIdx = beatmapColorSchemeIdx;
+            reader.Read(difficulty.mappers);
+            reader.Read(difficulty.lighters);
+        }
+
+        if (!reader.Succeeded()) return std::nullopt;
+        return metadata;
+    }
+
+    std::optional<LevelMetadata> LevelMetadata::FromCachedInfo(Utils::CachedSongData const& cachedInfo) {
+        if (!cachedInfo.sha1.has_value() || !cachedInfo.songDuration.has_value() || !cachedInfo.levelMetadata.has_value()) return std::nullopt;
+        return Deserialize(*cachedInfo.levelMetadata);
+    }
+}
@@ -0,0 +1,272 @@
+#include "SongLoader/LibraryWatcher.hpp"
+#include "logging.hpp"
+
+#include "beatsaber-hook/shared/utils/il2cpp-utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+/// @brief events on the roots that mean a level folder appeared or disappeared
+#define ROOT_WATCH_MASK (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_ONLYDIR)
+/// @brief events inside a level or pack folder that mean its contents are still being written
+#define LEVEL_WATCH_MASK (IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ONLYDIR)
+
+namespace SongCore::SongLoader {
+    LibraryWatcher::LibraryWatcher(LevelChangedCallback levelChanged, RefreshNeededCallback refreshNeeded, std::chrono::milliseconds debounce) :
+        _levelChanged(std::move(levelChanged)),
+        _refreshNeeded(std::move(refreshNeeded)),
+        _debounce(debounce) {}
+
+    LibraryWatcher::~LibraryWatcher() {
+        if (_inotifyFd >= 0) close(_inotifyFd);
+        if (_stopFd >= 0) close(_stopFd);
+    }
+
+    bool LibraryWatcher::Start(std::span<const std::filesystem::path> roots, std::span<const std::filesystem::path> wipRoots) {
+        if (_running) return true;
+
+        _inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (_inotifyFd < 0) {
+            ERROR("Failed to initialize inotify for the library watcher: {}", strerror(errno));
+            return false;
+        }
+
+        _stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (_stopFd < 0) {
+            ERROR("Failed to create stop eventfd for the library watcher: {}", strerror(errno));
+            return false;
+        }
+
+        for (auto const& root : roots) AddWatch(root, false, WatchKind::Root);
+        for (auto const& root : wipRoots) AddWatch(root, true, WatchKind::Root);
+
+        if (_watches.empty()) {
+            WARNING("Library watcher could not watch any of the roots, not starting");
+            return false;
+        }
+
+        _running = true;
+        _stopRequested = false;
+        // the thread keeps us alive until it exits, so stopping never has to wait on a callback that might be waiting on main thread
+        il2cpp_utils::il2cpp_aware_thread([self = shared_from_this()](){ self->WatchThread(); }).detach();
+        INFO("Library watcher started on {} roots", _watches.size());
+        return true;
+    }
+
+    void LibraryWatcher::Stop() {
+        if (!_running || _stopRequested) return;
+        _stopRequested = true;
+
+        uint64_t value = 1;
+        write(_stopFd, &value, sizeof(value));
+    }
+
+    bool LibraryWatcher::AddWatch(std::filesystem::path const& path, bool isWip, WatchKind kind) {
+        // watching a folder again returns the same watch descriptor, so this also moves a watch to where its folder was renamed to
+        int wd = inotify_add_watch(_inotifyFd, path.c_str(), kind == WatchKind::Root ? ROOT_WATCH_MASK : LEVEL_WATCH_MASK);
+        if (wd < 0) {
+            WARNING("Failed to watch directory {}: {}", path.string(), strerror(errno));
+            return false;
+        }
+
+        _watches[wd] = { path, isWip, kind };
+        return true;
+    }
+
+    /// @brief whether a folder holds levels instead of being one, like the refresh decides when it descends into folders
+    static bool IsPack(std::span<Utils::DirectoryEntry const> entries) {
+        if (Utils::FindInfoDat(entries).has_value()) return false;
+        return std::any_of(entries.begin(), entries.end(), [](auto const& entry){ return entry.IsDirectory() && !Utils::IsPrunedDirectory(entry.name); });
+    }
+
+    void LibraryWatcher::WatchPack(std::filesystem::path const& path, bool isWip, std::span<Utils::DirectoryEntry const> entries, bool scheduleLevels) {
+        AddWatch(path, isWip, WatchKind::Pack);
+        _packs.emplace(path);
+        if (!scheduleLevels) {
+            WatchNestedPacks(path, isWip, entries);
+            return;
+        }
+
+        // levels in a pack that was moved in never got events of their own, and the ones still being written are watched so they keep delaying their report
+        for (auto const& entry : entries) {
+            if (!entry.IsDirectory() || Utils::IsPrunedDirectory(entry.name)) continue;
+            auto levelPath = path / entry.name;
+            AddWatch(levelPath, isWip, WatchKind::Level);
+            Schedule(levelPath, isWip);
+        }
+    }
+
+    void LibraryWatcher::WatchNestedPacks(std::filesystem::path const& path, bool isWip, std::span<Utils::DirectoryEntry const> entries) {
+        for (auto const& entry : entries) {
+            if (!entry.IsDirectory() || Utils::IsPrunedDirectory(entry.name)) continue;
+            auto childPath = path / entry.name;
+            std::vector<Utils::DirectoryEntry> childEntries;
+            if (Utils::ListDirectory(childPath, childEntries) && IsPack(childEntries)) WatchPack(childPath, isWip, childEntries, false);
+        }
+    }
+
+    void LibraryWatcher::WatchExistingPacks() {
+        std::vector<WatchedDirectory> roots;
+        for (auto const& [wd, watched] : _watches) {
+            if (watched.kind == WatchKind::Root) roots.emplace_back(watched);
+        }
+
+        for (auto const& root : roots) {
+            std::vector<Utils::DirectoryEntry> entries;
+            if (Utils::ListDirectory(root.path, entries)) WatchNestedPacks(root.path, root.isWip, entries);
+        }
+        if (!_packs.empty()) INFO("Library watcher watching {} pack folders", _packs.size());
+    }
+
+    void LibraryWatcher::Schedule(std::filesystem::path const& levelPath, bool isWip) {
+        _pendingLevels[levelPath] = { isWip, std::chrono::steady_clock::now() + _debounce };
+    }
+
+    void LibraryWatcher::ReadEvents() {
+        alignas(inotify_event) char buffer[16 * 1024];
+
+        while (true) {
+            auto readBytes = read(_inotifyFd, buffer, sizeof(buffer));
+            if (readBytes <= 0) {
+                if (readBytes < 0 && errno == EINTR) continue;
+                break;
+            }
+
+            for (ssize_t offset = 0; offset < readBytes;) {
+                auto event = reinterpret_cast<inotify_event*>(buffer + offset);
+                offset += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW) {
+                    WARNING("Library watcher event queue overflowed, a refresh is needed to catch up");
+                    if (_refreshNeeded) _refreshNeeded();
+                    continue;
+                }
+
+                auto itr = _watches.find(event->wd);
+                if (itr == _watches.end()) continue;
+
+                // the watch is gone, for example because the level folder was deleted
+                if (event->mask & IN_IGNORED) {
+                    _watches.erase(itr);
+                    continue;
+                }
+
+                auto watched = itr->second;
+                if (watched.kind == WatchKind::Level) {
+                    // something changed inside a level folder, push back when it's reported
+                    Schedule(watched.path, watched.isWip);
+                    continue;
+                }
+
+                // only folders can be levels, though a file appearing in a pack might be the info.dat that makes the pack a level
+                if (event->len == 0 || !(event->mask & IN_ISDIR)) {
+                    if (watched.kind == WatchKind::Pack) Schedule(watched.path, watched.isWip);
+                    continue;
+                }
+                if (Utils::IsPrunedDirectory(event->name)) continue;
+
+                auto levelPath = watched.path / event->name;
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    // watch the new folder so files still being written into it keep delaying the load, whether it turns out to be a level or a pack is decided once it settled
+                    AddWatch(levelPath, watched.isWip, WatchKind::Level);
+                }
+
+                Schedule(levelPath, watched.isWip);
+            }
+        }
+    }
+
+    void LibraryWatcher::ReportSettledLevels() {
+        auto now = std::chrono::steady_clock::now();
+        for (auto itr = _pendingLevels.begin(); itr != _pendingLevels.end();) {
+            if (_stopRequested) return;
+            if (itr->second.deadline > now) {
+                itr++;
+                continue;
+            }
+
+            auto levelPath = itr->first;
+            bool isWip = itr->second.isWip;
+            itr = _pendingLevels.erase(itr);
+
+            try {
+                ReportSettled(levelPath, isWip);
+            } catch (std::exception const& e) {
+                ERROR("Caught exception of type {} while handling library change @ path '{}', what: {}", typeid(e).name(), levelPath.string(), e.what());
+            }
+        }
+    }
+
+    void LibraryWatcher::ReportSettled(std::filesystem::path const& path, bool isWip) {
+        std::vector<Utils::DirectoryEntry> entries;
+        bool exists = Utils::ListDirectory(path, entries);
+
+        // levels in a pack that was already watched are reported on their own, a new pack reports all of its levels
+        if (exists && IsPack(entries)) {
+            bool isNewPack = !_packs.contains(path);
+            if (isNewPack) DEBUG("Library watcher found pack folder {}", path.string());
+            WatchPack(path, isWip, entries, isNewPack);
+            return;
+        }
+
+        // the packs nested in a folder sort right after it
+        auto isInside = [&path](std::filesystem::path const& pack){ return std::mismatch(path.begin(), path.end(), pack.begin(), pack.end()).first == path.end(); };
+        auto packsBegin = _packs.lower_bound(path);
+        auto packsEnd = packsBegin;
+        while (packsEnd != _packs.end() && isInside(*packsEnd)) packsEnd++;
+        bool wasPack = packsBegin != packsEnd;
+        _packs.erase(packsBegin, packsEnd);
+
+        // a pack that went away took its levels with it, which never got events of their own if it was moved
+        if (!exists && wasPack) {
+            INFO("Library watcher lost pack folder {}, a refresh is needed to remove its levels", path.string());
+            if (_refreshNeeded) _refreshNeeded();
+            return;
+        }
+
+        // a pack that got an info.dat is a level now
+        if (exists && wasPack) AddWatch(path, isWip, WatchKind::Level);
+
+        DEBUG("Library watcher reporting change for {}", path.string());
+        _levelChanged(path, isWip);
+    }
+
+    void LibraryWatcher::WatchThread() {
+        WatchExistingPacks();
+
+        std::array<pollfd, 2> fds = {{
+            { _inotifyFd, POLLIN, 0 },
+            { _stopFd, POLLIN, 0 }
+        }};
+
+        while (!_stopRequested) {
+            int timeout = -1;
+            if (!_pendingLevels.empty()) {
+                auto nextDeadline = std::min_element(_pendingLevels.begin(), _pendingLevels.end(), [](auto const& a, auto const& b){ return a.second.deadline < b.second.deadline; })->second.deadline;
+                auto untilDeadline = std::chrono::duration_cast<std::chrono::milliseconds>(nextDeadline - std::chrono::steady_clock::now()).count();
+                timeout = std::max<int>(0, untilDeadline + 1);
+            }
+
+            int result = poll(fds.data(), fds.size(), timeout);
+            if (result < 0) {
+                if (errno == EINTR) continue;
+                ERROR("Library watcher poll failed: {}", strerror(errno));
+                break;
+            }
+
+            if (fds[1].revents & POLLIN) break;
+            if (fds[0].revents & POLLIN) ReadEvents();
+
+            ReportSettledLevels();
+        }
+
+        _running = false;
+        INFO("Library watcher stopped");
+    }
+}
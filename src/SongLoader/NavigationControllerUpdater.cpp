@@ -26,6 +26,7 @@ namespace SongCore::SongLoader {
     void NavigationControllerUpdater::Initialize() {
         _runtimeSongLoader->SongsWillRefresh += {&NavigationControllerUpdater::SongsWillRefresh, this};
         _runtimeSongLoader->SongsLoaded += {&NavigationControllerUpdater::SongsLoaded, this};
+        _runtimeSongLoader->SongsBatchLoaded += {&NavigationControllerUpdater::SongsBatchLoaded, this};
         if (_runtimeSongLoader->AreSongsLoaded) {
             SongsLoaded(_runtimeSongLoader->AllLevels);
         }
@@ -34,9 +35,11 @@ namespace SongCore::SongLoader {
     void NavigationControllerUpdater::Dispose() {
         _runtimeSongLoader->SongsWillRefresh -= {&NavigationControllerUpdater::SongsWillRefresh, this};
         _runtimeSongLoader->SongsLoaded -= {&NavigationControllerUpdater::SongsLoaded, this};
+        _runtimeSongLoader->SongsBatchLoaded -= {&NavigationControllerUpdater::SongsBatchLoaded, this};
     }
 
     void NavigationControllerUpdater::SongsWillRefresh() {
+        _showedBatches = false;
         _levelFilteringNavigationController->_customLevelPacks = nullptr;
         _levelFilteringNavigationController->_annotatedBeatmapLevelCollectionsViewController->ShowLoading();
         _levelCollectionNavigationController->ShowLoading();
@@ -45,6 +48,18 @@ namespace SongCore::SongLoader {
     }
 
     void NavigationControllerUpdater::SongsLoaded(std::span<SongLoader::CustomBeatmapLevel* const> levels) {
+        // the reload started when refreshing began already finished with the first batch, so the final levels need another one
+        ReselectAfterReload(_showedBatches);
+        _showedBatches = false;
+    }
+
+    void NavigationControllerUpdater::SongsBatchLoaded(std::span<SongLoader::CustomBeatmapLevel* const> levels) {
+        // the first batch finishes the reload started when refreshing began, later ones have to reload themselves
+        ReselectAfterReload(_showedBatches);
+        _showedBatches = true;
+    }
+
+    void NavigationControllerUpdater::ReselectAfterReload(bool reload) {
         auto levelCollectionTableView = _levelCollectionViewController->_levelCollectionTableView;
         auto level = levelCollectionTableView ? levelCollectionTableView->_selectedBeatmapLevel : nullptr;
         auto levelId = level ? level->levelID : "";
@@ -67,6 +82,11 @@ namespace SongCore::SongLoader {
             }
         }
 
+        if (reload) {
+            _levelFilteringNavigationController->_customLevelPacks = nullptr;
+            _levelFilteringNavigationController->UpdateCustomSongs();
+        }
+
         // thanks metalit for pointing out updatecustomsongs still starts an async thing, doing things this way lets us await the reload to be complete
         BSML::MainThreadScheduler::ScheduleUntil(
             [nav = this->_levelFilteringNavigationController](){
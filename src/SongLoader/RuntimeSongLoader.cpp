@@ -2,10 +2,12 @@
 #include "SongLoader/CustomBeatmapLevel.hpp"
 #include "SongLoader/CustomBeatmapLevelsRepository.hpp"
 #include "SongLoader/CustomLevelPack.hpp"
+#include "SongLoader/LibraryWatcher.hpp"
 #include "CustomJSONData.hpp"
 #include "SongCore.hpp"
 
 #include "logging.hpp"
+#include "tracing.hpp"
 #include "config.hpp"
 #include "assets.hpp"
 
@@ -16,6 +18,13 @@
 #include "Utils/Hashing.hpp"
 #include "Utils/File.hpp"
 #include "Utils/Cache.hpp"
+#include "Utils/DirectoryManifest.hpp"
+#include "Utils/WorkStealing.hpp"
+#include "Utils/AdaptiveConcurrency.hpp"
+#include "Utils/BoundedQueue.hpp"
+#include "Utils/Directory.hpp"
+#include "Utils/ThreadPool.hpp"
+#include "Utils/HashingService.hpp"
 
 #include "System/Collections/Generic/ICollection_1.hpp"
 #include "System/Collections/Generic/IEnumerable_1.hpp"
@@ -23,17 +32,57 @@
 #include "System/Collections/IEnumerator.hpp"
 #include "System/IDisposable.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <thread>
+#include <unordered_set>
+
 #include "Utils/SaveDataVersion.hpp"
 
 DEFINE_TYPE(SongCore::SongLoader, RuntimeSongLoader);
 
-#define MAX_THREAD_COUNT 8
+/// @brief how often the concurrency controller reevaluates the amount of active workers
+#define CONCURRENCY_SAMPLE_INTERVAL std::chrono::milliseconds(250)
+/// @brief maximum amount of levels waiting between two stages of the refresh pipeline
+#define PIPELINE_QUEUE_CAPACITY 64
+/// @brief minimum time between two published batches with progressive loading, every batch reallocates the packs so this bounds how much time goes into that
+#define PROGRESSIVE_PUBLISH_INTERVAL std::chrono::milliseconds(1000)
+/// @brief how often a refresh checkpoints the song info cache, so an interrupted cold refresh resumes with the hashes it already calculated
+#define CACHE_CHECKPOINT_INTERVAL std::chrono::milliseconds(5000)
+/// @brief amount of slowest levels kept in the timing report of a refresh
+#define SLOWEST_LEVELS_REPORTED 10
+/// @brief amount of levels whose savedata is parsed in the background before it's handed to them on the main thread at once
+#define SAVE_DATA_BATCH_SIZE 64
 
 using namespace std::chrono;
 
 namespace SongCore::SongLoader {
     RuntimeSongLoader* RuntimeSongLoader::_instance = nullptr;
 
+    /// @brief thread the loader was initialized on, which is the game's main thread
+    static std::thread::id _mainThreadId;
+
+    /// @brief runs the function on the main thread and waits for it, exceptions are rethrown on the calling thread.
+    /// The collections and packs are read by the game on the main thread, so that is the only place they're changed
+    static void RunOnMainThread(std::function<void()> const& function) {
+        if (std::this_thread::get_id() == _mainThreadId) {
+            function();
+            return;
+        }
+
+        std::promise<void> done;
+        BSML::MainThreadScheduler::Schedule([&function, &done](){
+            try {
+                function();
+                done.set_value();
+            } catch (...) {
+                done.set_exception(std::current_exception());
+            }
+        });
+        done.get_future().get();
+    }
+
     std::string lowerString(std::string_view str) {
         std::string result;
         result.resize(str.size());
@@ -41,6 +90,27 @@ namespace SongCore::SongLoader {
         return result;
     }
 
+    /// @brief gets the values from a songdict into a vector
+    static std::vector<CustomBeatmapLevel*> GetValues(SongDict* dict) {
+        std::vector<CustomBeatmapLevel*> vec;
+        vec.reserve(dict->Count);
+
+        auto enumerator = dict->GetEnumerator();
+        while(enumerator->i___System__Collections__IEnumerator()->MoveNext()) {
+            vec.emplace_back(enumerator->Current.Value);
+        }
+        enumerator->i___System__IDisposable()->Dispose();
+
+        return vec;
+    }
+
+    /// @brief gets the values from a songdict sorted like CustomLevelPack::SortLevels sorts them, so the pack can take them as they are
+    static std::vector<CustomBeatmapLevel*> GetSortedValues(SongDict* dict) {
+        auto vec = GetValues(dict);
+        std::stable_sort(vec.begin(), vec.end(), [](auto a, auto b){ return static_cast<std::u16string_view>(a->songName) < static_cast<std::u16string_view>(b->songName); });
+        return vec;
+    }
+
     void RuntimeSongLoader::ctor(GlobalNamespace::CustomLevelLoader* customLevelLoader, GlobalNamespace::BeatmapLevelsModel* beatmapLevelsModel, LevelLoader* levelLoader) {
         INVOKE_CTOR();
 
@@ -65,56 +135,216 @@ namespace SongCore::SongLoader {
         DEBUG("RuntimeSongLoader Initialize");
         if (_instance) { return; }
         _instance = this;
+        _mainThreadId = std::this_thread::get_id();
 
         RefreshSongs(true);
+
+        if (config.enableLibraryWatcher) {
+            _libraryWatcher = std::make_shared<LibraryWatcher>(
+                [this](std::filesystem::path const& levelPath, bool isWip){ RefreshLevel(levelPath, isWip); },
+                [this](){ RefreshSongs(false); }
+            );
+            if (!_libraryWatcher->Start(config.RootCustomLevelPaths, config.RootCustomWIPLevelPaths)) _libraryWatcher.reset();
+        }
     }
 
     void RuntimeSongLoader::Dispose() {
         if (_instance == this) _instance = nullptr;
 
+        if (_libraryWatcher) {
+            _libraryWatcher->Stop();
+            _libraryWatcher.reset();
+        }
+
         _customLevels->Clear();
         _customWIPLevels->Clear();
     }
 
-    void RuntimeSongLoader::CollectLevels(std::filesystem::path const& root, bool isWip, std::set<LevelPathAndWip>& out) {
-        // recursively find folders in this root folder to load songs from
-        std::error_code error_code;
-        auto iterator = std::filesystem::recursive_directory_iterator(root, error_code);
-        if (error_code) {
-            WARNING("Failed to get iterator for directory {}: {}", root.string(), error_code.message());
-            return;
-        }
+    void RuntimeSongLoader::CollectLevels(std::filesystem::path const& root, bool isWip, bool relistAll, std::vector<LevelPathAndWip>& out, std::set<std::filesystem::path>& changedOut) {
+        // recursively find level folders in this root folder, only listing folders that changed since the last refresh
+        std::vector<std::filesystem::path> levelFolders;
+        std::vector<std::filesystem::path> changedLevelFolders;
+        Utils::CollectLevelFoldersIncremental(root, relistAll, levelFolders, changedLevelFolders);
 
-        for (auto entry : iterator) {
-            if (!entry.is_directory()) continue;
-            auto songPath = entry.path();
-            // if this is an autosaves dir, just skip silently
-            if (songPath.string().ends_with("autosaves")) continue;
-
-            auto dataPath = songPath / "info.dat";
-            if (!std::filesystem::exists(dataPath)) {
-                dataPath = songPath / "Info.dat";
-                if (!std::filesystem::exists(dataPath)) {
-                    WARNING("Possible song folder '{}' had no info.dat file! skipping...", songPath.string());
-                    continue;
-                }
-            }
+        for (auto& songPath : levelFolders) {
+            out.emplace_back(std::move(songPath), isWip);
+        }
 
-            out.emplace(songPath, isWip);
+        for (auto& songPath : changedLevelFolders) {
+            changedOut.emplace(std::move(songPath));
         }
     }
 
-    void RuntimeSongLoader::CollectLevels(std::span<const std::filesystem::path> roots, bool isWip, std::set<LevelPathAndWip>& out) {
+    void RuntimeSongLoader::CollectLevels(std::span<const std::filesystem::path> roots, bool isWip, bool relistAll, std::vector<LevelPathAndWip>& out, std::set<std::filesystem::path>& changedOut) {
         for (auto& rootPath : roots) {
             if (!std::filesystem::exists(rootPath)) {
                 WARNING("Attempted to load songs from folder '{}' but it did not exist! skipping...", rootPath.string());
                 continue;
             }
 
-            CollectLevels(rootPath, isWip, out);
+            CollectLevels(rootPath, isWip, relistAll, out, changedOut);
         }
     }
 
+    void RuntimeSongLoader::RemoveStaleLevels(std::span<LevelPathAndWip const> levels, std::set<std::filesystem::path> const& changedLevels) {
+        for (auto dict : { _customLevels, _customWIPLevels }) {
+            std::vector<StringW> staleKeys;
+
+            auto enumerator = dict->GetEnumerator();
+            while(enumerator->i___System__Collections__IEnumerator()->MoveNext()) {
+                std::filesystem::path levelPath(static_cast<std::string>(enumerator->Current.Key));
+                // removed folders disappear, modified ones get loaded again
+                if (!std::binary_search(levels.begin(), levels.end(), LevelPathAndWip{levelPath, false}) || changedLevels.contains(levelPath)) {
+                    staleKeys.emplace_back(enumerator->Current.Key);
+                }
+            }
+            enumerator->i___System__IDisposable()->Dispose();
+
+            for (auto key : staleKeys) {
+                DEBUG("Level at {} was removed or modified since the last refresh", key);
+                dict->System_Collections_Generic_IDictionary_TKey_TValue__Remove(key);
+            }
+        }
+    }
+
+    /// @brief counters for a single stage of the refresh pipeline
+    struct PipelineStageStats {
+        std::atomic<size_t> processed = 0;
+        std::atomic<int64_t> busyNanoseconds = 0;
+        /// @brief time from the start of loading until the last thread of the stage exited
+        nanoseconds elapsed{0};
+
+        void AddBusyTime(high_resolution_clock::time_point startTime) {
+            busyNanoseconds += duration_cast<nanoseconds>(high_resolution_clock::now() - startTime).count();
+            processed++;
+        }
+    };
+
+    /// @brief state shared by the threads of the refresh pipeline: levels are read by the read stage, parsed & hashed by the parse stage, and turned into game objects by the construct stage
+    struct RuntimeSongLoader::RefreshPipeline {
+        RefreshPipeline(std::span<LevelPathAndWip const> levels, size_t readThreadCount, size_t initialReadThreadCount) :
+            levels(levels),
+            readRanges(levels.size(), readThreadCount),
+            readConcurrency(readThreadCount, initialReadThreadCount),
+            readQueue(PIPELINE_QUEUE_CAPACITY),
+            preparedQueue(PIPELINE_QUEUE_CAPACITY) {}
+
+        std::span<LevelPathAndWip const> levels;
+        Utils::WorkStealingRanges readRanges;
+        Utils::AdaptiveConcurrency readConcurrency;
+        Utils::BoundedQueue<ReadLevel> readQueue;
+        Utils::BoundedQueue<PreparedLevel> preparedQueue;
+
+        PipelineStageStats readStats;
+        PipelineStageStats parseStats;
+        /// @brief only counts levels that went through the hashing service
+        PipelineStageStats hashStats;
+        PipelineStageStats constructStats;
+
+        /// @brief levels the parse stage handed to the hashing service, which push to the prepared queue themselves
+        std::mutex hashMutex;
+        std::vector<std::future<void>> hashFutures;
+
+        /// @brief levels added by the construct stage that weren't published yet, only filled with progressive loading
+        std::mutex batchMutex;
+        std::vector<CustomBeatmapLevel*> batchLevels;
+        std::vector<CustomBeatmapLevel*> batchWIPLevels;
+        /// @brief whether the packs were rebuilt for this refresh, after which batches are only appended to them
+        bool packsPublished = false;
+
+        /// @brief timings of the levels that left the pipeline, slowestLevels is kept as a min heap on total time until the refresh is done
+        std::mutex timingMutex;
+        RefreshTimingReport timings;
+
+        static bool IsFaster(LevelLoadTiming const& a, LevelLoadTiming const& b) { return a.Total > b.Total; }
+
+        /// @brief records the timing of a level that was loaded or failed to load
+        void RecordTiming(LevelLoadTiming timing) {
+            std::lock_guard<std::mutex> lock(timingMutex);
+            for (size_t i = 0; i < LOAD_STAGE_COUNT; i++) timings.stages[i].Add(timing.stages[i]);
+            timings.total.Add(timing.Total);
+
+            auto& slowest = timings.slowestLevels;
+            if (slowest.size() < SLOWEST_LEVELS_REPORTED) {
+                slowest.emplace_back(std::move(timing));
+                std::push_heap(slowest.begin(), slowest.end(), IsFaster);
+            } else if (timing.Total > slowest.front().Total) {
+                std::pop_heap(slowest.begin(), slowest.end(), IsFaster);
+                slowest.back() = std::move(timing);
+                std::push_heap(slowest.begin(), slowest.end(), IsFaster);
+            }
+        }
+
+        /// @brief turns the heap into a list sorted slowest first, and gives up the report
+        RefreshTimingReport TakeTimings() {
+            std::lock_guard<std::mutex> lock(timingMutex);
+            std::sort_heap(timings.slowestLevels.begin(), timings.slowestLevels.end(), IsFaster);
+            return std::move(timings);
+        }
+    };
+
+    static float ToMilliseconds(nanoseconds time) {
+        return duration_cast<duration<float, std::milli>>(time).count();
+    }
+
+    static void LogTimingReport(RefreshTimingReport const& report) {
+        auto const& total = report.total;
+        if (total.Count == 0) return;
+
+        INFO(
+            "Level load times over {} levels: p50 {:.2f}ms, p90 {:.2f}ms, p99 {:.2f}ms, max {:.2f}ms",
+            total.Count, ToMilliseconds(total.Percentile(0.5f)), ToMilliseconds(total.Percentile(0.9f)), ToMilliseconds(total.Percentile(0.99f)), ToMilliseconds(total.MaxTime)
+        );
+        for (size_t i = 0; i < LOAD_STAGE_COUNT; i++) {
+            auto const& stage = report.stages[i];
+            INFO(
+                "  {}: {:.0f}ms total ({:.0f}%), p50 {:.2f}ms, p90 {:.2f}ms, max {:.2f}ms",
+                LoadStageName(static_cast<LoadStage>(i)), ToMilliseconds(stage.TotalTime), 100.0f * stage.TotalTime.count() / std::max<int64_t>(total.TotalTime.count(), 1),
+                ToMilliseconds(stage.Percentile(0.5f)), ToMilliseconds(stage.Percentile(0.9f)), ToMilliseconds(stage.MaxTime)
+            );
+        }
+
+        auto buckets = total.Buckets;
+        for (size_t i = 0; i < buckets.size(); i++) {
+            if (buckets[i] == 0) continue;
+            if (i == buckets.size() - 1) DEBUG("  >= {:.2f}ms: {} levels", ToMilliseconds(LoadTimeHistogram::BucketUpperBound(i - 1)), buckets[i]);
+            else DEBUG("  < {:.2f}ms: {} levels", ToMilliseconds(LoadTimeHistogram::BucketUpperBound(i)), buckets[i]);
+        }
+
+        INFO("Slowest levels:");
+        for (size_t i = 0; i < report.slowestLevels.size(); i++) {
+            auto const& level = report.slowestLevels[i];
+            auto levelTotal = level.Total;
+            auto dominant = level.DominantStage;
+            auto dominantTime = level.stages[static_cast<size_t>(dominant)];
+            INFO(
+                "  {}. {:.2f}ms, {:.0f}% {}: {}",
+                i + 1, ToMilliseconds(levelTotal), 100.0f * dominantTime.count() / std::max<int64_t>(levelTotal.count(), 1), LoadStageName(dominant), level.levelPath.string()
+            );
+        }
+    }
+
+    static void LogPipelineStage(std::string_view name, size_t threadCount, PipelineStageStats const& stats) {
+        auto seconds = duration_cast<duration<float>>(stats.elapsed).count();
+        auto busyMs = stats.busyNanoseconds / 1'000'000.0f;
+        INFO(
+            "Pipeline {} stage: {} levels on {} threads in {}ms ({:.1f} songs/s), {:.2f}ms busy per level",
+            name, stats.processed.load(), threadCount, duration_cast<milliseconds>(stats.elapsed).count(),
+            seconds > 0 ? stats.processed / seconds : 0.0f,
+            stats.processed > 0 ? busyMs / stats.processed : 0.0f
+        );
+    }
+
+    template<typename T>
+    static void LogPipelineQueue(std::string_view name, Utils::BoundedQueue<T>& queue) {
+        auto stats = queue.GetStats();
+        INFO(
+            "Pipeline {} queue: peak depth {}/{}, average depth {:.1f}, producers waited {}ms, consumers waited {}ms",
+            name, stats.peakDepth, queue.Capacity, stats.averageDepth,
+            duration_cast<milliseconds>(stats.producerWait).count(), duration_cast<milliseconds>(stats.consumerWait).count()
+        );
+    }
+
     std::shared_future<void> RuntimeSongLoader::RefreshSongs(bool fullRefresh) {
         if (AreSongsRefreshing) {
             INFO("Refresh was requested while songs were refreshing, queueing up a new refresh for afterwards, or returning the already queued up refresh");
@@ -123,7 +353,7 @@ namespace SongCore::SongLoader {
                 std::unique_lock<std::shared_mutex> writingLock(_doubleRefreshMutex);
                 // if it wasn't marked as a full refresh, mark it as such
                 _doubleRefreshIsFull = fullRefresh;
-                _doubleRefreshRequestedFuture = il2cpp_utils::il2cpp_async(std::launch::async, &RuntimeSongLoader::RefreshRequestedWhileRefreshing, this);
+                _doubleRefreshRequestedFuture = Utils::GetThreadPool().Submit(Utils::TaskPriority::Normal, [this](){ RefreshRequestedWhileRefreshing(); });
             } else {
                 // if the double refresh isn't full, update it
                 if (!_doubleRefreshIsFull) {
@@ -132,12 +362,31 @@ namespace SongCore::SongLoader {
                 }
             }
 
+            // a full refresh makes everything the current refresh would still do stale, so stop it at the next level and let the queued one pick up from there
+            if (fullRefresh && !_cancelRefreshRequested.exchange(true)) {
+                INFO("Full refresh supersedes the current refresh, cancelling it");
+            }
+
             std::shared_lock<std::shared_mutex> readingLock(_doubleRefreshMutex);
             return _doubleRefreshRequestedFuture;
         }
 
         std::unique_lock<std::shared_mutex> writingLock(_currentRefreshMutex);
-        _currentlyLoadingFuture = il2cpp_utils::il2cpp_async(std::launch::async, &RuntimeSongLoader::RefreshSongs_internal, this, std::forward<bool>(fullRefresh));
+        return StartRefresh(fullRefresh);
+    }
+
+    std::shared_future<void> RuntimeSongLoader::StartRefresh(bool fullRefresh) {
+        // reset here instead of in the refresh itself, so a cancel requested before the refresh got a thread isn't lost
+        _cancelRefreshRequested = false;
+        // same for the published levels, anything waiting on the refresh shouldn't get the last one's repository before this one got a thread
+        _areLevelsPublished = false;
+        // a level update from the library watcher might have been queued since refreshing was checked, it finishes first
+        auto previousFuture = _currentlyLoadingFuture;
+        _currentlyLoadingFuture = Utils::GetThreadPool().Submit(Utils::TaskPriority::Normal, [this, fullRefresh, previousFuture](){
+            if (previousFuture.valid()) previousFuture.wait();
+            RefreshSongs_internal(fullRefresh);
+            TRACE_FLUSH("refresh");
+        });
         return _currentlyLoadingFuture;
     }
 
@@ -149,14 +398,13 @@ namespace SongCore::SongLoader {
 
         currentRefreshFuture.wait();
 
-        // queue up another refresh
-        currentRefreshFuture = RefreshSongs(_doubleRefreshIsFull);
-
-        // overwrite current loading future with this double request future since we want to
-        // then allow a refresh requested during *this* one to be allowed to overwrite the double refresh
+        // queue up another refresh, and overwrite current loading future with this double request future since we want to
+        // then allow a refresh requested during *this* one to be allowed to overwrite the double refresh.
+        // both happen under the lock, so a level update queued in between can't end up waiting on us or be skipped
         {
             std::unique_lock<std::shared_mutex> currentRefreshWriteLock(_currentRefreshMutex);
             std::unique_lock<std::shared_mutex> doubleRefreshWriteLock(_doubleRefreshMutex);
+            currentRefreshFuture = StartRefresh(_doubleRefreshIsFull);
             _currentlyLoadingFuture = std::move(_doubleRefreshRequestedFuture);
         }
 
@@ -165,52 +413,132 @@ namespace SongCore::SongLoader {
     }
 
     void RuntimeSongLoader::RefreshSongs_internal(bool fullRefresh) {
+        TRACE_SCOPE("RefreshSongs_internal");
         // AreRefreshing is already false here, but areLoaded may be true depending on whether this is a new reload or not
         InvokeSongsWillRefresh();
 
         auto refreshStartTime = high_resolution_clock::now();
-        std::set<LevelPathAndWip> levels;
+        std::vector<LevelPathAndWip> levels;
+        std::set<std::filesystem::path> changedLevels;
         _areSongsLoaded = false;
         _loadedSongs = 0;
 
-        // travel the given song paths to collect levels to load
-        CollectLevels(config.RootCustomLevelPaths, false, levels);
-        CollectLevels(config.RootCustomWIPLevelPaths, true, levels);
+        // a cancelled full refresh already listed everything and cleared the dictionaries, so only what changed since then has to be redone
+        bool resumingFullRefresh = fullRefresh && _resumeCancelledFullRefresh;
+        if (resumingFullRefresh) INFO("Resuming the cancelled full refresh, keeping the {} levels it already loaded", _customLevels->Count + _customWIPLevels->Count);
+        bool relistAll = fullRefresh && !resumingFullRefresh;
+        std::set<std::filesystem::path> cancelledRefreshLevels;
+        cancelledRefreshLevels.swap(_cancelledRefreshLevels);
 
-        if (fullRefresh) {
-            CustomLevels->Clear();
-            CustomWIPLevels->Clear();
+        // libraries that were copied in with a cache prebuilt on another machine get their hashes from it
+        {
+            std::vector<std::filesystem::path> roots(config.RootCustomLevelPaths);
+            roots.insert(roots.end(), config.RootCustomWIPLevelPaths.begin(), config.RootCustomWIPLevelPaths.end());
+            Utils::LoadPrebuiltSongCaches(roots);
+        }
+
+        // travel the given song paths to collect levels to load, a full refresh lists every folder again
+        {
+            TRACE_SCOPE("CollectLevels");
+            CollectLevels(config.RootCustomLevelPaths, false, relistAll, levels, changedLevels);
+            CollectLevels(config.RootCustomWIPLevelPaths, true, relistAll, levels, changedLevels);
+            Utils::PruneDirectoryManifest();
         }
 
-        // load songs on multiple threads
-        std::mutex levelsItrMutex;
-        std::set<LevelPathAndWip>::const_iterator levelsItr = levels.begin();
-        std::set<LevelPathAndWip>::const_iterator levelsEnd = levels.end();
+        // sorted so neighbouring work items share directories, and deduplicated on path with the first (non wip) occurrence winning
+        std::stable_sort(levels.begin(), levels.end());
+        levels.erase(std::unique(levels.begin(), levels.end(), [](auto const& a, auto const& b){ return a.levelPath == b.levelPath; }), levels.end());
+        INFO("Collected {} levels, {} of which changed since the last refresh, in {}ms", levels.size(), changedLevels.size(), duration_cast<milliseconds>(high_resolution_clock::now() - refreshStartTime).count());
+
+        if (relistAll) {
+            if (cancelledRefreshLevels.empty()) {
+                CustomLevels->Clear();
+                CustomWIPLevels->Clear();
+            } else {
+                // the levels the cancelled soft refresh loaded are as fresh as anything this refresh would load, everything else is loaded again
+                for (auto const& levelPath : cancelledRefreshLevels) changedLevels.erase(levelPath);
+                RemoveStaleLevels(levels, changedLevels);
+                INFO("Keeping the {} levels the cancelled refresh loaded", _customLevels->Count + _customWIPLevels->Count);
+            }
+            // everything loaded from here on is as good as a full refresh, even if it gets cancelled
+            _resumeCancelledFullRefresh = true;
+            // a full refresh is where users end up when something looks off, so levels whose content is fingerprinted get sampled again
+            Utils::RevalidateCachedContent();
+        } else {
+            RemoveStaleLevels(levels, changedLevels);
+        }
 
-        using namespace std::chrono;
+        // load songs through the pipeline, so reading from storage overlaps with parsing and constructing other levels
         auto loadStartTime = high_resolution_clock::now();
 
-        auto workerThreadCount = std::clamp<size_t>(levels.size(), 1, MAX_THREAD_COUNT);
-        std::vector<std::future<void>> songLoadFutures;
-        songLoadFutures.reserve(workerThreadCount);
+        // reading starts out at the core count, and is allowed to grow to twice that for storage that benefits from more requests in flight.
+        // consumers get at most half the pool, so there is always room left for readers to feed them
+        auto& threadPool = Utils::GetThreadPool();
+        size_t hardwareConcurrency = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        size_t consumerBudget = std::max<size_t>(threadPool.MaxWorkers / 4, 1);
+        auto readThreadCount = std::clamp<size_t>(levels.size(), 1, std::min(hardwareConcurrency * 2, threadPool.MaxWorkers / 2));
+        auto parseThreadCount = std::clamp<size_t>(levels.size(), 1, std::min(hardwareConcurrency, consumerBudget));
+        auto constructThreadCount = std::clamp<size_t>(levels.size(), 1, std::min(std::max<size_t>(hardwareConcurrency / 2, 1), consumerBudget));
+        RefreshPipeline pipeline(levels, readThreadCount, hardwareConcurrency);
         _totalSongs = levels.size();
 
-        INFO("Now going to load {} levels on {} threads", (int)_totalSongs, workerThreadCount);
-        for (int i = 0; i < workerThreadCount; i++) {
-            songLoadFutures.emplace_back(
-                il2cpp_utils::il2cpp_async(
-                    &RuntimeSongLoader::RefreshSongWorkerThread,
-                    this,
-                    &levelsItrMutex,
-                    &levelsItr,
-                    &levelsEnd
-                )
-            );
+        auto& hashingService = Utils::GetHashingService();
+        INFO(
+            "Now going to load {} levels with up to {} read threads ({} active at first), {} parse threads, {} hash threads and {} construct threads",
+            (int)_totalSongs, readThreadCount, pipeline.readConcurrency.TargetWorkers, parseThreadCount, hashingService.MaxWorkers, constructThreadCount
+        );
+
+        std::vector<std::future<void>> readFutures;
+        std::vector<std::future<void>> parseFutures;
+        std::vector<std::future<void>> constructFutures;
+        // consumers are submitted first, so if the pool is at its limit it's readers that queue up, not the stages they'd block on
+        for (size_t i = 0; i < constructThreadCount; i++) {
+            constructFutures.emplace_back(threadPool.Submit(Utils::TaskPriority::Normal, [this, &pipeline](){ RefreshConstructWorkerThread(&pipeline); }));
         }
-
-        for (auto& t : songLoadFutures) {
-            t.wait();
+        for (size_t i = 0; i < parseThreadCount; i++) {
+            parseFutures.emplace_back(threadPool.Submit(Utils::TaskPriority::Normal, [this, &pipeline](){ RefreshParseWorkerThread(&pipeline); }));
         }
+        for (size_t i = 0; i < readThreadCount; i++) {
+            readFutures.emplace_back(threadPool.Submit(Utils::TaskPriority::Normal, [this, &pipeline, i](){ RefreshReadWorkerThread(&pipeline, i); }));
+        }
+
+        // the refresh thread only waits, so it might as well steer the read thread count and publish batches meanwhile.
+        // the first batch goes out as soon as there is anything to show, later ones at most once per interval
+        auto lastPublishTime = loadStartTime - PROGRESSIVE_PUBLISH_INTERVAL;
+        auto lastCheckpointTime = loadStartTime;
+        auto waitForStage = [&](std::vector<std::future<void>>& futures, bool sampleReaders) {
+            for (auto& t : futures) {
+                while (t.wait_for(CONCURRENCY_SAMPLE_INTERVAL) == std::future_status::timeout) {
+                    if (sampleReaders) pipeline.readConcurrency.Sample();
+
+                    auto now = high_resolution_clock::now();
+                    if (config.progressiveLoading && !_cancelRefreshRequested && now - lastPublishTime >= PROGRESSIVE_PUBLISH_INTERVAL && PublishLevelBatch(&pipeline)) {
+                        lastPublishTime = now;
+                    }
+                    // only appends what changed since the last checkpoint, so a refresh that gets cut short keeps what it calculated
+                    if (now - lastCheckpointTime >= CACHE_CHECKPOINT_INTERVAL) {
+                        TRACE_SCOPE("CheckpointCache");
+                        Utils::SaveSongInfoCache();
+                        lastCheckpointTime = now;
+                    }
+                }
+            }
+        };
+
+        waitForStage(readFutures, true);
+        pipeline.readStats.elapsed = high_resolution_clock::now() - loadStartTime;
+        pipeline.readQueue.Close();
+
+        waitForStage(parseFutures, false);
+        pipeline.parseStats.elapsed = high_resolution_clock::now() - loadStartTime;
+
+        // the parse stage is done handing out levels, but the ones it gave to the hashing service still have to reach the construct stage
+        waitForStage(pipeline.hashFutures, false);
+        pipeline.hashStats.elapsed = high_resolution_clock::now() - loadStartTime;
+        pipeline.preparedQueue.Close();
+
+        waitForStage(constructFutures, false);
+        pipeline.constructStats.elapsed = high_resolution_clock::now() - loadStartTime;
 
         size_t actualCount = _customLevels->Count + _customWIPLevels->Count;
         auto time = high_resolution_clock::now() - loadStartTime;
@@ -220,38 +548,81 @@ namespace SongCore::SongLoader {
             auto µs = (float)duration_cast<nanoseconds>(time).count() / 1000.0f;
             INFO("Loaded {} (actual: {}) songs in {}us", levels.size(), actualCount, µs);
         }
+        LogPipelineStage("read", readThreadCount, pipeline.readStats);
+        LogPipelineQueue("read -> parse", pipeline.readQueue);
+        LogPipelineStage("parse", parseThreadCount, pipeline.parseStats);
+        LogPipelineStage("hash", hashingService.MaxWorkers, pipeline.hashStats);
+        LogPipelineQueue("parse -> construct", pipeline.preparedQueue);
+        LogPipelineStage("construct", constructThreadCount, pipeline.constructStats);
+        INFO("Thread pool: {} threads alive ({} at peak, limit {}), {} active, {} queued", threadPool.WorkerCount, threadPool.PeakWorkerCount, threadPool.MaxWorkers, threadPool.ActiveWorkers, threadPool.QueueLength);
+        if (pipeline.readConcurrency.BestWorkers > 0) {
+            INFO("Best read throughput was {:.1f} songs/s with {} threads, ended at {} threads", pipeline.readConcurrency.BestThroughput, pipeline.readConcurrency.BestWorkers, pipeline.readConcurrency.TargetWorkers);
+        }
 
-        // save cache to file after all songs are loaded
-        Utils::SaveSongInfoCache();
+        {
+            auto timings = pipeline.TakeTimings();
+            LogTimingReport(timings);
+            std::lock_guard<std::mutex> lock(_lastRefreshTimingsMutex);
+            _lastRefreshTimings = std::move(timings);
+        }
 
-        // anonymous function to get the values from a songdict into a vector
-        static auto GetValues = [](SongDict* dict){
-            std::vector<CustomBeatmapLevel*> vec;
-            vec.reserve(dict->Count);
+        // the superseding refresh saves and publishes everything, including what was loaded here
+        if (_cancelRefreshRequested) {
+            INFO("Refresh cancelled after {}ms, {} levels were loaded and are kept for the next refresh", duration_cast<milliseconds>(high_resolution_clock::now() - refreshStartTime).count(), actualCount);
+            // a cancelled full refresh is resumed instead, everything it kept is already fresh
+            if (!fullRefresh) _cancelledRefreshLevels = std::move(changedLevels);
+            return;
+        }
+        _resumeCancelledFullRefresh = false;
 
-            auto enumerator = dict->GetEnumerator();
-            while(enumerator->i___System__Collections__IEnumerator()->MoveNext()) {
-                vec.emplace_back(enumerator->Current.Value);
-            }
-            enumerator->i___System__IDisposable()->Dispose();
+        // the listing covers every root, so cached levels in a root that weren't listed are gone without checking the disk for each of them.
+        // this waits until the levels are loaded, so levels that were moved could still take over their entries from their old paths
+        {
+            std::unordered_set<std::string_view> listedLevels;
+            listedLevels.reserve(levels.size());
+            for (auto const& level : levels) listedLevels.emplace(level.levelPath.native());
+            Utils::RemoveMissingCachedInfo([&](std::string_view levelPath){
+                if (listedLevels.contains(levelPath)) return true;
+                std::filesystem::path path(levelPath);
+                auto inRoot = [&](std::filesystem::path const& root){ return std::mismatch(root.begin(), root.end(), path.begin(), path.end()).first == root.end(); };
+                if (std::ranges::any_of(config.RootCustomLevelPaths, inRoot) || std::ranges::any_of(config.RootCustomWIPLevelPaths, inRoot)) return false;
+                // levels cached from outside the roots aren't part of the listing
+                return std::filesystem::exists(path);
+            });
+        }
 
-            return vec;
-        };
+        // save cache and manifest to file after all songs are loaded
+        {
+            TRACE_SCOPE("SaveCaches");
+            Utils::SaveSongInfoCache();
+            Utils::SaveDirectoryManifest();
+        }
 
         auto collectionUpdateStartTime = high_resolution_clock::now();
+        UpdateLevelCollections();
+        INFO("Updated collections after load in {}ms", duration_cast<milliseconds>(high_resolution_clock::now() - collectionUpdateStartTime).count());
+
+        // events happen on main thread anyway so we don't have to queue up on main thread
+        RefreshLevelPacks();
 
-        auto customLevelValues = GetValues(_customLevels);
-        auto customWIPLevelValues = GetValues(_customWIPLevels);
+        // same goes here, it's already on main thread
+        InvokeSongsLoaded(_allLoadedLevels);
+        _areSongsLoaded = true;
+        _areLevelsPublished = true;
+        INFO("Refresh performed in {}ms", duration_cast<milliseconds>(high_resolution_clock::now() - refreshStartTime).count());
 
-        _customLevelPack->SetLevels(customLevelValues);
-        _customLevelPack->SortLevels();
+        LoadCachedLevelSaveData();
+    }
 
-        _customWIPLevelPack->SetLevels(customWIPLevelValues);
-        _customWIPLevelPack->SortLevels();
+    void RuntimeSongLoader::UpdateLevelCollections() {
+        TRACE_SCOPE("UpdateLevelCollections");
+        // everything is built and sorted on the calling thread, the main thread only swaps it in
+        auto customLevelValues = GetSortedValues(_customLevels);
+        auto customWIPLevelValues = GetSortedValues(_customWIPLevels);
 
         {
             std::vector<CustomBeatmapLevel*> allLevels;
-            allLevels.reserve(actualCount);
+            allLevels.reserve(customLevelValues.size() + customWIPLevelValues.size());
 
             // insert wip levels before other loaded levels
             allLevels.insert(allLevels.begin(), customWIPLevelValues.begin(), customWIPLevelValues.end());
@@ -259,8 +630,8 @@ namespace SongCore::SongLoader {
 
             std::unordered_map<std::string, CustomBeatmapLevel*> levelIdsToLevels;
             std::unordered_map<std::string, CustomBeatmapLevel*> hashesToLevels;
-            levelIdsToLevels.reserve(actualCount);
-            hashesToLevels.reserve(actualCount);
+            levelIdsToLevels.reserve(allLevels.size());
+            hashesToLevels.reserve(allLevels.size());
 
             for (auto const level : allLevels) {
                 std::string levelID = lowerString(static_cast<std::string>(level->levelID));
@@ -270,130 +641,479 @@ namespace SongCore::SongLoader {
             }
 
             // touch collections as short as possible by using move
-            _allLoadedLevels = std::move(allLevels);
-            _levelIdsToLevels = std::move(levelIdsToLevels);
-            _hashesToLevels = std::move(hashesToLevels);
+            RunOnMainThread([&](){
+                _customLevelPack->SetLevels(customLevelValues);
+                _customWIPLevelPack->SetLevels(customWIPLevelValues);
+
+                _allLoadedLevels = std::move(allLevels);
+                _levelIdsToLevels = std::move(levelIdsToLevels);
+                _hashesToLevels = std::move(hashesToLevels);
+            });
         }
+    }
 
-        INFO("Updated collections after load in {}ms", duration_cast<milliseconds>(high_resolution_clock::now() - collectionUpdateStartTime).count());
-
-        // events happen on main thread anyway so we don't have to queue up on main thread
-        RefreshLevelPacks();
+    bool RuntimeSongLoader::PublishLevelBatch(RefreshPipeline* pipeline) {
+        std::vector<CustomBeatmapLevel*> batch;
+        std::vector<CustomBeatmapLevel*> wipBatch;
+        {
+            std::lock_guard<std::mutex> lock(pipeline->batchMutex);
+            batch.swap(pipeline->batchLevels);
+            wipBatch.swap(pipeline->batchWIPLevels);
+        }
+        if (batch.empty() && wipBatch.empty()) return false;
+        TRACE_SCOPE("PublishLevelBatch");
+        auto publishStartTime = high_resolution_clock::now();
+
+        if (!pipeline->packsPublished) {
+            // the first batch rebuilds the packs from the dictionaries, so levels kept from before this refresh show up with it and removed ones are gone
+            UpdateLevelCollections();
+            RefreshLevelPacks();
+            pipeline->packsPublished = true;
+        } else {
+            // later batches are only appended, sorting everything and the pack refresh events are left to the end of the refresh
+            std::stable_sort(batch.begin(), batch.end(), [](auto a, auto b){ return static_cast<std::u16string_view>(a->songName) < static_cast<std::u16string_view>(b->songName); });
+            std::stable_sort(wipBatch.begin(), wipBatch.end(), [](auto a, auto b){ return static_cast<std::u16string_view>(a->songName) < static_cast<std::u16string_view>(b->songName); });
+            AppendLevelBatch(_customLevelPack, batch);
+            AppendLevelBatch(_customWIPLevelPack, wipBatch);
+        }
+        _areLevelsPublished = true;
 
-        // same goes here, it's already on main thread
-        InvokeSongsLoaded(_allLoadedLevels);
-        _areSongsLoaded = true;
-        INFO("Refresh performed in {}ms", duration_cast<milliseconds>(high_resolution_clock::now() - refreshStartTime).count());
+        batch.insert(batch.end(), wipBatch.begin(), wipBatch.end());
+        InvokeSongsBatchLoaded(batch);
+        DEBUG("Published a batch of {} levels ({} total) in {}ms", batch.size(), _allLoadedLevels.size(), duration_cast<milliseconds>(high_resolution_clock::now() - publishStartTime).count());
+        return true;
     }
 
-    void RuntimeSongLoader::RefreshSongWorkerThread(std::mutex* levelsItrMutex, std::set<LevelPathAndWip>::const_iterator* levelsItr, std::set<LevelPathAndWip>::const_iterator* levelsEnd) {
-        auto NextLevel = [](std::mutex& levelsItrMutex, std::set<LevelPathAndWip>::const_iterator& levelsItr, std::set<LevelPathAndWip>::const_iterator& levelsEnd) -> LevelPathAndWip {
-            std::lock_guard<std::mutex> lock(levelsItrMutex);
-            if (levelsItr != levelsEnd) {
-                auto v = *levelsItr;
-                levelsItr++;
-                return v;
-            } else {
-                return {};
+    void RuntimeSongLoader::AppendLevelBatch(CustomLevelPack* pack, std::vector<CustomBeatmapLevel*>& levels) {
+        if (levels.empty()) return;
+        auto allLoaded = il2cpp_utils::cast<SongLoader::CustomBeatmapLevelsRepository>(_beatmapLevelsModel->_allLoadedBeatmapLevelsRepository);
+
+        RunOnMainThread([&](){
+            // a level added to the dictionaries while the first batch was rebuilding the packs is already in them
+            std::erase_if(levels, [this](auto level){
+                auto itr = _levelIdsToLevels.find(lowerString(static_cast<std::string>(level->levelID)));
+                return itr != _levelIdsToLevels.end() && itr->second == level;
+            });
+
+            for (auto level : levels) {
+                std::string levelID = lowerString(static_cast<std::string>(level->levelID));
+                _allLoadedLevels.emplace_back(level);
+                _levelIdsToLevels[levelID] = level;
+                _hashesToLevels[std::string(GetHashFromLevelID(levelID))] = level;
             }
-        };
 
-        while (*levelsItr != *levelsEnd) {
-            auto [levelPath, isWip] = NextLevel(*levelsItrMutex, *levelsItr, *levelsEnd);
+            pack->AddLevels(levels);
+            _customBeatmapLevelsRepository->AddToBackingDictionaries(pack, levels);
+            allLoaded->AddToBackingDictionaries(pack, levels);
+        });
+    }
+
+    void RuntimeSongLoader::LogLevelLoadFailure(std::filesystem::path const& levelPath) {
+        try {
+            throw;
+        } catch (std::exception const& e) {
+            ERROR("Caught exception of type {} while loading song @ path '{}', song will be skipped! what: {}", typeid(e).name(), levelPath.string(), e.what());
+        } catch (...) {
+            ERROR("Caught exception of unknown type (current_exception typeid: {}) while loading song @ path '{}', song will be skipped!", typeid(std::current_exception()).name(), levelPath.string());
+        }
 
-            // we got an invalid levelPath
-            if (levelPath.empty()) {
-                _loadedSongs++;
-                continue;
+        // if an error was caught, a song failed to load so we decrease total song count
+        _totalSongs--;
+    }
+
+    void RuntimeSongLoader::RefreshReadWorkerThread(RefreshPipeline* pipeline, size_t workerIndex) {
+        static Version v4(4);
+
+        while (pipeline->readConcurrency.WaitUntilActive(workerIndex)) {
+            // cancellation happens between levels, whatever was read already still gets parsed and constructed
+            auto index = _cancelRefreshRequested ? std::nullopt : pipeline->readRanges.Next(workerIndex);
+            // everything is claimed or the refresh was cancelled, so let parked workers exit as well
+            if (!index) {
+                pipeline->readConcurrency.Finish();
+                break;
             }
 
-            try {
-                auto startTime = high_resolution_clock::now();
-                CustomBeatmapLevel* level = nullptr;
-                StringW csLevelPath(levelPath.string());
+            auto const& [levelPath, isWip] = pipeline->levels[*index];
+            TRACE_SCOPE_DETAIL("ReadLevel", levelPath.string());
+            auto startTime = high_resolution_clock::now();
+            std::optional<ReadLevel> readLevel;
+            std::optional<PreparedLevel> cachedLevel;
+            LevelLoadTiming timing { levelPath };
 
-                // pick the dictionary we need to add / check from based on whether this song is WIP
+            try {
+                // pick the dictionary we need to check based on whether this song is WIP
                 auto targetDict = isWip ? _customWIPLevels : _customLevels;
 
-                // preliminary check to see whether the song we are looking for already is in our dictionary
-                bool containsKey = targetDict->ContainsKey(csLevelPath);
-                if (containsKey) {
-                    level = targetDict->get_Item(levelPath.string());
-                }
-
-                // if the level is not yet set, attempt loading levelinfosavedata from the song path, then load custom preview beatmap level from that
-                if (!level) {
-                    static Version v4(4);
-                    static auto GetSaveDataVersion = [](std::filesystem::path const& levelPath) {
-                        std::filesystem::path infoPath = levelPath / "info.dat";
-                        if (!std::filesystem::exists(infoPath)) infoPath = levelPath / "Info.dat";
-                        return VersionFromFilePath(infoPath);
-                    };
-
-                    auto v = GetSaveDataVersion(levelPath);
-                    if (v < v4) { // v3
-                        auto saveData = _levelLoader->GetSaveDataFromV3(levelPath);
-                        if (saveData) {
-                            std::string hash;
-                            level = _levelLoader->LoadCustomBeatmapLevel(levelPath, isWip, saveData, hash);
-                        }
-                    } else { // v4
-                        auto saveData = _levelLoader->GetSaveDataFromV4(levelPath);
-                        if (saveData) {
-                            std::string hash;
-                            level = _levelLoader->LoadCustomBeatmapLevel(levelPath, isWip, saveData, hash);
+                // levels that are still loaded from the last refresh skip the rest of the pipeline
+                if (targetDict->ContainsKey(levelPath.string())) {
+                    _loadedSongs++;
+                } else {
+                    std::vector<Utils::DirectoryEntry> entries;
+                    if (!Utils::ListDirectory(levelPath, entries)) throw std::runtime_error(fmt::format("Could not list level folder {}", levelPath.string()));
+                    auto infoName = Utils::FindInfoDat(entries);
+                    if (!infoName.has_value()) throw std::runtime_error(fmt::format("no info.dat found for song @ '{}'", levelPath.string()));
+
+                    // the cached info is only valid while the folder is unchanged, so whatever is in it still matches the info.dat
+                    auto cachedInfo = Utils::GetCachedInfo(levelPath, entries);
+                    auto metadata = cachedInfo.has_value() ? LevelMetadata::FromCachedInfo(*cachedInfo) : std::nullopt;
+
+                    if (metadata.has_value()) {
+                        timing.Add(LoadStage::Discovery, high_resolution_clock::now() - startTime);
+                        cachedLevel = PreparedLevel{ levelPath, isWip, metadata->isV4, {}, {}, std::move(*cachedInfo->sha1), *cachedInfo->songDuration, std::move(metadata), std::move(timing) };
+                    } else {
+                        auto infoText = Utils::ReadText(levelPath / *infoName);
+                        if (infoText.empty()) throw std::runtime_error(fmt::format("Could not read info.dat for song @ '{}'", levelPath.string()));
+
+                        auto sniffStartTime = high_resolution_clock::now();
+                        timing.Add(LoadStage::Discovery, sniffStartTime - startTime);
+
+                        // the text is read byte per char16, so narrowing the start back to sniff the version is lossless
+                        std::string versionText(infoText.begin(), infoText.begin() + std::min<size_t>(infoText.size(), 50));
+                        bool isV4 = !(VersionFromFileData(versionText) < v4);
+
+                        auto prefetchStartTime = high_resolution_clock::now();
+                        timing.Add(LoadStage::VersionSniff, prefetchStartTime - sniffStartTime);
+
+                        // hashing and getting the duration only read the other files if they weren't cached
+                        uint64_t levelSize = 0;
+                        if (!cachedInfo.has_value() || !cachedInfo->sha1.has_value() || !cachedInfo->songDuration.has_value()) {
+                            levelSize = Utils::PrefetchDirectoryFiles(levelPath, entries);
                         }
+                        // a level hash file is read instead of the files, unless it turns out to be for another version of the folder
+                        uint64_t hashCost = cachedInfo.has_value() && cachedInfo->sha1.has_value() ? 0 : Utils::HasLevelHashFile(entries) ? 1 : levelSize;
+                        timing.Add(LoadStage::Discovery, high_resolution_clock::now() - prefetchStartTime);
+
+                        readLevel = ReadLevel{ levelPath, isWip, std::move(infoText), isV4, hashCost, std::move(timing) };
                     }
                 }
+            } catch (...) {
+                LogLevelLoadFailure(levelPath);
+                // only read stage times were added so far, whatever isn't attributed yet went into the step that threw
+                timing.Add(LoadStage::Discovery, high_resolution_clock::now() - startTime - timing.Total);
+                pipeline->RecordTiming(std::move(timing));
+            }
 
-                // if we now have a level, add it to the target dictionary, else log a failure
-                if (level) {
-                    targetDict->TryAdd(levelPath.string(), level);
+            pipeline->readStats.AddBusyTime(startTime);
+            pipeline->readConcurrency.ReportCompleted();
+            if (readLevel.has_value()) pipeline->readQueue.Push(std::move(*readLevel));
+            // nothing is left to parse or hash for levels that came from the cache
+            if (cachedLevel.has_value()) pipeline->preparedQueue.Push(std::move(*cachedLevel));
+        }
+    }
+
+    void RuntimeSongLoader::RefreshParseWorkerThread(RefreshPipeline* pipeline) {
+        while (auto readLevel = pipeline->readQueue.Pop()) {
+            auto const& levelPath = readLevel->levelPath;
+            TRACE_SCOPE_DETAIL("ParseLevel", levelPath.string());
+            auto startTime = high_resolution_clock::now();
+            std::optional<PreparedLevel> preparedLevel;
+            auto& timing = readLevel->timing;
+            auto readStageTime = timing.Total;
+
+            try {
+                PreparedLevel prepared { levelPath, readLevel->isWip, readLevel->isV4 };
+                bool success;
+                if (readLevel->isV4) {
+                    auto saveData = _levelLoader->GetSaveDataFromV4(levelPath, readLevel->infoText);
+                    timing.Add(LoadStage::InfoParse, high_resolution_clock::now() - startTime);
+                    success = _levelLoader->VerifyCustomBeatmapLevel(levelPath, saveData, prepared.songDuration, &timing);
+                    prepared.saveDataV4 = saveData;
+                } else {
+                    auto saveData = _levelLoader->GetSaveDataFromV3(levelPath, readLevel->infoText);
+                    timing.Add(LoadStage::InfoParse, high_resolution_clock::now() - startTime);
+                    success = _levelLoader->VerifyCustomBeatmapLevel(levelPath, saveData, prepared.songDuration, &timing);
+                    prepared.saveDataV3 = saveData;
+                }
+
+                if (success) {
+                    prepared.timing = std::move(timing);
+                    preparedLevel = std::move(prepared);
                 } else {
                     WARNING("Somehow failed to load song at path {}", levelPath.string());
+                    _loadedSongs++;
+                    pipeline->RecordTiming(std::move(timing));
+                }
+            } catch (...) {
+                LogLevelLoadFailure(levelPath);
+                // whatever this stage didn't attribute yet went into the step that threw
+                timing.Add(LoadStage::InfoParse, high_resolution_clock::now() - startTime - (timing.Total - readStageTime));
+                pipeline->RecordTiming(std::move(timing));
+            }
+
+            if (!preparedLevel.has_value()) {
+                pipeline->parseStats.AddBusyTime(startTime);
+            } else if (readLevel->hashCost == 0) {
+                // a cached hash is only a lookup away
+                RefreshHashLevel(pipeline, std::move(*preparedLevel));
+                pipeline->parseStats.AddBusyTime(startTime);
+            } else {
+                // levels that have to be read to be hashed don't hold up the ones behind them, the cheapest get hashed and show up first
+                pipeline->parseStats.AddBusyTime(startTime);
+                auto hashFuture = Utils::GetHashingService().Submit(levelPath, Utils::HashPriority::Background, readLevel->hashCost, [this, pipeline, prepared = std::move(*preparedLevel)]() mutable {
+                    // a cancelled refresh drops what is still waiting to be hashed, it never made it into the dictionaries so the next refresh loads it again
+                    if (_cancelRefreshRequested) return;
+                    auto hashStartTime = high_resolution_clock::now();
+                    RefreshHashLevel(pipeline, std::move(prepared));
+                    pipeline->hashStats.AddBusyTime(hashStartTime);
+                });
+                std::lock_guard<std::mutex> lock(pipeline->hashMutex);
+                pipeline->hashFutures.emplace_back(std::move(hashFuture));
+            }
+        }
+    }
+
+    void RuntimeSongLoader::RefreshHashLevel(RefreshPipeline* pipeline, PreparedLevel prepared) {
+        auto const& levelPath = prepared.levelPath;
+        TRACE_SCOPE_DETAIL("HashLevel", levelPath.string());
+        auto startTime = high_resolution_clock::now();
+        auto& timing = prepared.timing;
+        auto previousTime = timing.Total;
+        bool success = false;
+
+        try {
+            std::optional<std::string> hash;
+            if (prepared.isV4) hash = _levelLoader->HashCustomBeatmapLevel(levelPath, prepared.saveDataV4.ptr(), &timing);
+            else hash = _levelLoader->HashCustomBeatmapLevel(levelPath, prepared.saveDataV3.ptr(), &timing);
+
+            if (hash.has_value()) {
+                prepared.hash = std::move(*hash);
+                success = true;
+            } else {
+                WARNING("Somehow failed to load song at path {}", levelPath.string());
+                _loadedSongs++;
+            }
+        } catch (...) {
+            LogLevelLoadFailure(levelPath);
+            timing.Add(LoadStage::Hash, high_resolution_clock::now() - startTime - (timing.Total - previousTime));
+        }
+
+        if (success) pipeline->preparedQueue.Push(std::move(prepared));
+        else pipeline->RecordTiming(std::move(timing));
+    }
+
+    void RuntimeSongLoader::RefreshConstructWorkerThread(RefreshPipeline* pipeline) {
+        while (auto prepared = pipeline->preparedQueue.Pop()) {
+            auto const& levelPath = prepared->levelPath;
+            TRACE_SCOPE_DETAIL("ConstructLevel", levelPath.string());
+            auto startTime = high_resolution_clock::now();
+
+            try {
+                CustomBeatmapLevel* level = nullptr;
+                if (prepared->metadata.has_value()) {
+                    level = _levelLoader->ConstructCustomBeatmapLevel(levelPath, prepared->isWip, *prepared->metadata, prepared->hash, prepared->songDuration);
+                } else if (prepared->isV4) {
+                    level = _levelLoader->ConstructCustomBeatmapLevel(levelPath, prepared->isWip, prepared->saveDataV4.ptr(), prepared->hash, prepared->songDuration);
+                } else {
+                    level = _levelLoader->ConstructCustomBeatmapLevel(levelPath, prepared->isWip, prepared->saveDataV3.ptr(), prepared->hash, prepared->songDuration);
                 }
 
-                auto time = high_resolution_clock::now() - startTime;
-                if (auto ms = duration_cast<milliseconds>(time).count(); ms > 0) {
-                    INFO("Loaded song in {}ms", ms);
+                // if we now have a level, add it to the target dictionary, else log a failure
+                if (level) {
+                    auto targetDict = prepared->isWip ? _customWIPLevels : _customLevels;
+                    if (targetDict->TryAdd(levelPath.string(), level) && config.progressiveLoading) {
+                        std::lock_guard<std::mutex> lock(pipeline->batchMutex);
+                        (prepared->isWip ? pipeline->batchWIPLevels : pipeline->batchLevels).emplace_back(level);
+                    }
                 } else {
-                    auto µs = (float)duration_cast<nanoseconds>(time).count() / 1000.0f;
-                    INFO("Loaded song in {}us", µs);
+                    WARNING("Somehow failed to load song at path {}", levelPath.string());
                 }
 
                 // update progress
                 _loadedSongs++;
+            } catch (...) {
+                LogLevelLoadFailure(levelPath);
+            }
+
+            prepared->timing.Add(LoadStage::Construction, high_resolution_clock::now() - startTime);
+            pipeline->RecordTiming(std::move(prepared->timing));
+            pipeline->constructStats.AddBusyTime(startTime);
+        }
+    }
+
+    void RuntimeSongLoader::LoadCachedLevelSaveData() {
+        // kept in safe pointers, a refresh that starts meanwhile might drop the levels from the dictionaries
+        std::vector<SafePtr<CustomBeatmapLevel>> levels;
+        for (auto level : _allLoadedLevels) {
+            if (!level->standardLevelInfoSaveDataV2.has_value() && !level->beatmapLevelSaveDataV4.has_value()) levels.emplace_back(level);
+        }
+        if (levels.empty()) return;
+
+        // the levels are already shown, so anything a refresh or the game waits on goes first
+        Utils::GetThreadPool().Enqueue(Utils::TaskPriority::Low, [this, levels = std::move(levels)](){
+            TRACE_SCOPE("LoadCachedLevelSaveData");
+            static Version v4(4);
+            auto startTime = high_resolution_clock::now();
+            size_t loadedCount = 0;
+
+            for (size_t batchStart = 0; batchStart < levels.size(); batchStart += SAVE_DATA_BATCH_SIZE) {
+                if (_instance != this || !_areLevelsPublished) {
+                    INFO("Refresh started before the savedata of {} cached levels was parsed, leaving them to it", levels.size() - batchStart);
+                    return;
+                }
+
+                // the savedata is only referenced from here until it's handed over, so it's kept in safe pointers like the pipeline keeps it
+                struct ParsedSaveData {
+                    CustomBeatmapLevel* level;
+                    bool isV4;
+                    SafePtr<SongCore::CustomJSONData::CustomLevelInfoSaveDataV2> saveDataV2;
+                    SafePtr<SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4> saveDataV4;
+                };
+                std::vector<ParsedSaveData> parsed;
+                auto batchEnd = std::min<size_t>(batchStart + SAVE_DATA_BATCH_SIZE, levels.size());
+                for (size_t i = batchStart; i < batchEnd; i++) {
+                    CustomBeatmapLevel* level = levels[i].ptr();
+                    std::filesystem::path levelPath(level->customLevelPath);
+                    try {
+                        auto infoPath = Utils::FindInfoDatPath(levelPath);
+                        auto infoText = infoPath.has_value() ? Utils::ReadText(*infoPath) : std::u16string();
+                        if (infoText.empty()) throw std::runtime_error("info.dat could not be read");
+
+                        // the text is read byte per char16, so narrowing the start back to sniff the version is lossless
+                        std::string versionText(infoText.begin(), infoText.begin() + std::min<size_t>(infoText.size(), 50));
+                        ParsedSaveData entry { level, !(VersionFromFileData(versionText) < v4) };
+                        if (entry.isV4) {
+                            auto saveData = _levelLoader->GetSaveDataFromV4(levelPath, infoText);
+                            if (!saveData) throw std::runtime_error("info.dat could not be parsed");
+                            entry.saveDataV4 = saveData;
+                        } else {
+                            auto saveData = _levelLoader->GetSaveDataFromV3(levelPath, infoText);
+                            if (!saveData) throw std::runtime_error("info.dat could not be parsed");
+                            entry.saveDataV2 = saveData;
+                        }
+                        parsed.emplace_back(std::move(entry));
+                    } catch (std::exception const& e) {
+                        WARNING("Could not load the savedata of cached song @ '{}', it changed since it was cached: {}", levelPath.string(), e.what());
+                    }
+                }
+
+                // other mods read the savedata on the main thread, so that is where it's handed to the levels
+                RunOnMainThread([&](){
+                    for (auto& entry : parsed) {
+                        if (entry.isV4) entry.level->_customBeatmapLevelSaveDataV4 = entry.saveDataV4.ptr();
+                        else entry.level->_customLevelSaveDataV2 = entry.saveDataV2.ptr();
+                    }
+                });
+                loadedCount += parsed.size();
+            }
+
+            INFO("Parsed the savedata of {} cached levels in {}ms", loadedCount, duration_cast<milliseconds>(high_resolution_clock::now() - startTime).count());
+        });
+    }
+
+    CustomBeatmapLevel* RuntimeSongLoader::LoadLevel(std::filesystem::path const& levelPath, bool isWip) {
+        static Version v4(4);
+        static auto GetSaveDataVersion = [](std::filesystem::path const& levelPath) {
+            return VersionFromFilePath(Utils::FindInfoDatPath(levelPath).value_or(levelPath / "info.dat"));
+        };
+
+        std::string hash;
+        auto v = GetSaveDataVersion(levelPath);
+        if (v < v4) { // v3
+            auto saveData = _levelLoader->GetSaveDataFromV3(levelPath);
+            if (saveData) return _levelLoader->LoadCustomBeatmapLevel(levelPath, isWip, saveData, hash);
+        } else { // v4
+            auto saveData = _levelLoader->GetSaveDataFromV4(levelPath);
+            if (saveData) return _levelLoader->LoadCustomBeatmapLevel(levelPath, isWip, saveData, hash);
+        }
+
+        return nullptr;
+    }
+
+    void RuntimeSongLoader::RefreshLevel(std::filesystem::path const& levelPath, bool isWip) {
+        // if a running refresh already queued the level for hashing, it moves ahead of everything else so the wait is short
+        Utils::GetHashingService().Prioritize(levelPath);
+
+        // queued behind the current refresh like a refresh itself, so the two never update the collections at the same time
+        std::unique_lock<std::shared_mutex> writingLock(_currentRefreshMutex);
+        auto previousFuture = _currentlyLoadingFuture;
+        _currentlyLoadingFuture = Utils::GetThreadPool().Submit(Utils::TaskPriority::Normal, [this, levelPath, isWip, previousFuture](){
+            if (previousFuture.valid()) previousFuture.wait();
+            RefreshLevel_internal(levelPath, isWip);
+        });
+    }
+
+    void RuntimeSongLoader::RefreshLevel_internal(std::filesystem::path const& levelPath, bool isWip) {
+        // the loader might have been disposed while the update waited for its turn
+        if (_instance != this) return;
+
+        auto targetDict = isWip ? _customWIPLevels : _customLevels;
+        StringW csLevelPath(levelPath.string());
+
+        // loading is the slow part, only swapping the level in happens on the main thread
+        CustomBeatmapLevel* newLevel = nullptr;
+        if (std::filesystem::exists(levelPath)) {
+            try {
+                newLevel = LoadLevel(levelPath, isWip);
             } catch (std::exception const& e) {
                 ERROR("Caught exception of type {} while loading song @ path '{}', song will be skipped! what: {}", typeid(e).name(), levelPath.string(), e.what());
-                // if an error was caught, a song failed to load so we decrease total song count
-                _totalSongs--;
-            } catch (...) {
-                ERROR("Caught exception of unknown type (current_exception typeid: {}) while loading song @ path '{}', song will be skipped!", typeid(std::current_exception()).name(), levelPath.string());
-                // if an error was caught, a song failed to load so we decrease total song count
-                _totalSongs--;
             }
+
+            if (!newLevel) WARNING("Somehow failed to load song at path {}", levelPath.string());
+        }
+
+        // the dictionaries are concurrent and refreshes wait for us, so they can be changed right here
+        CustomBeatmapLevel* oldLevel = nullptr;
+        if (targetDict->TryGetValue(csLevelPath, byref(oldLevel))) {
+            targetDict->System_Collections_Generic_IDictionary_TKey_TValue__Remove(csLevelPath);
         }
+        if (newLevel) targetDict->TryAdd(csLevelPath, newLevel);
+        if (!oldLevel && !newLevel) return;
+        INFO("{} level @ {} without a refresh", !newLevel ? "Removed" : oldLevel ? "Reloaded" : "Added", levelPath.string());
+
+        // only the pack this level belongs to has to be rebuilt
+        auto targetPack = isWip ? _customWIPLevelPack : _customLevelPack;
+        auto packLevels = GetSortedValues(targetDict);
+
+        RunOnMainThread([&](){
+            // swap the level in the c++ collections
+            if (oldLevel) {
+                std::string oldLevelID = lowerString(static_cast<std::string>(oldLevel->levelID));
+                std::erase(_allLoadedLevels, oldLevel);
+                if (auto itr = _levelIdsToLevels.find(oldLevelID); itr != _levelIdsToLevels.end() && itr->second == oldLevel) _levelIdsToLevels.erase(itr);
+                if (auto itr = _hashesToLevels.find(std::string(GetHashFromLevelID(oldLevelID))); itr != _hashesToLevels.end() && itr->second == oldLevel) _hashesToLevels.erase(itr);
+            }
+
+            if (newLevel) {
+                std::string newLevelID = lowerString(static_cast<std::string>(newLevel->levelID));
+                _allLoadedLevels.emplace_back(newLevel);
+                _levelIdsToLevels[newLevelID] = newLevel;
+                _hashesToLevels[std::string(GetHashFromLevelID(newLevelID))] = newLevel;
+            }
+
+            targetPack->SetLevels(packLevels);
+        });
+
+        Utils::SaveSongInfoCache();
+
+        RefreshLevelPacks();
+        InvokeSongsLoaded(_allLoadedLevels);
     }
 
     void RuntimeSongLoader::RefreshLevelPacks() {
+        TRACE_SCOPE("RefreshLevelPacks");
+        // the repositories are changed on the main thread, the events in between get there on their own
         auto allLoaded = il2cpp_utils::cast<SongLoader::CustomBeatmapLevelsRepository>(_beatmapLevelsModel->_allLoadedBeatmapLevelsRepository);
-        for (auto pack : _customBeatmapLevelsRepository->BeatmapLevelPacks) {
-            allLoaded->RemoveLevelPack(pack);
-        }
-        _customBeatmapLevelsRepository->ClearLevelPacks();
+        RunOnMainThread([this, allLoaded](){
+            for (auto pack : _customBeatmapLevelsRepository->BeatmapLevelPacks) {
+                allLoaded->RemoveLevelPack(pack);
+            }
+            _customBeatmapLevelsRepository->ClearLevelPacks();
 
-        _customBeatmapLevelsRepository->AddLevelPack(_customLevelPack);
-        _customBeatmapLevelsRepository->AddLevelPack(_customWIPLevelPack);
+            _customBeatmapLevelsRepository->AddLevelPack(_customLevelPack);
+            _customBeatmapLevelsRepository->AddLevelPack(_customWIPLevelPack);
+        });
 
         InvokeCustomLevelPacksWillRefresh(_customBeatmapLevelsRepository);
 
-        _customBeatmapLevelsRepository->FixBackingDictionaries();
+        RunOnMainThread([this, allLoaded](){
+            _customBeatmapLevelsRepository->FixBackingDictionaries();
 
-        for (auto pack : _customBeatmapLevelsRepository->BeatmapLevelPacks) {
-            allLoaded->AddLevelPack(pack);
-        }
+            for (auto pack : _customBeatmapLevelsRepository->BeatmapLevelPacks) {
+                allLoaded->AddLevelPack(pack);
+            }
 
-        allLoaded->FixBackingDictionaries();
+            allLoaded->FixBackingDictionaries();
+        });
 
         InvokeCustomLevelPacksRefreshed(_customBeatmapLevelsRepository);
     }
@@ -440,7 +1160,7 @@ namespace SongCore::SongLoader {
     }
 
     std::future<void> RuntimeSongLoader::DeleteSong(std::filesystem::path const& levelPath) {
-        return il2cpp_utils::il2cpp_async(&RuntimeSongLoader::DeleteSong_internal, this, levelPath);
+        return Utils::GetThreadPool().Submit(Utils::TaskPriority::Normal, [this, levelPath](){ DeleteSong_internal(levelPath); });
     }
 
     std::future<void> RuntimeSongLoader::DeleteSong(CustomBeatmapLevel* beatmapLevel) {
@@ -448,6 +1168,11 @@ namespace SongCore::SongLoader {
         return DeleteSong(static_cast<std::string>(beatmapLevel->customLevelPath));
     }
 
+    RefreshTimingReport RuntimeSongLoader::GetLastRefreshTimings() {
+        std::lock_guard<std::mutex> lock(_lastRefreshTimingsMutex);
+        return _lastRefreshTimings;
+    }
+
     CustomBeatmapLevel* RuntimeSongLoader::GetLevelByPath(std::filesystem::path const& levelPath) {
         auto csPath = StringW(levelPath.string());
 
@@ -455,7 +1180,10 @@ namespace SongCore::SongLoader {
         if (CustomLevels->TryGetValue(csPath, byref(level))) return level;
         else if (CustomWIPLevels->TryGetValue(csPath, byref(level))) return level;
 
-        return GetLevelByFunction([path = levelPath.string()](auto level){ return level->customLevelPath == path; });
+        level = GetLevelByFunction([path = levelPath.string()](auto level){ return level->customLevelPath == path; });
+        // something wants this level now, so if a refresh is still waiting to hash it, it goes first
+        if (!level) Utils::GetHashingService().Prioritize(levelPath);
+        return level;
     }
 
     CustomBeatmapLevel* RuntimeSongLoader::GetLevelByLevelID(std::string_view levelID) {
@@ -502,8 +1230,10 @@ namespace SongCore::SongLoader {
 
 // macro to wrap an event invoke into something that always executes on main thread. could we just check whether we are on main thread and invoke in place? sure, but where's the fun in that!
 #define EVENT_MAIN_THREAD_INVOKE_WRAPPER(event, ...) do { \
+    TRACE_SCOPE("WaitForMainThread " #event); \
     bool eventInvoked = false; \
     BSML::MainThreadScheduler::Schedule([this, &eventInvoked __VA_OPT__(, __VA_ARGS__)](){ \
+        TRACE_SCOPE("Invoke " #event); \
         event.invoke(__VA_ARGS__); \
         SongCore::API::Loading::Get##event##Event().invoke(__VA_ARGS__); \
         eventInvoked = true; \
@@ -519,6 +1249,10 @@ namespace SongCore::SongLoader {
         EVENT_MAIN_THREAD_INVOKE_WRAPPER(SongsLoaded, levels);
     }
 
+    void RuntimeSongLoader::InvokeSongsBatchLoaded(std::span<CustomBeatmapLevel* const> levels) const {
+        EVENT_MAIN_THREAD_INVOKE_WRAPPER(SongsBatchLoaded, levels);
+    }
+
     void RuntimeSongLoader::InvokeCustomLevelPacksWillRefresh(SongCore::SongLoader::CustomBeatmapLevelsRepository* customLevelsRepository) const {
         EVENT_MAIN_THREAD_INVOKE_WRAPPER(CustomLevelPacksWillRefresh, customLevelsRepository);
     }
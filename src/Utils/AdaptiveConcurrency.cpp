@@ -0,0 +1,138 @@
+#include "Utils/AdaptiveConcurrency.hpp"
+#include "logging.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+namespace SongCore::Utils {
+    /// @brief fewer completed songs than this makes a sample too noisy to act on, unless it took longer than MAX_SAMPLE_TIME
+    static constexpr size_t MIN_SAMPLE_SONGS = 16;
+    static constexpr auto MAX_SAMPLE_TIME = std::chrono::seconds(2);
+    /// @brief relative throughput change below which two samples are considered equal
+    static constexpr float NOISE_THRESHOLD = 0.05f;
+    /// @brief fraction of cpu time spent waiting on I/O above which storage is considered saturated
+    static constexpr float HIGH_IOWAIT = 0.30f;
+
+    AdaptiveConcurrency::AdaptiveConcurrency(size_t maxWorkers, size_t initialWorkers) :
+        _maxWorkers(std::max<size_t>(maxWorkers, 1)),
+        _targetWorkers(std::clamp<size_t>(initialWorkers, 1, _maxWorkers)),
+        _sampleStart(std::chrono::steady_clock::now()),
+        _sampleStartCpuTimes(ReadCpuTimes()) {}
+
+    bool AdaptiveConcurrency::WaitUntilActive(size_t workerIndex) {
+        if (workerIndex < _targetWorkers.load(std::memory_order_relaxed)) return true;
+
+        std::unique_lock<std::mutex> lock(_parkMutex);
+        _parkCondition.wait(lock, [this, workerIndex](){ return _finished || workerIndex < _targetWorkers.load(std::memory_order_relaxed); });
+        return !_finished;
+    }
+
+    void AdaptiveConcurrency::Finish() {
+        {
+            std::lock_guard<std::mutex> lock(_parkMutex);
+            _finished = true;
+        }
+        _parkCondition.notify_all();
+    }
+
+    void AdaptiveConcurrency::SetTarget(size_t target) {
+        {
+            std::lock_guard<std::mutex> lock(_parkMutex);
+            _targetWorkers.store(target, std::memory_order_relaxed);
+        }
+        _parkCondition.notify_all();
+    }
+
+    std::optional<AdaptiveConcurrency::CpuTimes> AdaptiveConcurrency::ReadCpuTimes() {
+        std::ifstream stat("/proc/stat", std::ios::in);
+        if (!stat.is_open()) return std::nullopt;
+
+        // cpu  user nice system idle iowait irq softirq steal ...
+        std::string label;
+        stat >> label;
+        if (label != "cpu") return std::nullopt;
+
+        CpuTimes times { 0, 0 };
+        uint64_t value;
+        for (int i = 0; i < 8 && stat >> value; i++) {
+            times.total += value;
+            if (i == 4) times.ioWait = value;
+        }
+
+        if (times.total == 0) return std::nullopt;
+        return times;
+    }
+
+    void AdaptiveConcurrency::Sample() {
+        auto now = std::chrono::steady_clock::now();
+        auto elapsed = now - _sampleStart;
+        auto completed = _completed.load(std::memory_order_relaxed);
+        auto sampleCompleted = completed - _sampleStartCompleted;
+
+        if (sampleCompleted < MIN_SAMPLE_SONGS && elapsed < MAX_SAMPLE_TIME) return;
+
+        auto seconds = std::chrono::duration<float>(elapsed).count();
+        if (seconds <= 0) return;
+        float throughput = sampleCompleted / seconds;
+
+        std::optional<float> ioWait;
+        auto cpuTimes = ReadCpuTimes();
+        if (cpuTimes && _sampleStartCpuTimes && cpuTimes->total > _sampleStartCpuTimes->total) {
+            ioWait = static_cast<float>(cpuTimes->ioWait - _sampleStartCpuTimes->ioWait) / (cpuTimes->total - _sampleStartCpuTimes->total);
+        }
+        bool storageSaturated = ioWait.has_value() && *ioWait >= HIGH_IOWAIT;
+
+        auto current = get_TargetWorkers();
+        if (throughput > _bestThroughput) {
+            _bestThroughput = throughput;
+            _bestWorkers = current;
+        }
+
+        std::string reason;
+        size_t next = current;
+        if (_lastThroughput <= 0) {
+            // first measurement, probe in the direction the I/O wait hints at
+            _direction = storageSaturated ? -1 : 1;
+            reason = storageSaturated ? "first sample, storage looks saturated" : "first sample, probing for more throughput";
+            next = current + _direction;
+        } else {
+            float change = (throughput - _lastThroughput) / _lastThroughput;
+            if (change > NOISE_THRESHOLD) {
+                reason = fmt::format("throughput improved by {:.0f}%, continuing", change * 100);
+                next = current + _direction;
+            } else if (change < -NOISE_THRESHOLD) {
+                _direction = -_direction;
+                reason = fmt::format("throughput dropped by {:.0f}%, reversing", -change * 100);
+                next = current + _direction;
+            } else if (storageSaturated) {
+                // more workers aren't helping and they're mostly waiting on storage, so fewer will do the same work
+                _direction = -1;
+                reason = "throughput flat with saturated storage";
+                next = current - 1;
+            } else {
+                reason = "throughput flat";
+            }
+        }
+
+        if (next < 1 || next > _maxWorkers) {
+            // bumped into a bound, next time try the other way
+            _direction = -_direction;
+            next = current;
+            reason += ", at the worker limit";
+        }
+
+        auto ioWaitText = ioWait ? fmt::format("{:.0f}%", *ioWait * 100) : std::string("unavailable");
+        if (next != current) {
+            INFO("Loader concurrency {} -> {} workers: {:.1f} songs/s, iowait {}, {}", current, next, throughput, ioWaitText, reason);
+            SetTarget(next);
+        } else {
+            DEBUG("Loader concurrency stays at {} workers: {:.1f} songs/s, iowait {}, {}", current, throughput, ioWaitText, reason);
+        }
+
+        _lastThroughput = throughput;
+        _sampleStart = now;
+        _sampleStartCompleted = completed;
+        _sampleStartCpuTimes = cpuTimes;
+    }
+}
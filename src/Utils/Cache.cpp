@@ -1,12 +1,28 @@
 #include "Utils/Cache.hpp"
-#include "Utils/Hashing.hpp"
+#include "Utils/SongCacheFile.hpp"
+#include "Utils/XXHash64.hpp"
+#include "Utils/ThreadPool.hpp"
+#include "Utils/Fingerprint.hpp"
 #include "Utils/File.hpp"
 #include "logging.hpp"
+#include "tracing.hpp"
+#include "config.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
 #include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <fstream>
+#include <vector>
 
 #include "paper/shared/utfcpp/source/utf8.h"
 
@@ -15,7 +31,10 @@ namespace SongCore::Utils {
         rapidjson::Value val;
         val.SetObject();
 
-        val.AddMember("directoryHash", directoryHash, allocator);
+        val.AddMember("directoryFingerprint", directoryFingerprint, allocator);
+        // entries that weren't migrated yet keep their old hash, so they can still be migrated after the next load
+        if (legacyDirectoryHash.has_value()) val.AddMember("directoryHash", *legacyDirectoryHash, allocator);
+        if (contentFingerprint.has_value()) val.AddMember("contentFingerprint", *contentFingerprint, allocator);
         if (sha1.has_value()) val.AddMember("sha1", rapidjson::Value(sha1->c_str(), sha1->size(), allocator), allocator);
         if (songDuration.has_value()) val.AddMember("songDuration", songDuration.value(), allocator);
 
@@ -25,13 +44,23 @@ namespace SongCore::Utils {
     bool CachedSongData::Deserialize(rapidjson::Value const& value) {
         bool foundEverything = true;
         auto memberEnd = value.MemberEnd();
+        auto directoryFingerprintItr = value.FindMember("directoryFingerprint");
         auto directoryHashItr = value.FindMember("directoryHash");
+        if (directoryFingerprintItr != memberEnd && directoryFingerprintItr->value.IsUint64()) {
+            directoryFingerprint = directoryFingerprintItr->value.GetUint64();
+        }
         if (directoryHashItr != memberEnd && directoryHashItr->value.IsInt()) {
-            directoryHash = directoryHashItr->value.GetInt();
-        } else {
+            legacyDirectoryHash = directoryHashItr->value.GetInt();
+        }
+        if (directoryFingerprintItr == memberEnd && !legacyDirectoryHash.has_value()) {
             foundEverything = false;
         }
 
+        auto contentFingerprintItr = value.FindMember("contentFingerprint");
+        if (contentFingerprintItr != memberEnd && contentFingerprintItr->value.IsUint64()) {
+            contentFingerprint = contentFingerprintItr->value.GetUint64();
+        } // optional so foundEverything unaffected
+
         auto sha1Itr = value.FindMember("sha1");
         if (sha1Itr != memberEnd && sha1Itr->value.IsString()) {
             sha1 = sha1Itr->value.Get<std::string>();
@@ -45,95 +74,658 @@ namespace SongCore::Utils {
         return foundEverything;
     }
 
-    static std::shared_mutex _cacheMutex;
-    static std::unordered_map<std::string, CachedSongData> _cachedSongData;
-    static std::filesystem::path _cachePath = "/sdcard/ModData/com.beatgames.beatsaber/Mods/SongCore/CachedSongData.json";
+    /// @brief a level path together with its hash, which is calculated once and picks both the shard and the bucket in it
+    struct CacheKey {
+        std::string path;
+        uint64_t hash;
 
-    std::optional<CachedSongData> GetCachedInfo(std::filesystem::path const& levelPath) {
-        auto dirHashOpt = Utils::GetDirectoryHash(levelPath);
-        if (!dirHashOpt.has_value()) {
-            WARNING("Can't get cached info for {} because directory hash could not be calculated!", levelPath.string());
-            return std::nullopt;
+        explicit CacheKey(std::string levelPath) : path(std::move(levelPath)), hash(XXHash64::Hash(path.data(), path.size())) {}
+
+        bool operator==(CacheKey const& other) const { return hash == other.hash && path == other.path; }
+    };
+
+    struct CacheKeyHash {
+        size_t operator()(CacheKey const& key) const { return key.hash; }
+    };
+
+    /// @brief an entry changed since the cache file was written
+    struct CacheChange {
+        /// @brief nullopt if the entry was removed
+        std::optional<CachedSongData> data;
+        /// @brief whether the change is in the journal already
+        bool journaled = false;
+    };
+
+    /// @brief part of the cache, levels are spread over the shards on their path hash so workers rarely wait on each other
+    struct alignas(64) CacheShard {
+        std::shared_mutex mutex;
+        /// @brief the cache as it was last saved or loaded, shared by all shards
+        std::shared_ptr<MappedSongCache const> savedSongData;
+        /// @brief entries changed since the cache file was written
+        std::unordered_map<CacheKey, CacheChange, CacheKeyHash> changedSongData;
+        /// @brief generation each level's content was last sampled in, not saved so every session samples once
+        std::unordered_map<CacheKey, uint32_t, CacheKeyHash> contentCheckGenerations;
+
+        /// @brief has to be called with the mutex held
+        std::optional<CachedSongData> Find(CacheKey const& key) const {
+            auto itr = changedSongData.find(key);
+            if (itr != changedSongData.end()) return itr->second.data;
+            if (!savedSongData) return std::nullopt;
+            return savedSongData->Find(key.path);
+        }
+
+        /// @brief changes the entry in place, has to be called with the mutex held uniquely
+        /// @return false if there is no entry
+        template<typename F>
+        bool Update(CacheKey const& key, F&& update) {
+            auto itr = changedSongData.find(key);
+            if (itr != changedSongData.end()) {
+                if (!itr->second.data.has_value()) return false;
+                update(*itr->second.data);
+                itr->second.journaled = false;
+                return true;
+            }
+
+            // saved entries are read only, so they're copied into the changes once
+            if (!savedSongData) return false;
+            auto saved = savedSongData->Find(key.path);
+            if (!saved.has_value()) return false;
+            update(*saved);
+            changedSongData.emplace(key, CacheChange { std::move(saved) });
+            return true;
         }
+    };
+
+    static constexpr size_t CACHE_SHARD_COUNT = 32;
+    static std::array<CacheShard, CACHE_SHARD_COUNT> _cacheShards;
+
+    static size_t ShardIndexOf(CacheKey const& key) {
+        // the low bits already pick the bucket inside the shard
+        return (key.hash >> 32) % CACHE_SHARD_COUNT;
+    }
+
+    static CacheShard& ShardOf(CacheKey const& key) {
+        return _cacheShards[ShardIndexOf(key)];
+    }
+
+    /// @brief held for whole cache operations like saving and loading, which replace the saved cache in every shard
+    static std::mutex _saveMutex;
+    /// @brief the saved cache all shards point to, guarded by _saveMutex
+    static std::shared_ptr<MappedSongCache const> _savedSongData;
+    static std::filesystem::path _cachePath = SONGCORE_DATA_PATH "/CachedSongData.bin";
+    /// @brief changes since the cache file was written are appended here, so saving costs as much as there were changes
+    static std::filesystem::path _journalPath = SONGCORE_DATA_PATH "/CachedSongData.journal";
+    /// @brief where the cache was saved before the binary format, imported once if there is no binary cache yet
+    static std::filesystem::path _jsonCachePath = SONGCORE_DATA_PATH "/CachedSongData.json";
+
+    /// @brief the journal is compacted into the cache file once it holds more records than this, or a quarter of the cache file's entries if that's more
+    static constexpr size_t JOURNAL_COMPACT_MIN_RECORDS = 256;
+    /// @brief records in the journal, guarded by _saveMutex
+    static size_t _journalRecordCount = 0;
+    /// @brief whether a compaction was queued and didn't run yet, guarded by _saveMutex
+    static bool _compactionQueued = false;
+    /// @brief whether a compaction is writing the cache file right now, which happens without holding _saveMutex. Guarded by _saveMutex
+    static bool _compacting = false;
+    /// @brief bumped whenever the saved cache is replaced by anything but a compaction, so a compaction that ran meanwhile doesn't swap in what it collected before. Guarded by _saveMutex
+    static uint64_t _savedCacheGeneration = 0;
+    /// @brief set when the cache was cleared, the next save then writes the cache file instead of appending to the journal. Guarded by _saveMutex
+    static bool _rewriteRequired = false;
+
+    /// @brief bumped to make levels in content fingerprinted roots sample their files again
+    static std::atomic<uint32_t> _contentCheckGeneration = 1;
+
+    /// @brief guards _changedFingerprints
+    static std::mutex _fingerprintMutex;
+    /// @brief level paths of entries changed since the cache file was written on their fingerprints, what the cache file's fingerprint index is for the saved entries.
+    /// Only a hint, entries are looked up on their path again before they're trusted
+    static std::unordered_map<uint64_t, std::string> _changedFingerprints;
+
+    /// @brief a prebuilt cache, with the root its keys are relative to
+    struct PrebuiltSongCache {
+        std::filesystem::path root;
+        std::filesystem::file_time_type lastWriteTime;
+        std::shared_ptr<MappedSongCache const> songData;
+    };
 
-        auto directoryHash = *dirHashOpt;
-        std::shared_lock<std::shared_mutex> lock(_cacheMutex);
-        auto itr = _cachedSongData.find(levelPath);
-        // if found and dir hash matches, we found a correct value
-        if (itr != _cachedSongData.end() && itr->second.directoryHash == directoryHash) return itr->second;
+    /// @brief guards _prebuiltSongCaches
+    static std::shared_mutex _prebuiltMutex;
+    static std::vector<PrebuiltSongCache> _prebuiltSongCaches;
+
+    /// @brief guards starting the background load and _loadFuture
+    static std::mutex _loadMutex;
+    static std::shared_future<bool> _loadFuture;
+    /// @brief set while the background load runs, so once it's done waiting for it is a single check
+    static std::atomic<bool> _loadPending = false;
+
+    /// @brief blocks until the background load finished, if there is one
+    static void WaitForLoad() {
+        if (!_loadPending.load(std::memory_order_acquire)) return;
+        std::unique_lock<std::mutex> lock(_loadMutex);
+        auto loadFuture = _loadFuture;
         lock.unlock();
+        if (loadFuture.valid()) loadFuture.wait();
+    }
+
+    using CacheChanges = std::vector<std::pair<CacheKey, std::optional<CachedSongData>>>;
+
+    /// @brief all entries in path order, with the changes applied to the saved entries. Has to be called with _saveMutex held
+    /// @param changes filled with the changes that were applied
+    static std::vector<std::pair<std::string, CachedSongData>> CollectCachedInfo(CacheChanges& changes) {
+        for (auto& shard : _cacheShards) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto const& [key, change] : shard.changedSongData) changes.emplace_back(key, change.data);
+        }
+        std::sort(changes.begin(), changes.end(), [](auto const& a, auto const& b){ return a.first.path < b.first.path; });
+
+        std::vector<std::pair<std::string, CachedSongData>> entries;
+        entries.reserve((_savedSongData ? _savedSongData->get_Count() : 0) + changes.size());
+
+        // saved entries are in path order as well, so the changes are merged in on the way
+        auto change = changes.begin();
+        auto addChangesBefore = [&](std::string_view levelPath){
+            for (; change != changes.end() && (levelPath.empty() || change->first.path < levelPath); change++) {
+                if (change->second.has_value()) entries.emplace_back(change->first.path, *change->second);
+            }
+        };
+        if (_savedSongData) {
+            _savedSongData->ForEach([&](std::string_view levelPath, CachedSongData const& data){
+                addChangesBefore(levelPath);
+                if (change != changes.end() && change->first.path == levelPath) {
+                    if (change->second.has_value()) entries.emplace_back(change->first.path, *change->second);
+                    change++;
+                    return;
+                }
+                entries.emplace_back(levelPath, data);
+            });
+        }
+        addChangesBefore({});
+        return entries;
+    }
+
+    /// @brief points every shard at a new saved cache, each shard swapping it in together with dropping its saved changes. Has to be called with _saveMutex held
+    /// @param savedChanges changes the new saved cache contains, dropped unless they were changed again since. The journal only keeps what was appended after they were collected,
+    /// which is exactly what's still marked as journaled. nullptr drops all changes
+    static void ReplaceSavedSongData(std::shared_ptr<MappedSongCache const> savedSongData, CacheChanges const* savedChanges) {
+        _savedSongData = savedSongData;
+
+        std::array<std::vector<CacheChanges::value_type const*>, CACHE_SHARD_COUNT> changesPerShard;
+        if (savedChanges) {
+            for (auto const& change : *savedChanges) changesPerShard[ShardIndexOf(change.first)].push_back(&change);
+        }
+
+        for (size_t i = 0; i < CACHE_SHARD_COUNT; i++) {
+            auto& shard = _cacheShards[i];
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.savedSongData = savedSongData;
+            if (!savedChanges) {
+                shard.changedSongData.clear();
+                continue;
+            }
+            for (auto change : changesPerShard[i]) {
+                auto itr = shard.changedSongData.find(change->first);
+                if (itr != shard.changedSongData.end() && itr->second.data == change->second) shard.changedSongData.erase(itr);
+            }
+        }
+    }
+
+    /// @brief writes the whole cache to the cache file and drops what it holds from the journal.
+    /// Has to be called with _saveMutex held, which is only released while the file is written, so saves meanwhile keep appending to the journal
+    static void CompactSongInfoCache(std::unique_lock<std::mutex>& saveLock) {
+        if (_compacting) return;
+        TRACE_SCOPE("CompactSongInfoCache");
+        _compacting = true;
+
+        CacheChanges changes;
+        auto entries = CollectCachedInfo(changes);
+        auto generation = _savedCacheGeneration;
+        size_t journalRecordCount = _journalRecordCount;
+        std::error_code error;
+        uint64_t journalSize = std::filesystem::file_size(_journalPath, error);
+        if (error) journalSize = 0;
+
+        saveLock.unlock();
+        auto savedSongData = std::make_shared<MappedSongCache>();
+        bool written = WriteSongCacheFile(_cachePath, entries);
+        bool opened = written && savedSongData->Open(_cachePath);
+        if (written && !opened) ERROR("Could not open the song cache that was just saved, keeping the changes in memory");
+        saveLock.lock();
+
+        _compacting = false;
+        if (!opened) return;
+        // the cache was cleared or loaded again meanwhile, what was collected is stale. A clear makes the next save write the cache file again
+        if (generation != _savedCacheGeneration) {
+            DEBUG("The song cache was replaced while compacting it, dropping the compacted cache");
+            return;
+        }
+
+        // if the journal can't be trimmed replaying it later only brings back values the cache file has as well, or older ones that get recalculated
+        if (TrimSongCacheJournal(_journalPath, journalSize)) _journalRecordCount -= journalRecordCount;
+        _rewriteRequired = false;
+        // anything changed again while compacting stays a change for the next save
+        ReplaceSavedSongData(std::move(savedSongData), &changes);
+        DEBUG("Compacted the song cache into {} entries, {} journaled changes were made meanwhile", entries.size(), _journalRecordCount);
+    }
+
+    /// @brief whether levels in this folder get a content fingerprint
+    static bool UsesContentFingerprint(std::filesystem::path const& levelPath) {
+        return std::any_of(config.ContentFingerprintRootPaths.begin(), config.ContentFingerprintRootPaths.end(), [&levelPath](auto const& root){
+            return std::mismatch(root.begin(), root.end(), levelPath.begin(), levelPath.end()).first == root.end();
+        });
+    }
+
+    /// @brief makes the entry findable on its fingerprints until the next save writes it to the fingerprint index
+    static void RememberFingerprints(std::string const& levelPath, CachedSongData const& data) {
+        std::lock_guard<std::mutex> lock(_fingerprintMutex);
+        if (!data.legacyDirectoryHash.has_value()) _changedFingerprints[data.directoryFingerprint] = levelPath;
+        if (data.contentFingerprint.has_value()) _changedFingerprints[*data.contentFingerprint] = levelPath;
+    }
+
+    /// @brief looks for the entry of a level that was moved or renamed, which is still under its old path with the fingerprints of this folder.
+    /// Renames keep the inodes and modification times the directory fingerprint is made of, copies into content fingerprinted roots are found on their content
+    static std::optional<CachedSongData> FindRelocatedInfo(CacheKey const& key, uint64_t directoryFingerprint, std::optional<uint64_t> contentFingerprint, bool useContentFingerprint) {
+        // same rules as for the entry under the level's own path
+        auto matches = [&](CachedSongData const& data){
+            bool directoryMatches = !data.legacyDirectoryHash.has_value() && data.directoryFingerprint == directoryFingerprint;
+            if (!useContentFingerprint) return directoryMatches;
+            return contentFingerprint.has_value() && (data.contentFingerprint.has_value() ? data.contentFingerprint == contentFingerprint : directoryMatches);
+        };
+
+        std::vector<std::string> candidates;
+        std::shared_ptr<MappedSongCache const> savedSongData;
+        {
+            auto& shard = ShardOf(key);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            savedSongData = shard.savedSongData;
+        }
+        {
+            std::lock_guard<std::mutex> lock(_fingerprintMutex);
+            for (auto fingerprint : { std::optional<uint64_t>(directoryFingerprint), contentFingerprint }) {
+                if (!fingerprint.has_value()) continue;
+                auto itr = _changedFingerprints.find(*fingerprint);
+                if (itr != _changedFingerprints.end()) candidates.emplace_back(itr->second);
+            }
+        }
+        if (savedSongData) {
+            for (auto fingerprint : { std::optional<uint64_t>(directoryFingerprint), contentFingerprint }) {
+                if (!fingerprint.has_value()) continue;
+                savedSongData->ForEachWithFingerprint(*fingerprint, [&](std::string_view levelPath, CachedSongData const& data){
+                    if (matches(data)) candidates.emplace_back(levelPath);
+                });
+            }
+        }
+
+        for (auto& candidatePath : candidates) {
+            if (candidatePath == key.path) continue;
+            // the index only says where the entry was, it might have been changed or removed since
+            CacheKey candidateKey(std::move(candidatePath));
+            std::optional<CachedSongData> candidate;
+            {
+                auto& shard = ShardOf(candidateKey);
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                candidate = shard.Find(candidateKey);
+            }
+            // an entry without a hash has nothing worth taking over
+            if (!candidate.has_value() || !candidate->sha1.has_value() || !matches(*candidate)) continue;
+            DEBUG("Reusing the cached info of {} for {}, which has the same files", candidateKey.path, key.path);
+            return candidate;
+        }
+        return std::nullopt;
+    }
+
+    /// @brief looks for the entry of a level in the prebuilt cache of its root, which is only trusted if the content of the folder is what it was prebuilt from
+    /// @param contentFingerprint content fingerprint of the folder, sampled here if it wasn't yet
+    static std::optional<CachedSongData> FindPrebuiltInfo(std::filesystem::path const& levelPath, std::span<DirectoryEntry const> entries, std::optional<uint64_t>& contentFingerprint) {
+        std::optional<CachedSongData> prebuilt;
+        {
+            std::shared_lock<std::shared_mutex> lock(_prebuiltMutex);
+            for (auto const& cache : _prebuiltSongCaches) {
+                if (std::mismatch(cache.root.begin(), cache.root.end(), levelPath.begin(), levelPath.end()).first != cache.root.end()) continue;
+                prebuilt = cache.songData->Find(levelPath.lexically_relative(cache.root).generic_string());
+                if (prebuilt.has_value()) break;
+            }
+        }
+        // modification times and inodes don't survive copying, the sampled content does
+        if (!prebuilt.has_value() || !prebuilt->contentFingerprint.has_value()) return std::nullopt;
+        if (!contentFingerprint.has_value()) contentFingerprint = GetContentFingerprint(levelPath, entries);
+        if (contentFingerprint != prebuilt->contentFingerprint) return std::nullopt;
+
+        CachedSongData data;
+        data.sha1 = std::move(prebuilt->sha1);
+        data.songDuration = prebuilt->songDuration;
+        data.levelMetadata = std::move(prebuilt->levelMetadata);
+        return data;
+    }
+
+    /// @brief looks up the entry for a level and checks it against the fingerprints, replacing it with an empty one if it's stale
+    static CachedSongData LookupCachedInfo(std::filesystem::path const& levelPath, std::span<DirectoryEntry const> entries, uint64_t directoryFingerprint) {
+        CacheKey key(levelPath.string());
+        auto& shard = ShardOf(key);
+        bool useContentFingerprint = UsesContentFingerprint(levelPath);
+        uint32_t contentCheckGeneration = _contentCheckGeneration;
+        // sampling reads from every file, so it only happens when the entry can't be trusted without it
+        std::optional<uint64_t> contentFingerprint;
+        auto sampleContent = [&](){ if (useContentFingerprint) contentFingerprint = GetContentFingerprint(levelPath, entries); };
 
-        // make a new entry and set it in the map, and then return that
-        CachedSongData newCacheEntry;
-        newCacheEntry.directoryHash = directoryHash;
-        SetCachedInfo(levelPath, newCacheEntry);
+        std::optional<CachedSongData> cached;
+        bool contentChecked = false;
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            cached = shard.Find(key);
+            auto itr = shard.contentCheckGenerations.find(key);
+            contentChecked = itr != shard.contentCheckGenerations.end() && itr->second == contentCheckGeneration;
+        }
+
+        if (cached.has_value()) {
+            // if found and the fingerprint matches, we found a correct value. entries in content fingerprinted roots only skip sampling once they were sampled since the last revalidation
+            bool directoryMatches = !cached->legacyDirectoryHash.has_value() && cached->directoryFingerprint == directoryFingerprint;
+            if (directoryMatches && (!useContentFingerprint || contentChecked)) return *cached;
+            sampleContent();
+
+            // entries from before fingerprints are checked against the old hash one last time, so updating doesn't mean hashing every level again
+            if (!directoryMatches && cached->legacyDirectoryHash.has_value()) {
+                directoryMatches = GetLegacyDirectoryHash(levelPath) == cached->legacyDirectoryHash;
+            }
+
+            // where the content is fingerprinted it decides on its own, metadata there might change through a copy without the files changing, or the other way around
+            bool valid = directoryMatches;
+            if (useContentFingerprint) {
+                valid = contentFingerprint.has_value() && (cached->contentFingerprint.has_value() ? cached->contentFingerprint == contentFingerprint : directoryMatches);
+            }
+
+            if (valid) {
+                auto updateFingerprints = [&](CachedSongData& data){
+                    data.directoryFingerprint = directoryFingerprint;
+                    data.legacyDirectoryHash = std::nullopt;
+                    if (useContentFingerprint) data.contentFingerprint = contentFingerprint;
+                };
+                auto updated = *cached;
+                updateFingerprints(updated);
+
+                std::unique_lock<std::shared_mutex> lock(shard.mutex);
+                // unchanged entries stay out of the changes, so a refresh that only checked content doesn't rewrite them.
+                // the update is in place, so a hash or duration stored since the lookup isn't lost
+                if (updated != *cached) shard.Update(key, updateFingerprints);
+                if (useContentFingerprint) shard.contentCheckGenerations[key] = contentCheckGeneration;
+                return updated;
+            }
+        }
+
+        // make a new entry and set it in the map, and then return that. a level that was moved keeps what was cached for it under its old path,
+        // one that was copied in with a prebuilt cache takes what was prebuilt for it
+        if (!cached.has_value()) sampleContent();
+        auto foundEntry = FindRelocatedInfo(key, directoryFingerprint, contentFingerprint, useContentFingerprint);
+        if (!foundEntry.has_value()) foundEntry = FindPrebuiltInfo(levelPath, entries, contentFingerprint);
+        auto newCacheEntry = foundEntry.value_or(CachedSongData());
+        newCacheEntry.directoryFingerprint = directoryFingerprint;
+        newCacheEntry.legacyDirectoryHash = std::nullopt;
+        newCacheEntry.contentFingerprint = useContentFingerprint ? contentFingerprint : std::nullopt;
+        RememberFingerprints(key.path, newCacheEntry);
+
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.changedSongData[key] = { newCacheEntry };
+        if (useContentFingerprint) shard.contentCheckGenerations[key] = contentCheckGeneration;
         return newCacheEntry;
     }
 
+    std::optional<CachedSongData> GetCachedInfo(std::filesystem::path const& levelPath) {
+        std::vector<DirectoryEntry> entries;
+        if (!ListDirectory(levelPath, entries)) {
+            WARNING("Can't get cached info for {} because it could not be listed: {}", levelPath.string(), strerror(errno));
+            return std::nullopt;
+        }
+        return GetCachedInfo(levelPath, entries);
+    }
+
+    std::optional<CachedSongData> GetCachedInfo(std::filesystem::path const& levelPath, std::span<DirectoryEntry const> entries) {
+        WaitForLoad();
+        auto fingerprintOpt = Utils::GetDirectoryFingerprint(levelPath, entries);
+        if (!fingerprintOpt.has_value()) {
+            WARNING("Can't get cached info for {} because its fingerprint could not be calculated!", levelPath.string());
+            return std::nullopt;
+        }
+        return LookupCachedInfo(levelPath, entries, *fingerprintOpt);
+    }
+
+    void RevalidateCachedContent() {
+        _contentCheckGeneration++;
+    }
+
+    /// @brief SetCachedInfo without waiting for the cache to be loaded, for the load itself
+    static void StoreCachedInfo(std::filesystem::path const& levelPath, CachedSongData const& newInfo) {
+        CacheKey key(levelPath.string());
+        RememberFingerprints(key.path, newInfo);
+        auto& shard = ShardOf(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.changedSongData[std::move(key)] = { newInfo };
+    }
+
     void SetCachedInfo(std::filesystem::path const& levelPath, CachedSongData const& newInfo) {
-        std::unique_lock<std::shared_mutex> lock(_cacheMutex);
-        _cachedSongData[levelPath] = newInfo;
+        WaitForLoad();
+        StoreCachedInfo(levelPath, newInfo);
+    }
+
+    bool UpdateCachedInfo(std::filesystem::path const& levelPath, std::function<void(CachedSongData&)> const& update) {
+        WaitForLoad();
+        CacheKey key(levelPath.string());
+        auto& shard = ShardOf(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.Update(key, update);
     }
 
     void RemoveCachedInfo(std::filesystem::path const& levelPath) {
-        std::shared_lock<std::shared_mutex> shared_lock(_cacheMutex);
-        auto itr = _cachedSongData.find(levelPath);
-        if (itr == _cachedSongData.end()) return;
-        shared_lock.unlock();
+        WaitForLoad();
+        CacheKey key(levelPath.string());
+        auto& shard = ShardOf(key);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (!shard.Find(key).has_value()) return;
+        shard.contentCheckGenerations.erase(key);
+        shard.changedSongData[std::move(key)] = { std::nullopt };
+    }
+
+    void RemoveMissingCachedInfo(std::function<bool(std::string_view levelPath)> const& exists) {
+        TRACE_SCOPE("RemoveMissingCachedInfo");
+        WaitForLoad();
+        // keeps the saved cache from being replaced while its paths are walked
+        std::lock_guard<std::mutex> saveLock(_saveMutex);
+        std::vector<std::string> missing;
+        if (_savedSongData) {
+            _savedSongData->ForEachPath([&](std::string_view levelPath){
+                if (!exists(levelPath)) missing.emplace_back(levelPath);
+            });
+        }
+        for (auto& shard : _cacheShards) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto const& [key, change] : shard.changedSongData) {
+                if (change.data.has_value() && !exists(key.path)) missing.emplace_back(key.path);
+            }
+        }
 
-        std::unique_lock<std::shared_mutex> unique_lock(_cacheMutex);
-        _cachedSongData.erase(itr);
+        for (auto const& levelPath : missing) RemoveCachedInfo(levelPath);
+        if (!missing.empty()) DEBUG("Removed the cached info of {} levels that no longer exist", missing.size());
     }
 
     void ClearSongInfoCache() {
-        std::unique_lock<std::shared_mutex> lock(_cacheMutex);
-        _cachedSongData.clear();
+        WaitForLoad();
+        std::lock_guard<std::mutex> saveLock(_saveMutex);
+        ReplaceSavedSongData(nullptr, nullptr);
+        _savedCacheGeneration++;
+        // the files still hold the old entries, appending to them would bring those back on the next load
+        _rewriteRequired = true;
+        for (auto& shard : _cacheShards) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.contentCheckGenerations.clear();
+        }
+        std::lock_guard<std::mutex> lock(_fingerprintMutex);
+        _changedFingerprints.clear();
     }
 
     void SaveSongInfoCache() {
+        WaitForLoad();
+        std::unique_lock<std::mutex> saveLock(_saveMutex);
+        if (_rewriteRequired) {
+            CompactSongInfoCache(saveLock);
+            return;
+        }
+
+        CacheChanges changes;
+        for (auto& shard : _cacheShards) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto const& [key, change] : shard.changedSongData) {
+                if (!change.journaled) changes.emplace_back(key, change.data);
+            }
+        }
+        if (changes.empty()) return;
+
+        std::vector<std::pair<std::string, std::optional<CachedSongData>>> records;
+        records.reserve(changes.size());
+        for (auto const& [key, data] : changes) records.emplace_back(key.path, data);
+        if (!AppendSongCacheJournal(_journalPath, records)) return;
+        _journalRecordCount += records.size();
+
+        // anything changed again while appending stays unjournaled for the next save
+        for (auto const& [key, data] : changes) {
+            auto& shard = ShardOf(key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto itr = shard.changedSongData.find(key);
+            if (itr != shard.changedSongData.end() && itr->second.data == data) itr->second.journaled = true;
+        }
+
+        size_t compactThreshold = std::max(JOURNAL_COMPACT_MIN_RECORDS, (_savedSongData ? _savedSongData->get_Count() : 0) / 4);
+        if (_journalRecordCount > compactThreshold && !_compactionQueued && !_compacting) {
+            _compactionQueued = true;
+            GetThreadPool().Enqueue(TaskPriority::Low, [](){
+                std::unique_lock<std::mutex> saveLock(_saveMutex);
+                _compactionQueued = false;
+                CompactSongInfoCache(saveLock);
+            });
+        }
+    }
+
+    static bool ImportJsonCache(std::filesystem::path const& filePath);
+
+    /// @brief LoadSongInfoCache without waiting for a background load, for the background load itself
+    static bool LoadCacheFiles() {
+        TRACE_SCOPE("LoadSongInfoCache");
+        std::unique_lock<std::mutex> saveLock(_saveMutex);
+        auto savedSongData = std::make_shared<MappedSongCache>();
+        bool opened = savedSongData->Open(_cachePath);
+        ReplaceSavedSongData(opened ? std::move(savedSongData) : nullptr, nullptr);
+        _savedCacheGeneration++;
+
+        // the journal holds the changes made after the cache file was written, in order, so replaying it restores the latest state
+        auto replayed = ReplaySongCacheJournal(_journalPath, [](std::string_view levelPath, std::optional<CachedSongData> const& data){
+            CacheKey key { std::string(levelPath) };
+            if (data.has_value()) RememberFingerprints(key.path, *data);
+            auto& shard = ShardOf(key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.changedSongData[std::move(key)] = { data, true };
+        });
+        _journalRecordCount = replayed.value_or(0);
+        _rewriteRequired = false;
+        if (opened) INFO("Loaded {} cached song infos and {} journaled changes", _savedSongData->get_Count(), _journalRecordCount);
+        saveLock.unlock();
+
+        if (opened || _journalRecordCount > 0) return true;
+        // caches from before the binary format are imported once, the next save writes them in the new format
+        if (std::filesystem::exists(_jsonCachePath)) return ImportJsonCache(_jsonCachePath);
+        return false;
+    }
+
+    bool LoadSongInfoCache() {
+        WaitForLoad();
+        return LoadCacheFiles();
+    }
+
+    void LoadSongInfoCacheAsync() {
+        std::lock_guard<std::mutex> lock(_loadMutex);
+        if (_loadPending) return;
+        _loadPending = true;
+        // a plain thread, this starts before il2cpp is initialized and the cache never touches it
+        _loadFuture = std::async(std::launch::async, [](){
+            auto startTime = std::chrono::high_resolution_clock::now();
+            bool loaded = LoadCacheFiles();
+            _loadPending.store(false, std::memory_order_release);
+            DEBUG("Loaded the song cache in the background in {}ms", std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - startTime).count());
+            return loaded;
+        }).share();
+    }
+
+    void LoadPrebuiltSongCaches(std::span<std::filesystem::path const> roots) {
+        std::vector<PrebuiltSongCache> prebuiltSongCaches;
+        for (auto const& root : roots) {
+            auto filePath = root / PREBUILT_CACHE_FILE_NAME;
+            std::error_code error;
+            auto lastWriteTime = std::filesystem::last_write_time(filePath, error);
+            if (error) continue;
+
+            // caches that are mapped already are kept until a new one is copied over them
+            {
+                std::shared_lock<std::shared_mutex> lock(_prebuiltMutex);
+                auto itr = std::find_if(_prebuiltSongCaches.begin(), _prebuiltSongCaches.end(), [&root](auto const& cache){ return cache.root == root; });
+                if (itr != _prebuiltSongCaches.end() && itr->lastWriteTime == lastWriteTime) {
+                    prebuiltSongCaches.emplace_back(*itr);
+                    continue;
+                }
+            }
+
+            auto songData = std::make_shared<MappedSongCache>();
+            if (!songData->Open(filePath)) continue;
+            INFO("Found a prebuilt song cache of {} levels in {}", songData->get_Count(), root.string());
+            prebuiltSongCaches.emplace_back(PrebuiltSongCache{root, lastWriteTime, std::move(songData)});
+        }
+
+        std::unique_lock<std::shared_mutex> lock(_prebuiltMutex);
+        _prebuiltSongCaches = std::move(prebuiltSongCaches);
+    }
+
+    bool ExportSongInfoCacheJson(std::filesystem::path const& filePath) {
+        WaitForLoad();
+        std::unique_lock<std::mutex> saveLock(_saveMutex);
+        CacheChanges changes;
+        auto entries = CollectCachedInfo(changes);
+        saveLock.unlock();
+
         rapidjson::Document doc;
         doc.SetObject();
         auto& allocator = doc.GetAllocator();
-
-        std::shared_lock<std::shared_mutex> lock(_cacheMutex);
-        for (auto& [levelPath, data] : _cachedSongData) {
-            // skip saving levels that no longer exist
-            if (!std::filesystem::exists(levelPath)) continue;
-
+        for (auto const& [levelPath, data] : entries) {
             rapidjson::Value memberName(levelPath.c_str(), levelPath.size(), allocator);
             doc.AddMember(memberName, data.Serialize(allocator), allocator);
         }
-        lock.unlock();
 
         rapidjson::StringBuffer buff;
         rapidjson::Writer writer(buff);
-
-        std::ofstream cacheFile(_cachePath, std::ios::out);
         doc.Accept(writer);
 
+        std::ofstream cacheFile(filePath, std::ios::out);
         cacheFile.write(buff.GetString(), buff.GetLength());
+        return cacheFile.good();
     }
 
-    bool LoadSongInfoCache() {
-        // if the file doesn't exist, load should fail
-        if (!std::filesystem::exists(_cachePath)) return false;
+    bool ImportSongInfoCacheJson(std::filesystem::path const& filePath) {
+        WaitForLoad();
+        return ImportJsonCache(filePath);
+    }
+
+    static bool ImportJsonCache(std::filesystem::path const& filePath) {
+        // if the file doesn't exist, import should fail
+        if (!std::filesystem::exists(filePath)) return false;
 
         bool foundEverything = true;
-        auto text = utf8::utf16to8(ReadText(_cachePath));
+        auto text = utf8::utf16to8(ReadText(filePath));
 
         rapidjson::Document doc;
         doc.Parse(text);
+        if (!doc.IsObject()) return false;
         auto memberEnd = doc.MemberEnd();
 
-        std::unique_lock<std::shared_mutex> lock(_cacheMutex);
-        _cachedSongData.clear();
         for (auto itr = doc.MemberBegin(); itr != memberEnd; itr++) {
+            // levels that no longer exist are removed by the next refresh, which lists them anyway
             std::filesystem::path levelPath = itr->name.Get<std::string>();
-            // skip levels that no longer exist
-            if (!std::filesystem::exists(levelPath)) continue;
-            if (!_cachedSongData[levelPath].Deserialize(itr->value)) foundEverything = false;
+            CachedSongData data;
+            if (!data.Deserialize(itr->value)) foundEverything = false;
+            StoreCachedInfo(levelPath, data);
         }
-        lock.unlock();
 
         return foundEverything;
     }
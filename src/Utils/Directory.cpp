@@ -0,0 +1,192 @@
+#include "Utils/Directory.hpp"
+#include "logging.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <dirent.h>
+
+namespace SongCore::Utils {
+    /// @brief layout of the records getdents64 writes into our buffer
+    struct linux_dirent64 {
+        uint64_t d_ino;
+        int64_t d_off;
+        unsigned short d_reclen;
+        unsigned char d_type;
+        char d_name[];
+    };
+
+    /// @brief big enough to get most song folders and roots of a few hundred songs in a single syscall
+    static constexpr size_t GETDENTS_BUFFER_SIZE = 32 * 1024;
+
+    /// @brief files up to this size get prefetched entirely, bigger ones only at their head and tail
+    static constexpr off_t PREFETCH_WHOLE_FILE_SIZE = 1024 * 1024;
+    static constexpr off_t PREFETCH_EDGE_SIZE = 64 * 1024;
+
+    /// @brief folders that never contain levels we want, and that can be huge (autosaves of wip maps for example)
+    static constexpr std::array<std::string_view, 1> PRUNED_DIRECTORY_NAMES = { "autosaves" };
+
+    bool DirectoryEntry::IsDirectory() const {
+        return type == DT_DIR;
+    }
+
+    bool ListOpenDirectory(int fd, std::vector<DirectoryEntry>& out) {
+        alignas(linux_dirent64) char buffer[GETDENTS_BUFFER_SIZE];
+
+        while (true) {
+            long readBytes = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+            if (readBytes < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            if (readBytes == 0) break;
+
+            for (long offset = 0; offset < readBytes;) {
+                auto dirent = reinterpret_cast<linux_dirent64*>(buffer + offset);
+                offset += dirent->d_reclen;
+
+                std::string_view name(dirent->d_name);
+                if (name == "." || name == "..") continue;
+
+                auto& entry = out.emplace_back(DirectoryEntry{ std::string(name), dirent->d_ino, dirent->d_type });
+
+                // some filesystems don't fill in d_type, only then do we fall back to a stat
+                if (entry.type == DT_UNKNOWN) {
+                    struct stat st;
+                    if (fstatat(fd, entry.name.c_str(), &st, AT_SYMLINK_NOFOLLOW) == 0) {
+                        if (S_ISDIR(st.st_mode)) entry.type = DT_DIR;
+                        else if (S_ISREG(st.st_mode)) entry.type = DT_REG;
+                        else if (S_ISLNK(st.st_mode)) entry.type = DT_LNK;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    bool ListDirectory(int dirFd, std::string_view path, std::vector<DirectoryEntry>& out) {
+        int fd = openat(dirFd, std::string(path).c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) return false;
+
+        bool result = ListOpenDirectory(fd, out);
+        close(fd);
+        return result;
+    }
+
+    bool ListDirectory(std::filesystem::path const& directoryPath, std::vector<DirectoryEntry>& out) {
+        return ListDirectory(AT_FDCWD, directoryPath.native(), out);
+    }
+
+    std::optional<std::string_view> FindInfoDat(std::span<DirectoryEntry const> entries) {
+        std::optional<std::string_view> result = std::nullopt;
+        for (auto const& entry : entries) {
+            if (entry.IsDirectory()) continue;
+            // levels copied from windows can have any casing, an exact info.dat is still preferred just like the loader does
+            if (entry.name == "info.dat") return entry.name;
+            if (!result.has_value() && strcasecmp(entry.name.c_str(), "info.dat") == 0) result = entry.name;
+        }
+        return result;
+    }
+
+    std::optional<std::filesystem::path> FindInfoDatPath(std::filesystem::path const& levelPath) {
+        std::vector<DirectoryEntry> entries;
+        if (!ListDirectory(levelPath, entries)) return std::nullopt;
+        auto infoName = FindInfoDat(entries);
+        if (!infoName.has_value()) return std::nullopt;
+        return levelPath / *infoName;
+    }
+
+    uint64_t PrefetchDirectoryFiles(std::filesystem::path const& directoryPath, std::span<DirectoryEntry const> entries) {
+        int dirFd = open(directoryPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd < 0) return 0;
+
+        uint64_t totalSize = 0;
+
+        for (auto const& entry : entries) {
+            if (entry.type != DT_REG) continue;
+
+            int fd = openat(dirFd, entry.name.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) continue;
+
+            struct stat st;
+            if (fstat(fd, &st) == 0) {
+                totalSize += st.st_size;
+                if (st.st_size <= PREFETCH_WHOLE_FILE_SIZE) {
+                    posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+                } else {
+                    posix_fadvise(fd, 0, PREFETCH_EDGE_SIZE, POSIX_FADV_WILLNEED);
+                    posix_fadvise(fd, st.st_size - PREFETCH_EDGE_SIZE, PREFETCH_EDGE_SIZE, POSIX_FADV_WILLNEED);
+                }
+            }
+            close(fd);
+        }
+
+        close(dirFd);
+        return totalSize;
+    }
+
+    bool IsPrunedDirectory(std::string_view name) {
+        return std::find(PRUNED_DIRECTORY_NAMES.begin(), PRUNED_DIRECTORY_NAMES.end(), name) != PRUNED_DIRECTORY_NAMES.end();
+    }
+
+    /// @brief collects level folders in the opened directory fd
+    /// @param descend whether to look into subdirectories, false for symlinked directories so we can't end up in loops
+    static void CollectLevelFoldersFd(int fd, std::filesystem::path const& directoryPath, bool isRoot, bool descend, std::vector<std::filesystem::path>& out) {
+        std::vector<DirectoryEntry> entries;
+        if (!ListOpenDirectory(fd, entries)) {
+            WARNING("Failed to list directory {}: {}", directoryPath.string(), strerror(errno));
+            return;
+        }
+
+        bool isLevel = !isRoot && FindInfoDat(entries).has_value();
+        if (isLevel) out.emplace_back(directoryPath);
+        if (!descend) return;
+
+        bool hasSubdirectories = false;
+        for (auto const& entry : entries) {
+            bool isSymlinkedDirectory = false;
+            if (entry.type == DT_LNK) {
+                struct stat st;
+                isSymlinkedDirectory = fstatat(fd, entry.name.c_str(), &st, 0) == 0 && S_ISDIR(st.st_mode);
+            }
+
+            if (!entry.IsDirectory() && !isSymlinkedDirectory) continue;
+            // skip these without even opening them
+            if (IsPrunedDirectory(entry.name)) continue;
+            hasSubdirectories = true;
+
+            int childFd = openat(fd, entry.name.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (childFd < 0) {
+                WARNING("Failed to open directory {}: {}", (directoryPath / entry.name).string(), strerror(errno));
+                continue;
+            }
+
+            CollectLevelFoldersFd(childFd, directoryPath / entry.name, false, !isSymlinkedDirectory, out);
+            close(childFd);
+        }
+
+        // a folder without info.dat and without anything to descend into was most likely meant to be a song
+        if (!isRoot && !isLevel && !hasSubdirectories) {
+            WARNING("Possible song folder '{}' had no info.dat file! skipping...", directoryPath.string());
+        }
+    }
+
+    bool CollectLevelFolders(std::filesystem::path const& root, std::vector<std::filesystem::path>& out) {
+        int fd = open(root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (fd < 0) {
+            WARNING("Failed to open directory {}: {}", root.string(), strerror(errno));
+            return false;
+        }
+
+        CollectLevelFoldersFd(fd, root, true, true, out);
+        close(fd);
+        return true;
+    }
+}
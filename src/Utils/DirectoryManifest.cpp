@@ -0,0 +1,262 @@
+#include "Utils/DirectoryManifest.hpp"
+#include "Utils/Directory.hpp"
+#include "Utils/File.hpp"
+#include "logging.hpp"
+#include "config.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "beatsaber-hook/shared/config/rapidjson-utils.hpp"
+
+namespace SongCore::Utils {
+    /// @brief bump when the layout of the manifest changes, older manifests are then just discarded
+    static constexpr int MANIFEST_VERSION = 1;
+
+    struct ManifestEntry {
+        DirectoryState state;
+        /// @brief whether this directory was encountered since the last prune
+        bool walked = false;
+    };
+
+    static std::mutex _manifestMutex;
+    static std::unordered_map<std::string, ManifestEntry> _manifest;
+    static std::filesystem::path _manifestPath = SONGCORE_DATA_PATH "/DirectoryManifest.json";
+
+    /// @brief guards starting the background load and _loadFuture
+    static std::mutex _loadMutex;
+    static std::shared_future<bool> _loadFuture;
+
+    /// @brief waits for the background load if one was started, so it can't replace what was walked since
+    static void WaitForLoad() {
+        std::unique_lock<std::mutex> lock(_loadMutex);
+        auto loadFuture = _loadFuture;
+        lock.unlock();
+        if (loadFuture.valid()) loadFuture.wait();
+    }
+
+    static int64_t GetModifiedTime(struct stat const& st) {
+        return static_cast<int64_t>(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec;
+    }
+
+    /// @brief walks a single directory, has to be called with the manifest mutex held
+    static void WalkDirectory(int parentFd, char const* name, std::filesystem::path const& directoryPath, bool isRoot, bool descend, bool relistAll, std::vector<std::filesystem::path>& levels, std::vector<std::filesystem::path>& changedLevels) {
+        struct stat st;
+        // if the directory is gone it just won't be marked as walked, and thus gets pruned
+        if (fstatat(parentFd, name, &st, 0) != 0 || !S_ISDIR(st.st_mode)) return;
+
+        auto [itr, inserted] = _manifest.try_emplace(directoryPath.string());
+        auto& entry = itr->second;
+        entry.walked = true;
+
+        bool unchanged = !relistAll && !inserted &&
+            entry.state.device == st.st_dev &&
+            entry.state.inode == st.st_ino &&
+            entry.state.modifiedTime == GetModifiedTime(st);
+
+        int fd = -1;
+        if (!unchanged) {
+            fd = openat(parentFd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            std::vector<DirectoryEntry> entries;
+            if (fd < 0 || !ListOpenDirectory(fd, entries)) {
+                WARNING("Failed to list directory {}: {}", directoryPath.string(), strerror(errno));
+                if (fd >= 0) close(fd);
+                _manifest.erase(itr);
+                return;
+            }
+
+            DirectoryState newState {
+                .device = static_cast<uint64_t>(st.st_dev),
+                .inode = static_cast<uint64_t>(st.st_ino),
+                .modifiedTime = GetModifiedTime(st),
+                .isLevel = !isRoot && FindInfoDat(entries).has_value(),
+                .subdirectories = {}
+            };
+
+            for (auto const& directoryEntry : entries) {
+                bool isSymlinkedDirectory = false;
+                if (directoryEntry.type == DT_LNK) {
+                    struct stat linkSt;
+                    isSymlinkedDirectory = fstatat(fd, directoryEntry.name.c_str(), &linkSt, 0) == 0 && S_ISDIR(linkSt.st_mode);
+                }
+
+                if (!directoryEntry.IsDirectory() && !isSymlinkedDirectory) continue;
+                if (IsPrunedDirectory(directoryEntry.name)) continue;
+                newState.subdirectories.emplace_back(DirectoryState::Subdirectory{ directoryEntry.name, isSymlinkedDirectory });
+            }
+
+            if (!isRoot && !newState.isLevel && newState.subdirectories.empty()) {
+                WARNING("Possible song folder '{}' had no info.dat file! skipping...", directoryPath.string());
+            }
+
+            if (newState.isLevel) changedLevels.emplace_back(directoryPath);
+            entry.state = std::move(newState);
+        }
+
+        if (entry.state.isLevel) levels.emplace_back(directoryPath);
+
+        if (descend && !entry.state.subdirectories.empty()) {
+            if (fd < 0) fd = openat(parentFd, name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (fd < 0) {
+                WARNING("Failed to open directory {}: {}", directoryPath.string(), strerror(errno));
+                return;
+            }
+
+            // references into an unordered_map stay valid while it grows, so iterating our own entry is fine
+            for (auto const& subdirectory : entry.state.subdirectories) {
+                WalkDirectory(fd, subdirectory.name.c_str(), directoryPath / subdirectory.name, false, !subdirectory.isSymlink, relistAll, levels, changedLevels);
+            }
+        }
+
+        if (fd >= 0) close(fd);
+    }
+
+    void CollectLevelFoldersIncremental(std::filesystem::path const& root, bool relistAll, std::vector<std::filesystem::path>& levels, std::vector<std::filesystem::path>& changedLevels) {
+        WaitForLoad();
+        std::lock_guard<std::mutex> lock(_manifestMutex);
+        WalkDirectory(AT_FDCWD, root.c_str(), root, true, true, relistAll, levels, changedLevels);
+    }
+
+    void PruneDirectoryManifest() {
+        WaitForLoad();
+        std::lock_guard<std::mutex> lock(_manifestMutex);
+        std::erase_if(_manifest, [](auto const& pair){ return !pair.second.walked; });
+        for (auto& [path, entry] : _manifest) entry.walked = false;
+    }
+
+    void ClearDirectoryManifest() {
+        WaitForLoad();
+        std::lock_guard<std::mutex> lock(_manifestMutex);
+        _manifest.clear();
+    }
+
+    void SaveDirectoryManifest() {
+        rapidjson::Document doc;
+        doc.SetObject();
+        auto& allocator = doc.GetAllocator();
+
+        rapidjson::Value directories;
+        directories.SetObject();
+
+        WaitForLoad();
+        std::unique_lock<std::mutex> lock(_manifestMutex);
+        for (auto& [directoryPath, entry] : _manifest) {
+            auto& state = entry.state;
+            rapidjson::Value val;
+            val.SetObject();
+
+            val.AddMember("device", state.device, allocator);
+            val.AddMember("inode", state.inode, allocator);
+            val.AddMember("modifiedTime", state.modifiedTime, allocator);
+            val.AddMember("isLevel", state.isLevel, allocator);
+
+            rapidjson::Value subdirectories;
+            subdirectories.SetArray();
+            rapidjson::Value symlinks;
+            symlinks.SetArray();
+            for (auto const& subdirectory : state.subdirectories) {
+                auto& target = subdirectory.isSymlink ? symlinks : subdirectories;
+                target.PushBack(rapidjson::Value(subdirectory.name.c_str(), subdirectory.name.size(), allocator), allocator);
+            }
+            val.AddMember("subdirectories", subdirectories, allocator);
+            val.AddMember("symlinks", symlinks, allocator);
+
+            directories.AddMember(rapidjson::Value(directoryPath.c_str(), directoryPath.size(), allocator), val, allocator);
+        }
+        lock.unlock();
+
+        doc.AddMember("version", MANIFEST_VERSION, allocator);
+        doc.AddMember("directories", directories, allocator);
+
+        rapidjson::StringBuffer buff;
+        rapidjson::Writer writer(buff);
+        doc.Accept(writer);
+
+        // a manifest cut off by a crash would just be discarded, but then the next refresh has to list everything again
+        if (!WriteFileAtomically(_manifestPath, std::span(reinterpret_cast<uint8_t const*>(buff.GetString()), buff.GetLength()))) {
+            ERROR("Could not write the directory manifest to {}: {}", _manifestPath.string(), strerror(errno));
+        }
+    }
+
+    bool LoadDirectoryManifest() {
+        if (!std::filesystem::exists(_manifestPath)) return false;
+
+        std::ifstream manifestFile(_manifestPath, std::ios::in);
+        std::string text((std::istreambuf_iterator<char>(manifestFile)), std::istreambuf_iterator<char>());
+
+        rapidjson::Document doc;
+        doc.Parse(text);
+        if (doc.HasParseError() || !doc.IsObject()) return false;
+
+        auto versionItr = doc.FindMember("version");
+        if (versionItr == doc.MemberEnd() || !versionItr->value.IsInt() || versionItr->value.GetInt() != MANIFEST_VERSION) return false;
+
+        auto directoriesItr = doc.FindMember("directories");
+        if (directoriesItr == doc.MemberEnd() || !directoriesItr->value.IsObject()) return false;
+
+        bool foundEverything = true;
+        std::lock_guard<std::mutex> lock(_manifestMutex);
+        _manifest.clear();
+        for (auto itr = directoriesItr->value.MemberBegin(); itr != directoriesItr->value.MemberEnd(); itr++) {
+            auto const& val = itr->value;
+            auto deviceItr = val.FindMember("device");
+            auto inodeItr = val.FindMember("inode");
+            auto modifiedTimeItr = val.FindMember("modifiedTime");
+            auto isLevelItr = val.FindMember("isLevel");
+            auto subdirectoriesItr = val.FindMember("subdirectories");
+            auto symlinksItr = val.FindMember("symlinks");
+            auto memberEnd = val.MemberEnd();
+
+            if (deviceItr == memberEnd || !deviceItr->value.IsUint64() ||
+                inodeItr == memberEnd || !inodeItr->value.IsUint64() ||
+                modifiedTimeItr == memberEnd || !modifiedTimeItr->value.IsInt64() ||
+                isLevelItr == memberEnd || !isLevelItr->value.IsBool() ||
+                subdirectoriesItr == memberEnd || !subdirectoriesItr->value.IsArray() ||
+                symlinksItr == memberEnd || !symlinksItr->value.IsArray()) {
+                foundEverything = false;
+                continue;
+            }
+
+            DirectoryState state {
+                .device = deviceItr->value.GetUint64(),
+                .inode = inodeItr->value.GetUint64(),
+                .modifiedTime = modifiedTimeItr->value.GetInt64(),
+                .isLevel = isLevelItr->value.GetBool(),
+                .subdirectories = {}
+            };
+
+            for (auto const& name : subdirectoriesItr->value.GetArray()) {
+                if (name.IsString()) state.subdirectories.emplace_back(DirectoryState::Subdirectory{ name.Get<std::string>(), false });
+            }
+            for (auto const& name : symlinksItr->value.GetArray()) {
+                if (name.IsString()) state.subdirectories.emplace_back(DirectoryState::Subdirectory{ name.Get<std::string>(), true });
+            }
+
+            _manifest[itr->name.Get<std::string>()].state = std::move(state);
+        }
+
+        return foundEverything;
+    }
+
+    void LoadDirectoryManifestAsync() {
+        std::lock_guard<std::mutex> lock(_loadMutex);
+        if (_loadFuture.valid()) return;
+        // a plain thread like the song cache load, this starts before il2cpp is initialized
+        _loadFuture = std::async(std::launch::async, [](){
+            auto startTime = std::chrono::high_resolution_clock::now();
+            bool loaded = LoadDirectoryManifest();
+            DEBUG("Loaded the directory manifest in the background in {}ms", std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - startTime).count());
+            return loaded;
+        }).share();
+    }
+}
@@ -10,6 +10,9 @@
 #include <vector>
 #include <filesystem>
 #include <fstream>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace SongCore::Utils {
     std::vector<std::filesystem::path> GetFolders(std::filesystem::path path) {
@@ -80,4 +83,36 @@ namespace SongCore::Utils {
         fileStream.read(data, size_out);
         return data;
     }
+
+    bool WriteAll(int fd, uint8_t const* data, size_t size) {
+        size_t offset = 0;
+        while (offset < size) {
+            auto written = write(fd, data + offset, size - offset);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return false;
+            offset += written;
+        }
+        return true;
+    }
+
+    bool WriteFileAtomically(std::filesystem::path const& filePath, std::span<uint8_t const> data) {
+        auto tempPath = filePath;
+        tempPath += ".tmp";
+        int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) return false;
+
+        // synced before the rename, otherwise a crash could leave the new name pointing at data that never made it to storage
+        bool written = WriteAll(fd, data.data(), data.size()) && fsync(fd) == 0;
+        int error = errno;
+        if (close(fd) != 0 && written) {
+            written = false;
+            error = errno;
+        }
+        if (written && rename(tempPath.c_str(), filePath.c_str()) == 0) return true;
+        if (written) error = errno;
+
+        unlink(tempPath.c_str());
+        errno = error;
+        return false;
+    }
 }
@@ -0,0 +1,65 @@
+#include "Utils/FileHasher.hpp"
+#include "logging.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <unistd.h>
+
+namespace SongCore::Utils {
+    /// @brief size of a single read, big enough that the syscall and fuse overhead of /sdcard disappears next to the hashing itself
+    static constexpr size_t READ_BLOCK_SIZE = 1024 * 1024;
+    static constexpr size_t READ_BLOCK_ALIGNMENT = 4096;
+
+    /// @brief each hashing thread reuses its own block, so hashing a level doesn't allocate per file
+    static uint8_t* GetReadBlock() {
+        struct AlignedDeleter { void operator()(uint8_t* ptr) const { operator delete[](ptr, std::align_val_t(READ_BLOCK_ALIGNMENT)); } };
+        thread_local std::unique_ptr<uint8_t[], AlignedDeleter> block(new (std::align_val_t(READ_BLOCK_ALIGNMENT)) uint8_t[READ_BLOCK_SIZE]);
+        return block.get();
+    }
+
+    bool FileHasher::AddFile(std::filesystem::path const& filePath) {
+        // files are read instead of mapped, a mapped file that gets truncated while hashing (like a level being deleted) would crash with SIGBUS
+        int fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            ERROR("Could not open {} for hashing: {}", filePath.string(), strerror(errno));
+            return false;
+        }
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        auto block = GetReadBlock();
+        bool success = true;
+        while (true) {
+            auto bytesRead = read(fd, block, READ_BLOCK_SIZE);
+            if (bytesRead < 0) {
+                if (errno == EINTR) continue;
+                ERROR("Could not read {} for hashing: {}", filePath.string(), strerror(errno));
+                success = false;
+                break;
+            }
+            if (bytesRead == 0) break;
+
+            _sha1.Update(block, bytesRead);
+            _bytesHashed += bytesRead;
+        }
+
+        close(fd);
+        return success;
+    }
+
+    std::string FileHasher::FinalHex() {
+        static constexpr char hexChars[] = "0123456789ABCDEF";
+
+        auto digest = _sha1.Final();
+
+        std::string hex;
+        hex.reserve(digest.size() * 2);
+        for (auto b : digest) {
+            hex.push_back(hexChars[b >> 4]);
+            hex.push_back(hexChars[b & 0xF]);
+        }
+        return hex;
+    }
+}
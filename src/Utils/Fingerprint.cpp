@@ -0,0 +1,157 @@
+#include "Utils/Fingerprint.hpp"
+#include "Utils/XXHash64.hpp"
+#include "logging.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SongCore::Utils {
+    /// @brief size of the blocks sampled from a file for its content fingerprint
+    static constexpr size_t CONTENT_SAMPLE_SIZE = 4096;
+    /// @brief amount of blocks sampled evenly spaced between the head and tail of a file, smaller files are read completely
+    static constexpr size_t CONTENT_SAMPLE_COUNT = 4;
+
+    std::optional<uint64_t> GetDirectoryFingerprint(std::filesystem::path const& directoryPath, std::span<DirectoryEntry const> entries) {
+        int dirFd = open(directoryPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd < 0) {
+            WARNING("Failed to open directory {} for its fingerprint: {}", directoryPath.string(), strerror(errno));
+            return std::nullopt;
+        }
+
+        // sorted on name, so the fingerprint doesn't depend on the order the filesystem lists files in
+        std::vector<DirectoryEntry const*> files;
+        files.reserve(entries.size());
+        for (auto const& entry : entries) {
+            // the level hash file is written for the fingerprint, so it can't be part of it
+            if (!entry.IsDirectory() && entry.name != LEVEL_HASH_FILE_NAME) files.emplace_back(&entry);
+        }
+        std::sort(files.begin(), files.end(), [](auto a, auto b){ return a->name < b->name; });
+
+        XXHash64 hasher;
+        bool hasFile = false;
+        for (auto entry : files) {
+            struct stat st;
+            if (fstatat(dirFd, entry->name.c_str(), &st, 0) != 0 || !S_ISREG(st.st_mode)) continue;
+            hasFile = true;
+
+            // the terminator is hashed as well, so a name can't run into the fields after it
+            hasher.Update(entry->name.c_str(), entry->name.size() + 1);
+            uint64_t fields[] = {
+                static_cast<uint64_t>(st.st_size),
+                static_cast<uint64_t>(st.st_mtim.tv_sec) * 1'000'000'000ULL + static_cast<uint64_t>(st.st_mtim.tv_nsec),
+                entry->inode
+            };
+            hasher.Update(fields, sizeof(fields));
+        }
+        close(dirFd);
+
+        if (!hasFile) return std::nullopt;
+        return hasher.Digest();
+    }
+
+    /// @brief adds the bytes in the range of the file to the hasher
+    /// @return false if the file could not be read
+    static bool HashFileRange(int fd, uint64_t offset, uint64_t size, XXHash64& hasher) {
+        std::array<uint8_t, CONTENT_SAMPLE_SIZE> buffer;
+        while (size > 0) {
+            auto bytesRead = pread(fd, buffer.data(), std::min<uint64_t>(size, buffer.size()), offset);
+            if (bytesRead < 0 && errno == EINTR) continue;
+            // a file that shrunk while reading changes the fingerprint through its size anyway
+            if (bytesRead <= 0) return bytesRead == 0;
+
+            hasher.Update(buffer.data(), bytesRead);
+            offset += bytesRead;
+            size -= bytesRead;
+        }
+        return true;
+    }
+
+    std::optional<uint64_t> GetContentFingerprint(std::filesystem::path const& directoryPath, std::span<DirectoryEntry const> entries) {
+        int dirFd = open(directoryPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd < 0) {
+            WARNING("Failed to open directory {} for its content fingerprint: {}", directoryPath.string(), strerror(errno));
+            return std::nullopt;
+        }
+
+        std::vector<DirectoryEntry const*> files;
+        files.reserve(entries.size());
+        for (auto const& entry : entries) {
+            // the level hash file is written for the fingerprint, so it can't be part of it
+            if (!entry.IsDirectory() && entry.name != LEVEL_HASH_FILE_NAME) files.emplace_back(&entry);
+        }
+        std::sort(files.begin(), files.end(), [](auto a, auto b){ return a->name < b->name; });
+
+        XXHash64 hasher;
+        bool hasFile = false;
+        bool success = true;
+        for (auto entry : files) {
+            int fd = openat(dirFd, entry->name.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) continue;
+
+            struct stat st;
+            if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+                close(fd);
+                continue;
+            }
+            hasFile = true;
+
+            uint64_t size = st.st_size;
+            hasher.Update(entry->name.c_str(), entry->name.size() + 1);
+            hasher.Update(&size, sizeof(size));
+
+            if (size <= (CONTENT_SAMPLE_COUNT + 2) * CONTENT_SAMPLE_SIZE) {
+                success = HashFileRange(fd, 0, size, hasher);
+            } else {
+                // head and tail catch most edits to the json files, the blocks in between catch audio being swapped for a same length encode
+                success = HashFileRange(fd, 0, CONTENT_SAMPLE_SIZE, hasher);
+                for (size_t i = 1; success && i <= CONTENT_SAMPLE_COUNT; i++) {
+                    uint64_t offset = size * i / (CONTENT_SAMPLE_COUNT + 1) / CONTENT_SAMPLE_SIZE * CONTENT_SAMPLE_SIZE;
+                    success = HashFileRange(fd, offset, CONTENT_SAMPLE_SIZE, hasher);
+                }
+                success = success && HashFileRange(fd, size - CONTENT_SAMPLE_SIZE, CONTENT_SAMPLE_SIZE, hasher);
+            }
+            close(fd);
+
+            if (!success) {
+                WARNING("Failed to read {} for its content fingerprint: {}", (directoryPath / entry->name).string(), strerror(errno));
+                break;
+            }
+        }
+        close(dirFd);
+
+        if (!hasFile || !success) return std::nullopt;
+        return hasher.Digest();
+    }
+
+    std::optional<int> GetLegacyDirectoryHash(std::filesystem::path const& directoryPath) {
+        if (!std::filesystem::is_directory(directoryPath)) return std::nullopt;
+
+        int hash = 0;
+        bool hasFile = false;
+        std::error_code error_code;
+        auto dir_iter = std::filesystem::directory_iterator(directoryPath, error_code);
+
+        if (error_code) {
+            WARNING("Failed to get directory iterator for directory {}: {}", directoryPath.string(), error_code.message());
+            return std::nullopt;
+        }
+
+        for (auto const& entry : dir_iter) {
+            if(!entry.is_directory()) {
+                hasFile = true;
+                hash ^= entry.file_size() ^ std::chrono::duration_cast<std::chrono::seconds>(std::filesystem::last_write_time(entry).time_since_epoch()).count();
+            }
+        }
+
+        if(!hasFile)
+            return std::nullopt;
+        return hash;
+    }
+}
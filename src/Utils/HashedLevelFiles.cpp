@@ -0,0 +1,76 @@
+#include "Utils/HashedLevelFiles.hpp"
+#include "logging.hpp"
+
+#include <string>
+
+namespace SongCore::Utils {
+    /// @brief member of a json object, or nullptr if it isn't there
+    static rapidjson::Value const* MemberOf(rapidjson::Value const& value, char const* name) {
+        if (!value.IsObject()) return nullptr;
+        auto itr = value.FindMember(name);
+        return itr != value.MemberEnd() ? &itr->value : nullptr;
+    }
+
+    /// @brief array member of a json object, or nullptr if it isn't there or isn't an array
+    static rapidjson::Value const* ArrayOf(rapidjson::Value const& value, char const* name) {
+        auto member = MemberOf(value, name);
+        return member && member->IsArray() ? member : nullptr;
+    }
+
+    /// @brief path of a file named by a string member of a json object, or nullopt if it isn't there or isn't a string
+    static std::optional<std::filesystem::path> FilePath(std::filesystem::path const& levelPath, rapidjson::Value const& value, char const* name) {
+        auto member = MemberOf(value, name);
+        if (!member || !member->IsString()) return std::nullopt;
+        return levelPath / member->Get<std::string>();
+    }
+
+    std::vector<std::filesystem::path> GetHashedLevelFilesV2(std::filesystem::path const& levelPath, std::filesystem::path const& infoPath, rapidjson::Value const& info) {
+        std::vector<std::filesystem::path> files { infoPath };
+        auto difficultyBeatmapSets = ArrayOf(info, "_difficultyBeatmapSets");
+        if (!difficultyBeatmapSets) return files;
+
+        for (auto const& difficultyBeatmapSet : difficultyBeatmapSets->GetArray()) {
+            auto difficultyBeatmaps = ArrayOf(difficultyBeatmapSet, "_difficultyBeatmaps");
+            if (!difficultyBeatmaps) continue;
+            for (auto const& difficultyBeatmap : difficultyBeatmaps->GetArray()) {
+                auto diffPath = FilePath(levelPath, difficultyBeatmap, "_beatmapFilename");
+                if (!diffPath.has_value()) continue;
+                if (!std::filesystem::exists(*diffPath)) {
+                    ERROR("GetCustomLevelHash File {} did not exist", diffPath->string());
+                    continue;
+                }
+                files.emplace_back(std::move(*diffPath));
+            }
+        }
+        return files;
+    }
+
+    std::optional<std::vector<std::filesystem::path>> GetHashedLevelFilesV4(std::filesystem::path const& levelPath, std::filesystem::path const& infoPath, rapidjson::Value const& info) {
+        auto audio = MemberOf(info, "audio");
+        auto audioPath = audio ? FilePath(levelPath, *audio, "audioDataFilename") : std::nullopt;
+        if (!audioPath.has_value() || !std::filesystem::exists(*audioPath)) return std::nullopt;
+
+        std::vector<std::filesystem::path> files { infoPath, std::move(*audioPath) };
+        auto difficultyBeatmaps = ArrayOf(info, "difficultyBeatmaps");
+        if (!difficultyBeatmaps) return files;
+
+        for (auto const& difficultyBeatmap : difficultyBeatmaps->GetArray()) {
+            auto diffPath = FilePath(levelPath, difficultyBeatmap, "beatmapDataFilename");
+            if (!diffPath.has_value()) continue;
+            if (!std::filesystem::exists(*diffPath)) {
+                ERROR("GetCustomLevelHash File {} did not exist", diffPath->string());
+                continue;
+            }
+            files.emplace_back(std::move(*diffPath));
+
+            auto lightPath = FilePath(levelPath, difficultyBeatmap, "lightshowDataFilename");
+            if (!lightPath.has_value()) continue;
+            if (!std::filesystem::exists(*lightPath)) {
+                ERROR("GetCustomLevelHash Lighting File {} did not exist", lightPath->string());
+                continue;
+            }
+            files.emplace_back(std::move(*lightPath));
+        }
+        return files;
+    }
+}
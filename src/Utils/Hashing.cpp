@@ -1,77 +1,91 @@
 #include "Utils/Hashing.hpp"
 #include "CustomJSONData.hpp"
 #include "Utils/Cache.hpp"
+#include "Utils/Directory.hpp"
+#include "Utils/File.hpp"
+#include "Utils/FileHasher.hpp"
+#include "Utils/HashedLevelFiles.hpp"
+#include "Utils/HashingService.hpp"
 #include "logging.hpp"
-#include <filesystem>
+#include "tracing.hpp"
+#include "config.hpp"
+#include "paper/shared/utfcpp/source/utf8.h"
 
-#include "libcryptopp/shared/sha.h"
-#include "libcryptopp/shared/hex.h"
-#include "libcryptopp/shared/files.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
 
 using namespace GlobalNamespace;
-using namespace CryptoPP;
 
 namespace SongCore::Utils {
-    std::optional<std::string> GetCustomLevelHash(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData) {
-        auto start = std::chrono::high_resolution_clock::now();
-        std::string hashHex;
-
-        // get cached info
-        auto cacheData = GetCachedInfo(levelPath);
-        if(!cacheData.has_value()) return std::nullopt;
-
-        if (cacheData->sha1.has_value()) {
-            DEBUG("GetCustomLevelHash Stop Result {} from cache", *cacheData->sha1);
-            return *cacheData->sha1;
+    /// @brief sha1 of the files of a level in order
+    static std::optional<std::string> HashFiles(std::span<std::filesystem::path const> files, uint64_t& bytesHashed) {
+        FileHasher hasher;
+        for (auto const& file : files) {
+            if (!hasher.AddFile(file)) return std::nullopt;
         }
+        bytesHashed = hasher.BytesHashed;
+        return hasher.FinalHex();
+    }
 
-        auto infoPath = levelPath / "info.dat";
-        if(!std::filesystem::exists(infoPath)) {
-            infoPath = levelPath / "Info.dat";
-            if(!std::filesystem::exists(infoPath)) return std::nullopt;
+    /// @brief parses the info.dat for the list of files to hash, the prebuilder lists them from the same utf8 json so the two can't disagree.
+    /// Only a level that isn't hashed yet gets here, and its info.dat is read to be hashed right after anyway
+    static bool ParseInfoDat(std::filesystem::path const& infoPath, rapidjson::Document& info) {
+        info.Parse(utf8::utf16to8(ReadText(infoPath)));
+        if (info.HasParseError() || !info.IsObject()) {
+            ERROR("GetCustomLevelHash {} is not a json object", infoPath.string());
+            return false;
         }
+        return true;
+    }
 
-        SHA1 hashType;
-        std::string hashResult;
-        HashFilter hashFilter(hashType, new StringSink(hashResult));
-
-        FileSource fs(infoPath.c_str(), false);
-        fs.Attach(new Redirector(hashFilter));
-        fs.Pump(LWORD_MAX);
-        fs.Detach();
-        for(auto val : saveData->difficultyBeatmapSets) {
-            if (!val) continue;
-            auto difficultyBeatmaps = val->difficultyBeatmaps;
-            if (!difficultyBeatmaps) continue;
-            for(auto difficultyBeatmap : difficultyBeatmaps) {
-                auto diffPath = levelPath / static_cast<std::string>(difficultyBeatmap->beatmapFilename);
-                if(!std::filesystem::exists(diffPath)) {
-                    ERROR("GetCustomLevelHash File {} did not exist", diffPath.string());
-                    continue;
-                }
-                FileSource fs(diffPath.c_str(), false);
-                fs.Attach(new Redirector(hashFilter));
-                fs.Pump(LWORD_MAX);
-                fs.Detach();
+    /// @brief hashes the files of a level and caches the hash, unless the level hash file has one for the folder as it is now
+    /// @param files the files the hash is made of, in order
+    static std::optional<std::string> HashLevelFiles(std::filesystem::path const& levelPath, std::vector<std::filesystem::path> files) {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        if (auto fileHash = ReadLevelHashFile(levelPath)) {
+            if (!config.verifyLevelHashFiles) {
+                UpdateCachedInfo(levelPath, [&fileHash](CachedSongData& data){ data.sha1 = *fileHash; });
+                DEBUG("GetCustomLevelHash Stop Result {} from {}", *fileHash, LEVEL_HASH_FILE_NAME);
+                return fileHash;
             }
-        }
 
-        hashFilter.MessageEnd();
+            // the level uses the hash right away, it's only cached once its files were hashed in the background and agree with it
+            uint64_t cost = 0;
+            for (auto const& file : files) {
+                std::error_code error;
+                auto size = std::filesystem::file_size(file, error);
+                if (!error) cost += size;
+            }
+            GetHashingService().Enqueue(levelPath, HashPriority::Background, cost, [levelPath, files = std::move(files), expected = *fileHash](){
+                TRACE_SCOPE("VerifyLevelHashFile");
+                uint64_t bytesHashed = 0;
+                auto hashHex = HashFiles(files, bytesHashed);
+                if (!hashHex.has_value()) return;
+                if (*hashHex != expected) WARNING("{} of {} says its hash is {}, but its files hash to {}", LEVEL_HASH_FILE_NAME, levelPath.string(), expected, *hashHex);
+                UpdateCachedInfo(levelPath, [&hashHex](CachedSongData& data){ data.sha1 = *hashHex; });
+            });
+            DEBUG("GetCustomLevelHash Stop Result {} from {}, verifying it in the background", *fileHash, LEVEL_HASH_FILE_NAME);
+            return fileHash;
+        }
 
-        HexEncoder hexEncoder(new StringSink(hashHex));
-        hexEncoder.Put((const byte*)hashResult.data(), hashResult.size());
+        uint64_t bytesHashed = 0;
+        auto hashHex = HashFiles(files, bytesHashed);
+        if (!hashHex.has_value()) return std::nullopt;
 
-        cacheData->sha1 = hashHex;
-        SetCachedInfo(levelPath, *cacheData);
+        UpdateCachedInfo(levelPath, [&hashHex](CachedSongData& data){ data.sha1 = *hashHex; });
 
-        std::chrono::milliseconds duration = duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
-        DEBUG("GetCustomLevelHash Stop Result {} Time {}", hashHex, duration.count());
+        auto elapsed = std::chrono::high_resolution_clock::now() - start;
+        std::chrono::milliseconds duration = duration_cast<std::chrono::milliseconds>(elapsed);
+        auto seconds = std::chrono::duration<float>(elapsed).count();
+        DEBUG("GetCustomLevelHash Stop Result {} Time {} ({:.1f} MB/s over {} bytes)", *hashHex, duration.count(), seconds > 0 ? bytesHashed / seconds / (1024 * 1024) : 0.0f, bytesHashed);
         return hashHex;
     }
 
-    std::optional<std::string> GetCustomLevelHash(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData) {
-        auto start = std::chrono::high_resolution_clock::now();
-        std::string hashHex;
+    std::optional<std::string> GetCustomLevelHash(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomLevelInfoSaveDataV2* saveData) {
+        TRACE_SCOPE("GetCustomLevelHash");
 
         // get cached info
         auto cacheData = GetCachedInfo(levelPath);
@@ -82,90 +96,36 @@ namespace SongCore::Utils {
             return *cacheData->sha1;
         }
 
-        auto infoPath = levelPath / "info.dat";
-        if(!std::filesystem::exists(infoPath)) {
-            infoPath = levelPath / "Info.dat";
-            if(!std::filesystem::exists(infoPath)) return std::nullopt;
-        }
-
-        auto audioPath = levelPath / static_cast<std::string>(saveData->audio.audioDataFilename);
-        if(!std::filesystem::exists(audioPath)) {
-            return std::nullopt;
-        }
+        auto infoPath = FindInfoDatPath(levelPath);
+        if(!infoPath.has_value()) return std::nullopt;
 
-        SHA1 hashType;
-        std::string hashResult;
-        HashFilter hashFilter(hashType, new StringSink(hashResult));
-
-        FileSource fs(infoPath.c_str(), false);
-        fs.Attach(new Redirector(hashFilter));
-        fs.Pump(LWORD_MAX);
-        fs.Detach();
-
-        FileSource fsAudio(audioPath.c_str(), false);
-        fsAudio.Attach(new Redirector(hashFilter));
-        fsAudio.Pump(LWORD_MAX);
-        fsAudio.Detach();
-
-        for(auto val : saveData->difficultyBeatmaps) {
-            if (!val) continue;
-            
-            auto diffPath = levelPath / static_cast<std::string>(val->beatmapDataFilename);
-            if(!std::filesystem::exists(diffPath)) {
-                ERROR("GetCustomLevelHash File {} did not exist", diffPath.string());
-                continue;
-            }
-            FileSource fs(diffPath.c_str(), false);
-            fs.Attach(new Redirector(hashFilter));
-            fs.Pump(LWORD_MAX);
-            fs.Detach();
-
-            auto lightPath = levelPath / static_cast<std::string>(val->lightshowDataFilename);
-            if(!std::filesystem::exists(lightPath)) {
-                ERROR("GetCustomLevelHash Lighting File {} did not exist", diffPath.string());
-                continue;
-            }
-            FileSource fsLight(lightPath.c_str(), false);
-            fsLight.Attach(new Redirector(hashFilter));
-            fsLight.Pump(LWORD_MAX);
-            fsLight.Detach();
-        }
+        rapidjson::Document info;
+        if(!ParseInfoDat(*infoPath, info)) return std::nullopt;
 
-        hashFilter.MessageEnd();
-
-        HexEncoder hexEncoder(new StringSink(hashHex));
-        hexEncoder.Put((const byte*)hashResult.data(), hashResult.size());
-
-        cacheData->sha1 = hashHex;
-        SetCachedInfo(levelPath, *cacheData);
-
-        std::chrono::milliseconds duration = duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start);
-        DEBUG("GetCustomLevelHash Stop Result {} Time {}", hashHex, duration.count());
-        return hashHex;
+        return HashLevelFiles(levelPath, GetHashedLevelFilesV2(levelPath, *infoPath, info));
     }
 
-    std::optional<int> GetDirectoryHash(std::filesystem::path const& directoryPath) {
-        if (!std::filesystem::is_directory(directoryPath)) return std::nullopt;
+    std::optional<std::string> GetCustomLevelHash(std::filesystem::path const& levelPath, SongCore::CustomJSONData::CustomBeatmapLevelSaveDataV4* saveData) {
+        TRACE_SCOPE("GetCustomLevelHash");
 
-        int hash = 0;
-        bool hasFile = false;
-        std::error_code error_code;
-        auto dir_iter = std::filesystem::directory_iterator(directoryPath, error_code);
+        // get cached info
+        auto cacheData = GetCachedInfo(levelPath);
+        if(!cacheData.has_value()) return std::nullopt;
 
-        if (error_code) {
-            WARNING("Failed to get directory iterator for directory {}: {}", directoryPath.string(), error_code.message());
-            return std::nullopt;
+        if (cacheData->sha1.has_value()) {
+            DEBUG("GetCustomLevelHash Stop Result {} from cache", *cacheData->sha1);
+            return *cacheData->sha1;
         }
 
-        for (auto const& entry : dir_iter) {
-            if(!entry.is_directory()) {
-                hasFile = true;
-                hash ^= entry.file_size() ^ std::chrono::duration_cast<std::chrono::seconds>(std::filesystem::last_write_time(entry).time_since_epoch()).count();
-            }
-        }
+        auto infoPath = FindInfoDatPath(levelPath);
+        if(!infoPath.has_value()) return std::nullopt;
+
+        rapidjson::Document info;
+        if(!ParseInfoDat(*infoPath, info)) return std::nullopt;
+
+        auto files = GetHashedLevelFilesV4(levelPath, *infoPath, info);
+        if(!files.has_value()) return std::nullopt;
 
-        if(!hasFile)
-            return std::nullopt;
-        return hash;
+        return HashLevelFiles(levelPath, std::move(*files));
     }
 }
@@ -0,0 +1,78 @@
+#include "Utils/HashingService.hpp"
+#include "Utils/ThreadPool.hpp"
+#include "logging.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace SongCore::Utils {
+    HashingService::HashingService(size_t maxWorkers) :
+        _maxWorkers(std::max<size_t>(maxWorkers, 1)) {}
+
+    void HashingService::Enqueue(std::filesystem::path const& levelPath, HashPriority priority, uint64_t cost, std::function<void()> work) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        QueueKey key { priority, cost, _nextSequence++ };
+        auto pathString = levelPath.string();
+        _queuedLevels[pathString] = key;
+        _queue.emplace(key, QueuedWork{ std::move(pathString), std::move(work) });
+
+        // workers drain the queue and exit once it's empty, so there is only something to start while below the limit
+        if (_workers >= _maxWorkers) return;
+        _workers++;
+        lock.unlock();
+
+        GetThreadPool().Enqueue(priority == HashPriority::Interactive ? TaskPriority::High : TaskPriority::Normal, [this](){ WorkerThread(); });
+    }
+
+    bool HashingService::Prioritize(std::filesystem::path const& levelPath) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto levelItr = _queuedLevels.find(levelPath.string());
+        if (levelItr == _queuedLevels.end()) return false;
+
+        auto& key = levelItr->second;
+        if (std::get<HashPriority>(key) == HashPriority::Interactive) return true;
+
+        auto node = _queue.extract(key);
+        std::get<HashPriority>(key) = HashPriority::Interactive;
+        node.key() = key;
+        _queue.insert(std::move(node));
+        DEBUG("Prioritized hashing level {}", levelPath.string());
+        return true;
+    }
+
+    void HashingService::WorkerThread() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_queue.empty()) {
+            auto node = _queue.extract(_queue.begin());
+            // the path may have been queued again since, in which case the newer entry owns it
+            if (auto levelItr = _queuedLevels.find(node.mapped().levelPath); levelItr != _queuedLevels.end() && levelItr->second == node.key()) {
+                _queuedLevels.erase(levelItr);
+            }
+            lock.unlock();
+
+            try {
+                node.mapped().work();
+            } catch (std::exception const& e) {
+                ERROR("Caught exception of type {} while hashing level {}, what: {}", typeid(e).name(), node.mapped().levelPath, e.what());
+            } catch (...) {
+                ERROR("Caught exception of unknown type while hashing level {}", node.mapped().levelPath);
+            }
+
+            // destroy captured state before taking the lock again
+            node = {};
+            lock.lock();
+        }
+        _workers--;
+    }
+
+    size_t HashingService::get_QueueLength() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _queue.size();
+    }
+
+    HashingService& GetHashingService() {
+        // never destroyed for the same reason as the thread pool, its workers are pool threads
+        static HashingService* service = new HashingService(std::max<size_t>(std::thread::hardware_concurrency(), 1));
+        return *service;
+    }
+}
@@ -0,0 +1,92 @@
+#include "Utils/LevelHashFile.hpp"
+#include "Utils/File.hpp"
+#include "logging.hpp"
+#include "beatsaber-hook/shared/config/rapidjson-utils.hpp"
+#include "paper/shared/utfcpp/source/utf8.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+namespace SongCore::Utils {
+    std::optional<std::string> NormalizeLevelHash(std::string_view hash) {
+        if (hash.size() != 40) return std::nullopt;
+        std::string normalized;
+        normalized.reserve(hash.size());
+        for (auto c : hash) {
+            if (!std::isxdigit(static_cast<unsigned char>(c))) return std::nullopt;
+            normalized.push_back(std::toupper(static_cast<unsigned char>(c)));
+        }
+        return normalized;
+    }
+
+    bool HasLevelHashFile(std::span<DirectoryEntry const> entries) {
+        return std::any_of(entries.begin(), entries.end(), [](auto const& entry){ return entry.name == LEVEL_HASH_FILE_NAME; });
+    }
+
+    /// @brief whether the regular files in the folder, besides the hash file, are exactly the listed ones with the listed sizes
+    static bool MatchesListedFiles(std::filesystem::path const& levelPath, std::unordered_map<std::string, uint64_t> const& listedFiles) {
+        int dirFd = open(levelPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd < 0) return false;
+        std::vector<DirectoryEntry> entries;
+        bool listed = ListOpenDirectory(dirFd, entries);
+
+        size_t matched = 0;
+        bool matches = listed;
+        for (auto const& entry : entries) {
+            if (!matches) break;
+            if (entry.IsDirectory() || entry.name == LEVEL_HASH_FILE_NAME) continue;
+            struct stat st;
+            if (fstatat(dirFd, entry.name.c_str(), &st, 0) != 0 || !S_ISREG(st.st_mode)) continue;
+
+            auto itr = listedFiles.find(entry.name);
+            matches = itr != listedFiles.end() && itr->second == static_cast<uint64_t>(st.st_size);
+            matched++;
+        }
+        close(dirFd);
+        return matches && matched == listedFiles.size();
+    }
+
+    std::optional<std::string> ReadLevelHashFile(std::filesystem::path const& levelPath) {
+        auto filePath = levelPath / LEVEL_HASH_FILE_NAME;
+        if (!std::filesystem::exists(filePath)) return std::nullopt;
+
+        rapidjson::Document doc;
+        doc.Parse(utf8::utf16to8(ReadText(filePath)));
+        if (doc.HasParseError() || !doc.IsObject()) {
+            WARNING("{} is not a json object, ignoring it", filePath.string());
+            return std::nullopt;
+        }
+
+        auto memberEnd = doc.MemberEnd();
+        auto hashItr = doc.FindMember("hash");
+        auto filesItr = doc.FindMember("files");
+        if (hashItr == memberEnd || !hashItr->value.IsString() || filesItr == memberEnd || !filesItr->value.IsObject()) {
+            WARNING("{} is missing its hash or files, ignoring it", filePath.string());
+            return std::nullopt;
+        }
+
+        std::unordered_map<std::string, uint64_t> listedFiles;
+        for (auto itr = filesItr->value.MemberBegin(); itr != filesItr->value.MemberEnd(); itr++) {
+            if (!itr->value.IsUint64()) {
+                WARNING("{} lists {} without a size, ignoring it", filePath.string(), itr->name.GetString());
+                return std::nullopt;
+            }
+            listedFiles.emplace(itr->name.GetString(), itr->value.GetUint64());
+        }
+
+        // a file was added, removed or changed size since the hash was calculated
+        if (!MatchesListedFiles(levelPath, listedFiles)) {
+            DEBUG("{} was written for other files than the folder has, ignoring it", filePath.string());
+            return std::nullopt;
+        }
+
+        auto hash = NormalizeLevelHash(hashItr->value.Get<std::string>());
+        if (!hash.has_value()) WARNING("{} doesn't hold a sha1, ignoring it", filePath.string());
+        return hash;
+    }
+}
@@ -1,4 +1,5 @@
 #include "Utils/OggVorbis.hpp"
+#include <algorithm>
 #include <cstddef>
 #include <filesystem>
 #include <fstream>
@@ -99,7 +100,7 @@ namespace SongCore::Utils {
             if (overshoot >= SEEK_BLOCK_SIZE) break;
 
             // set the reader at end - seekPos + overshoot
-            reader.seekg(overshoot - seekPos, std::ios::seekdir::end);
+            reader.seekg(overshoot - seekPos, std::ios::end);
 
             // check to find the OGG bytes
             auto foundOggS = FindBytes(reader, OGG, SEEK_BLOCK_SIZE - overshoot);
@@ -0,0 +1,306 @@
+#include "Utils/Sha1.hpp"
+#include "logging.hpp"
+
+#include <cstring>
+#include <string>
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace SongCore::Utils {
+    static constexpr std::array<uint32_t, 5> INITIAL_STATE = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+    static constexpr std::array<uint32_t, 4> ROUND_CONSTANTS = { 0x5A827999, 0x6ED9EBA1, 0x8F1BBCDC, 0xCA62C1D6 };
+
+    static inline uint32_t RotateLeft(uint32_t value, int bits) {
+        return (value << bits) | (value >> (32 - bits));
+    }
+
+    static inline uint32_t LoadBigEndian(uint8_t const* data) {
+        return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 8) | uint32_t(data[3]);
+    }
+
+    static void CompressPortable(uint32_t* state, uint8_t const* blocks, size_t blockCount) {
+        for (; blockCount > 0; blockCount--, blocks += Sha1::BLOCK_SIZE) {
+            uint32_t w[80];
+            for (int i = 0; i < 16; i++) w[i] = LoadBigEndian(blocks + i * 4);
+            for (int i = 16; i < 80; i++) w[i] = RotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+            uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+            auto round = [&](int i, uint32_t f) {
+                uint32_t temp = RotateLeft(a, 5) + f + e + ROUND_CONSTANTS[i / 20] + w[i];
+                e = d;
+                d = c;
+                c = RotateLeft(b, 30);
+                b = a;
+                a = temp;
+            };
+
+            // split per round function, so the compiler doesn't pick the function every round
+            for (int i = 0; i < 20; i++) round(i, d ^ (b & (c ^ d)));
+            for (int i = 20; i < 40; i++) round(i, b ^ c ^ d);
+            for (int i = 40; i < 60; i++) round(i, (b & c) | (d & (b | c)));
+            for (int i = 60; i < 80; i++) round(i, b ^ c ^ d);
+
+            state[0] += a;
+            state[1] += b;
+            state[2] += c;
+            state[3] += d;
+            state[4] += e;
+        }
+    }
+
+#if defined(__aarch64__)
+    static bool CpuHasSha1() {
+        return getauxval(AT_HWCAP) & HWCAP_SHA1;
+    }
+
+    // every 4 rounds use one message vector, and the vector 4 groups ahead is derived from the current one and the 3 after it
+    __attribute__((target("+crypto")))
+    static void CompressArmv8(uint32_t* state, uint8_t const* blocks, size_t blockCount) {
+        uint32x4_t abcd = vld1q_u32(state);
+        uint32_t e = state[4];
+
+        for (; blockCount > 0; blockCount--, blocks += Sha1::BLOCK_SIZE) {
+            uint32x4_t abcdSaved = abcd;
+            uint32_t eSaved = e;
+
+            uint32x4_t msg[4];
+            for (int i = 0; i < 4; i++) msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + i * 16)));
+
+            #pragma GCC unroll 20
+            for (int group = 0; group < 20; group++) {
+                uint32x4_t wk = vaddq_u32(msg[group % 4], vdupq_n_u32(ROUND_CONSTANTS[group / 5]));
+                uint32_t eNext = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+
+                if (group < 5) abcd = vsha1cq_u32(abcd, e, wk);
+                else if (group < 10) abcd = vsha1pq_u32(abcd, e, wk);
+                else if (group < 15) abcd = vsha1mq_u32(abcd, e, wk);
+                else abcd = vsha1pq_u32(abcd, e, wk);
+                e = eNext;
+
+                if (group < 16) {
+                    msg[group % 4] = vsha1su1q_u32(vsha1su0q_u32(msg[group % 4], msg[(group + 1) % 4], msg[(group + 2) % 4]), msg[(group + 3) % 4]);
+                }
+            }
+
+            abcd = vaddq_u32(abcd, abcdSaved);
+            e += eSaved;
+        }
+
+        vst1q_u32(state, abcd);
+        state[4] = e;
+    }
+#elif defined(__x86_64__) || defined(__i386__)
+    static bool CpuHasSha1() {
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+        bool hasSha = ebx & (1u << 29);
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return false;
+        bool hasSse41 = ecx & (1u << 19);
+        bool hasSsse3 = ecx & (1u << 9);
+        return hasSha && hasSse41 && hasSsse3;
+    }
+
+    // every 4 rounds use one message vector, and the vector 4 groups ahead is derived from the current one and the 3 after it
+    __attribute__((target("sha,sse4.1,ssse3")))
+    static void CompressShaNi(uint32_t* state, uint8_t const* blocks, size_t blockCount) {
+        __m128i const byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090A0B0C0D0E0FULL);
+
+        __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<__m128i const*>(state)), 0x1B);
+        __m128i e = _mm_set_epi32(state[4], 0, 0, 0);
+
+        for (; blockCount > 0; blockCount--, blocks += Sha1::BLOCK_SIZE) {
+            __m128i abcdSaved = abcd;
+            __m128i eSaved = e;
+
+            __m128i msg[4];
+            for (int i = 0; i < 4; i++) msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(blocks + i * 16)), byteSwap);
+
+            __m128i previousAbcd = abcd;
+            #pragma GCC unroll 20
+            for (int group = 0; group < 20; group++) {
+                // e for the next 4 rounds comes from the abcd before the last 4 rounds
+                __m128i ew = group == 0 ? _mm_add_epi32(e, msg[0]) : _mm_sha1nexte_epu32(previousAbcd, msg[group % 4]);
+                previousAbcd = abcd;
+
+                switch (group / 5) {
+                    case 0: abcd = _mm_sha1rnds4_epu32(abcd, ew, 0); break;
+                    case 1: abcd = _mm_sha1rnds4_epu32(abcd, ew, 1); break;
+                    case 2: abcd = _mm_sha1rnds4_epu32(abcd, ew, 2); break;
+                    default: abcd = _mm_sha1rnds4_epu32(abcd, ew, 3); break;
+                }
+
+                if (group < 16) {
+                    msg[group % 4] = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(msg[group % 4], msg[(group + 1) % 4]), msg[(group + 2) % 4]), msg[(group + 3) % 4]);
+                }
+            }
+
+            e = _mm_sha1nexte_epu32(previousAbcd, eSaved);
+            abcd = _mm_add_epi32(abcd, abcdSaved);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1B));
+        state[4] = _mm_extract_epi32(e, 3);
+    }
+#endif
+
+    /// @brief runs the known answers through a kernel, the million a's also go through the kernel in multi block calls
+    static bool PassesKnownAnswerTests(Sha1::CompressFunction compress) {
+        struct KnownAnswer {
+            std::string_view input;
+            size_t repeat;
+            std::string_view digest;
+        };
+        static constexpr KnownAnswer knownAnswers[] = {
+            { "", 1, "DA39A3EE5E6B4B0D3255BFEF95601890AFD80709" },
+            { "abc", 1, "A9993E364706816ABA3E25717850C26C9CD0D89D" },
+            { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", 1, "84983E441C3BD26EBAAE4AA1F95129E5E54670F1" },
+            { "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", 1, "A49B2446A02C645BF419F995B67091253A04A259" },
+            { "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", 10000, "34AA973CD4C4DAA4F61EEB2BDBAD27316534016F" }
+        };
+        static constexpr char hexChars[] = "0123456789ABCDEF";
+
+        for (auto const& knownAnswer : knownAnswers) {
+            std::string input;
+            input.reserve(knownAnswer.input.size() * knownAnswer.repeat);
+            for (size_t i = 0; i < knownAnswer.repeat; i++) input.append(knownAnswer.input);
+
+            // same padding as Sha1::Final, kept separate so the kernel is tested on its own
+            auto state = INITIAL_STATE;
+            size_t fullBlocks = input.size() / Sha1::BLOCK_SIZE;
+            compress(state.data(), reinterpret_cast<uint8_t const*>(input.data()), fullBlocks);
+
+            std::array<uint8_t, Sha1::BLOCK_SIZE * 2> tail {};
+            size_t remaining = input.size() - fullBlocks * Sha1::BLOCK_SIZE;
+            std::memcpy(tail.data(), input.data() + fullBlocks * Sha1::BLOCK_SIZE, remaining);
+            tail[remaining] = 0x80;
+            size_t tailSize = remaining + 9 <= Sha1::BLOCK_SIZE ? Sha1::BLOCK_SIZE : Sha1::BLOCK_SIZE * 2;
+            uint64_t bitSize = uint64_t(input.size()) * 8;
+            for (int i = 0; i < 8; i++) tail[tailSize - 1 - i] = uint8_t(bitSize >> (i * 8));
+            compress(state.data(), tail.data(), tailSize / Sha1::BLOCK_SIZE);
+
+            std::string hex;
+            for (auto word : state) {
+                for (int shift = 28; shift >= 0; shift -= 4) hex.push_back(hexChars[(word >> shift) & 0xF]);
+            }
+            if (hex != knownAnswer.digest) return false;
+        }
+        return true;
+    }
+
+    std::vector<Sha1::Kernel> Sha1::GetAvailableKernels() {
+        std::vector<Kernel> kernels { { "portable", &CompressPortable } };
+#if defined(__aarch64__)
+        if (CpuHasSha1()) kernels.push_back({ "armv8 crypto extensions", &CompressArmv8 });
+#elif defined(__x86_64__) || defined(__i386__)
+        if (CpuHasSha1()) kernels.push_back({ "x86 sha-ni", &CompressShaNi });
+#endif
+        return kernels;
+    }
+
+    static Sha1::Kernel SelectKernel() {
+        auto kernels = Sha1::GetAvailableKernels();
+        auto const& portable = kernels.front();
+        if (!PassesKnownAnswerTests(portable.compress)) {
+            // nothing better to fall back on, but this should be loud
+            CRITICAL("Portable SHA1 failed its known answer tests, level hashes will be wrong!");
+            return portable;
+        }
+
+        // the accelerated kernel is only there if the cpu can run it
+        if (kernels.size() > 1) {
+            auto const& accelerated = kernels.back();
+            if (PassesKnownAnswerTests(accelerated.compress)) {
+                INFO("Hashing SHA1 with {}", accelerated.name);
+                return accelerated;
+            }
+            ERROR("SHA1 with {} failed its known answer tests, falling back to the portable implementation", accelerated.name);
+        }
+
+        INFO("Hashing SHA1 with the {} implementation", portable.name);
+        return portable;
+    }
+
+    static Sha1::Kernel const& GetKernel() {
+        static Sha1::Kernel kernel = SelectKernel();
+        return kernel;
+    }
+
+    Sha1::Sha1() : Sha1(GetKernel().compress) {}
+
+    Sha1::Sha1(CompressFunction compress) : _compress(compress) {
+        Reset();
+    }
+
+    void Sha1::Reset() {
+        _state = INITIAL_STATE;
+        _bufferSize = 0;
+        _totalSize = 0;
+    }
+
+    void Sha1::Update(uint8_t const* data, size_t size) {
+        auto compress = _compress;
+        _totalSize += size;
+
+        if (_bufferSize > 0) {
+            size_t toCopy = std::min(size, BLOCK_SIZE - _bufferSize);
+            std::memcpy(_buffer.data() + _bufferSize, data, toCopy);
+            _bufferSize += toCopy;
+            data += toCopy;
+            size -= toCopy;
+
+            if (_bufferSize < BLOCK_SIZE) return;
+            compress(_state.data(), _buffer.data(), 1);
+            _bufferSize = 0;
+        }
+
+        // whole blocks go straight from the input into the kernel
+        size_t blockCount = size / BLOCK_SIZE;
+        if (blockCount > 0) {
+            compress(_state.data(), data, blockCount);
+            data += blockCount * BLOCK_SIZE;
+            size -= blockCount * BLOCK_SIZE;
+        }
+
+        if (size > 0) {
+            std::memcpy(_buffer.data(), data, size);
+            _bufferSize = size;
+        }
+    }
+
+    Sha1::Digest Sha1::Final() {
+        auto compress = _compress;
+        uint64_t bitSize = _totalSize * 8;
+
+        _buffer[_bufferSize++] = 0x80;
+        if (_bufferSize > BLOCK_SIZE - 8) {
+            std::memset(_buffer.data() + _bufferSize, 0, BLOCK_SIZE - _bufferSize);
+            compress(_state.data(), _buffer.data(), 1);
+            _bufferSize = 0;
+        }
+        std::memset(_buffer.data() + _bufferSize, 0, BLOCK_SIZE - 8 - _bufferSize);
+        for (int i = 0; i < 8; i++) _buffer[BLOCK_SIZE - 1 - i] = uint8_t(bitSize >> (i * 8));
+        compress(_state.data(), _buffer.data(), 1);
+
+        Digest digest;
+        for (size_t i = 0; i < _state.size(); i++) {
+            digest[i * 4] = uint8_t(_state[i] >> 24);
+            digest[i * 4 + 1] = uint8_t(_state[i] >> 16);
+            digest[i * 4 + 2] = uint8_t(_state[i] >> 8);
+            digest[i * 4 + 3] = uint8_t(_state[i]);
+        }
+
+        Reset();
+        return digest;
+    }
+
+    std::string_view Sha1::get_KernelName() {
+        return GetKernel().name;
+    }
+}
@@ -0,0 +1,466 @@
+#include "Utils/SongCacheFile.hpp"
+#include "Utils/File.hpp"
+#include "Utils/XXHash64.hpp"
+#include "logging.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SongCore::Utils {
+    static constexpr std::array<char, 4> CACHE_FILE_MAGIC = { 'S', 'C', 'S', 'C' };
+    /// @brief bumped whenever the layout of the header or records changes, files of other versions are ignored and rebuilt
+    static constexpr uint32_t CACHE_FILE_VERSION = 4;
+    static constexpr std::array<char, 4> JOURNAL_MAGIC = { 'S', 'C', 'S', 'J' };
+    /// @brief bumped whenever the layout of journal records changes, journals of other versions are dropped
+    static constexpr uint32_t JOURNAL_VERSION = 3;
+
+    enum RecordFlags : uint32_t {
+        HasSha1 = 1 << 0,
+        HasSongDuration = 1 << 1,
+        HasContentFingerprint = 1 << 2,
+        HasLegacyDirectoryHash = 1 << 3,
+        HasLevelMetadata = 1 << 4,
+        /// @brief only in the journal, the entry was removed
+        Removed = 1u << 31
+    };
+
+    struct CacheFileHeader {
+        std::array<char, 4> magic;
+        uint32_t version;
+        uint32_t recordSize;
+        uint32_t recordCount;
+        uint64_t fingerprintIndexOffset;
+        uint64_t fingerprintIndexCount;
+        uint64_t stringTableOffset;
+        uint64_t stringTableSize;
+        /// @brief xxh64 of everything after the header
+        uint64_t checksum;
+    };
+    static_assert(sizeof(CacheFileHeader) == 56);
+
+    struct SongCacheFileRecord {
+        uint64_t directoryFingerprint;
+        uint64_t contentFingerprint;
+        uint32_t pathOffset;
+        uint32_t pathLength;
+        /// @brief the level metadata is kept in the string table as well
+        uint32_t metadataOffset;
+        uint32_t metadataLength;
+        int32_t legacyDirectoryHash;
+        float songDuration;
+        std::array<uint8_t, 20> sha1;
+        uint32_t flags;
+    };
+    static_assert(sizeof(SongCacheFileRecord) == 64);
+
+    /// @brief the directory and content fingerprints of the records sorted on fingerprint, so entries are found without knowing their path
+    struct FingerprintIndexEntry {
+        uint64_t fingerprint;
+        uint32_t record;
+        uint32_t padding;
+    };
+    static_assert(sizeof(FingerprintIndexEntry) == 16);
+
+    /// @brief journal records are a fixed size record, the path, the level metadata, and the xxh64 of all of them
+    using JournalChecksum = uint64_t;
+
+    struct JournalHeader {
+        std::array<char, 4> magic;
+        uint32_t version;
+    };
+    static_assert(sizeof(JournalHeader) == 8);
+
+    static constexpr char hexChars[] = "0123456789ABCDEF";
+
+    static std::string Sha1ToHex(std::array<uint8_t, 20> const& sha1) {
+        std::string hex;
+        hex.reserve(sha1.size() * 2);
+        for (auto b : sha1) {
+            hex.push_back(hexChars[b >> 4]);
+            hex.push_back(hexChars[b & 0xF]);
+        }
+        return hex;
+    }
+
+    static int HexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+
+    /// @return false if the text isn't a 40 character hex sha1
+    static bool Sha1FromHex(std::string_view hex, std::array<uint8_t, 20>& out) {
+        if (hex.size() != out.size() * 2) return false;
+        for (size_t i = 0; i < out.size(); i++) {
+            int high = HexValue(hex[i * 2]);
+            int low = HexValue(hex[i * 2 + 1]);
+            if (high < 0 || low < 0) return false;
+            out[i] = (high << 4) | low;
+        }
+        return true;
+    }
+
+    MappedSongCache::~MappedSongCache() {
+        Close();
+    }
+
+    bool MappedSongCache::Open(std::filesystem::path const& filePath) {
+        Close();
+
+        int fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(CacheFileHeader))) {
+            close(fd);
+            return false;
+        }
+        _size = st.st_size;
+
+        void* mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping != MAP_FAILED) {
+            _data = static_cast<uint8_t const*>(mapping);
+            _mapped = true;
+        } else {
+            WARNING("Could not map song cache {}, reading it instead: {}", filePath.string(), strerror(errno));
+            _fallbackBuffer.resize(_size);
+            size_t offset = 0;
+            while (offset < _size) {
+                auto bytesRead = pread(fd, _fallbackBuffer.data() + offset, _size - offset, offset);
+                if (bytesRead < 0 && errno == EINTR) continue;
+                if (bytesRead <= 0) break;
+                offset += bytesRead;
+            }
+            if (offset < _size) {
+                close(fd);
+                Close();
+                return false;
+            }
+            _data = _fallbackBuffer.data();
+        }
+        close(fd);
+
+        CacheFileHeader header;
+        std::memcpy(&header, _data, sizeof(header));
+        uint64_t recordsEnd = sizeof(CacheFileHeader) + static_cast<uint64_t>(header.recordCount) * sizeof(SongCacheFileRecord);
+        if (header.magic != CACHE_FILE_MAGIC || header.version != CACHE_FILE_VERSION || header.recordSize != sizeof(SongCacheFileRecord) ||
+            recordsEnd > header.fingerprintIndexOffset || header.fingerprintIndexOffset > _size || header.fingerprintIndexCount > static_cast<uint64_t>(header.recordCount) * 2 ||
+            header.fingerprintIndexOffset + header.fingerprintIndexCount * sizeof(FingerprintIndexEntry) > header.stringTableOffset ||
+            header.stringTableOffset > _size || header.stringTableSize > _size - header.stringTableOffset) {
+            WARNING("Song cache {} is not a version {} cache file, ignoring it", filePath.string(), CACHE_FILE_VERSION);
+            Close();
+            return false;
+        }
+        // files are only ever replaced once complete, so a mismatch means the storage damaged it
+        if (XXHash64::Hash(_data + sizeof(CacheFileHeader), _size - sizeof(CacheFileHeader)) != header.checksum) {
+            WARNING("Song cache {} is damaged, ignoring it", filePath.string());
+            Close();
+            return false;
+        }
+
+        _records = reinterpret_cast<SongCacheFileRecord const*>(_data + sizeof(CacheFileHeader));
+        _recordCount = header.recordCount;
+        _fingerprintIndex = reinterpret_cast<FingerprintIndexEntry const*>(_data + header.fingerprintIndexOffset);
+        _fingerprintIndexCount = header.fingerprintIndexCount;
+        _strings = reinterpret_cast<char const*>(_data + header.stringTableOffset);
+        _stringsSize = header.stringTableSize;
+        return true;
+    }
+
+    void MappedSongCache::Close() {
+        if (_mapped) munmap(const_cast<uint8_t*>(_data), _size);
+        _fallbackBuffer = {};
+        _data = nullptr;
+        _size = 0;
+        _mapped = false;
+        _records = nullptr;
+        _recordCount = 0;
+        _fingerprintIndex = nullptr;
+        _fingerprintIndexCount = 0;
+        _strings = nullptr;
+        _stringsSize = 0;
+    }
+
+    std::string_view MappedSongCache::PathOf(SongCacheFileRecord const& record) const {
+        // a damaged record only makes its own lookup miss
+        if (static_cast<uint64_t>(record.pathOffset) + record.pathLength > _stringsSize) return {};
+        return { _strings + record.pathOffset, record.pathLength };
+    }
+
+    std::string_view MappedSongCache::MetadataOf(SongCacheFileRecord const& record) const {
+        if (static_cast<uint64_t>(record.metadataOffset) + record.metadataLength > _stringsSize) return {};
+        return { _strings + record.metadataOffset, record.metadataLength };
+    }
+
+    /// @param metadata the level metadata the record points at, only used if the record has it
+    static CachedSongData ToCachedSongData(SongCacheFileRecord const& record, std::string_view metadata) {
+        CachedSongData data;
+        data.directoryFingerprint = record.directoryFingerprint;
+        if (record.flags & HasLegacyDirectoryHash) data.legacyDirectoryHash = record.legacyDirectoryHash;
+        if (record.flags & HasContentFingerprint) data.contentFingerprint = record.contentFingerprint;
+        if (record.flags & HasSha1) data.sha1 = Sha1ToHex(record.sha1);
+        if (record.flags & HasSongDuration) data.songDuration = record.songDuration;
+        // metadata that was out of bounds is left out, the level is just parsed again
+        if ((record.flags & HasLevelMetadata) && metadata.size() == record.metadataLength && !metadata.empty()) data.levelMetadata = std::string(metadata);
+        return data;
+    }
+
+    /// @param metadataOffset where the level metadata of the data will be written, if it has any
+    static SongCacheFileRecord ToRecord(CachedSongData const& data, uint32_t pathOffset, uint32_t pathLength, uint32_t metadataOffset) {
+        SongCacheFileRecord record {};
+        record.directoryFingerprint = data.directoryFingerprint;
+        record.pathOffset = pathOffset;
+        record.pathLength = pathLength;
+        if (data.levelMetadata.has_value()) {
+            record.metadataOffset = metadataOffset;
+            record.metadataLength = data.levelMetadata->size();
+            record.flags |= HasLevelMetadata;
+        }
+        if (data.legacyDirectoryHash.has_value()) {
+            record.legacyDirectoryHash = *data.legacyDirectoryHash;
+            record.flags |= HasLegacyDirectoryHash;
+        }
+        if (data.contentFingerprint.has_value()) {
+            record.contentFingerprint = *data.contentFingerprint;
+            record.flags |= HasContentFingerprint;
+        }
+        // anything that isn't a proper sha1 is dropped, the level just gets hashed again
+        if (data.sha1.has_value() && Sha1FromHex(*data.sha1, record.sha1)) {
+            record.flags |= HasSha1;
+        }
+        if (data.songDuration.has_value()) {
+            record.songDuration = *data.songDuration;
+            record.flags |= HasSongDuration;
+        }
+        return record;
+    }
+
+    std::optional<CachedSongData> MappedSongCache::Find(std::string_view levelPath) const {
+        auto end = _records + _recordCount;
+        auto itr = std::lower_bound(_records, end, levelPath, [this](SongCacheFileRecord const& record, std::string_view path){ return PathOf(record) < path; });
+        if (itr == end || PathOf(*itr) != levelPath) return std::nullopt;
+        return ToCachedSongData(*itr, MetadataOf(*itr));
+    }
+
+    void MappedSongCache::ForEach(std::function<void(std::string_view levelPath, CachedSongData const& data)> const& func) const {
+        for (size_t i = 0; i < _recordCount; i++) {
+            auto path = PathOf(_records[i]);
+            if (path.empty()) continue;
+            func(path, ToCachedSongData(_records[i], MetadataOf(_records[i])));
+        }
+    }
+
+    void MappedSongCache::ForEachWithFingerprint(uint64_t fingerprint, std::function<void(std::string_view levelPath, CachedSongData const& data)> const& func) const {
+        auto end = _fingerprintIndex + _fingerprintIndexCount;
+        auto itr = std::lower_bound(_fingerprintIndex, end, fingerprint, [](FingerprintIndexEntry const& entry, uint64_t value){ return entry.fingerprint < value; });
+        for (; itr != end && itr->fingerprint == fingerprint; itr++) {
+            if (itr->record >= _recordCount) continue;
+            auto const& record = _records[itr->record];
+            auto path = PathOf(record);
+            if (path.empty()) continue;
+            func(path, ToCachedSongData(record, MetadataOf(record)));
+        }
+    }
+
+    void MappedSongCache::ForEachPath(std::function<void(std::string_view levelPath)> const& func) const {
+        for (size_t i = 0; i < _recordCount; i++) {
+            auto path = PathOf(_records[i]);
+            if (!path.empty()) func(path);
+        }
+    }
+
+    bool WriteSongCacheFile(std::filesystem::path const& filePath, std::span<std::pair<std::string, CachedSongData> const> entries) {
+        size_t stringTableSize = 0;
+        // entries from before fingerprints don't have a directory fingerprint yet, those aren't indexed on it
+        std::vector<FingerprintIndexEntry> fingerprintIndex;
+        fingerprintIndex.reserve(entries.size());
+        for (size_t i = 0; i < entries.size(); i++) {
+            auto const& [levelPath, data] = entries[i];
+            stringTableSize += levelPath.size() + data.levelMetadata.value_or("").size();
+            if (!data.legacyDirectoryHash.has_value()) fingerprintIndex.push_back({ data.directoryFingerprint, static_cast<uint32_t>(i) });
+            if (data.contentFingerprint.has_value()) fingerprintIndex.push_back({ *data.contentFingerprint, static_cast<uint32_t>(i) });
+        }
+        std::sort(fingerprintIndex.begin(), fingerprintIndex.end(), [](auto const& a, auto const& b){ return a.fingerprint < b.fingerprint; });
+
+        uint64_t fingerprintIndexOffset = sizeof(CacheFileHeader) + entries.size() * sizeof(SongCacheFileRecord);
+        CacheFileHeader header {
+            .magic = CACHE_FILE_MAGIC,
+            .version = CACHE_FILE_VERSION,
+            .recordSize = sizeof(SongCacheFileRecord),
+            .recordCount = static_cast<uint32_t>(entries.size()),
+            .fingerprintIndexOffset = fingerprintIndexOffset,
+            .fingerprintIndexCount = fingerprintIndex.size(),
+            .stringTableOffset = fingerprintIndexOffset + fingerprintIndex.size() * sizeof(FingerprintIndexEntry),
+            .stringTableSize = stringTableSize
+        };
+
+        // built in memory and written at once, it's only a few MB even for huge libraries
+        std::vector<uint8_t> buffer(header.stringTableOffset + stringTableSize);
+        auto records = reinterpret_cast<SongCacheFileRecord*>(buffer.data() + sizeof(CacheFileHeader));
+        if (!fingerprintIndex.empty()) std::memcpy(buffer.data() + fingerprintIndexOffset, fingerprintIndex.data(), fingerprintIndex.size() * sizeof(FingerprintIndexEntry));
+        auto strings = reinterpret_cast<char*>(buffer.data() + header.stringTableOffset);
+
+        uint32_t stringOffset = 0;
+        for (size_t i = 0; i < entries.size(); i++) {
+            auto const& [levelPath, data] = entries[i];
+            records[i] = ToRecord(data, stringOffset, levelPath.size(), stringOffset + levelPath.size());
+            std::memcpy(strings + stringOffset, levelPath.data(), levelPath.size());
+            stringOffset += levelPath.size();
+            if (data.levelMetadata.has_value()) {
+                std::memcpy(strings + stringOffset, data.levelMetadata->data(), data.levelMetadata->size());
+                stringOffset += data.levelMetadata->size();
+            }
+        }
+        header.checksum = XXHash64::Hash(buffer.data() + sizeof(CacheFileHeader), buffer.size() - sizeof(CacheFileHeader));
+        std::memcpy(buffer.data(), &header, sizeof(header));
+
+        if (!WriteFileAtomically(filePath, buffer)) {
+            ERROR("Could not write the song cache to {}: {}", filePath.string(), strerror(errno));
+            return false;
+        }
+        return true;
+    }
+
+    bool AppendSongCacheJournal(std::filesystem::path const& journalPath, std::span<std::pair<std::string, std::optional<CachedSongData>> const> changes) {
+        if (changes.empty()) return true;
+
+        int fd = open(journalPath.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            ERROR("Could not open the song cache journal {}: {}", journalPath.string(), strerror(errno));
+            return false;
+        }
+
+        // all changes go out in a single write, records are a fixed size record followed by the path and the level metadata
+        std::vector<uint8_t> buffer;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size == 0) {
+            JournalHeader header { .magic = JOURNAL_MAGIC, .version = JOURNAL_VERSION };
+            buffer.insert(buffer.end(), reinterpret_cast<uint8_t const*>(&header), reinterpret_cast<uint8_t const*>(&header + 1));
+        }
+        for (auto const& [levelPath, data] : changes) {
+            auto record = data.has_value() ? ToRecord(*data, 0, levelPath.size(), 0) : SongCacheFileRecord { .pathLength = static_cast<uint32_t>(levelPath.size()), .flags = Removed };
+            size_t recordStart = buffer.size();
+            buffer.insert(buffer.end(), reinterpret_cast<uint8_t const*>(&record), reinterpret_cast<uint8_t const*>(&record + 1));
+            buffer.insert(buffer.end(), levelPath.begin(), levelPath.end());
+            if (data.has_value() && data->levelMetadata.has_value()) buffer.insert(buffer.end(), data->levelMetadata->begin(), data->levelMetadata->end());
+            JournalChecksum checksum = XXHash64::Hash(buffer.data() + recordStart, buffer.size() - recordStart);
+            buffer.insert(buffer.end(), reinterpret_cast<uint8_t const*>(&checksum), reinterpret_cast<uint8_t const*>(&checksum + 1));
+        }
+
+        bool written = WriteAll(fd, buffer.data(), buffer.size()) && fdatasync(fd) == 0;
+        if (!written) ERROR("Could not append to the song cache journal {}: {}", journalPath.string(), strerror(errno));
+        close(fd);
+        return written;
+    }
+
+    std::optional<size_t> ReplaySongCacheJournal(std::filesystem::path const& journalPath, std::function<void(std::string_view levelPath, std::optional<CachedSongData> const& data)> const& func) {
+        int fd = open(journalPath.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd < 0) return std::nullopt;
+
+        std::vector<uint8_t> buffer;
+        struct stat st;
+        if (fstat(fd, &st) == 0) {
+            buffer.resize(st.st_size);
+            size_t offset = 0;
+            while (offset < buffer.size()) {
+                auto bytesRead = pread(fd, buffer.data() + offset, buffer.size() - offset, offset);
+                if (bytesRead < 0 && errno == EINTR) continue;
+                if (bytesRead <= 0) break;
+                offset += bytesRead;
+            }
+            buffer.resize(offset);
+        }
+
+        JournalHeader header {};
+        if (buffer.size() >= sizeof(header)) std::memcpy(&header, buffer.data(), sizeof(header));
+        if (header.magic != JOURNAL_MAGIC || header.version != JOURNAL_VERSION) {
+            if (!buffer.empty()) WARNING("Song cache journal {} is not a version {} journal, dropping it", journalPath.string(), JOURNAL_VERSION);
+            ftruncate(fd, 0);
+            close(fd);
+            return 0;
+        }
+
+        size_t count = 0;
+        size_t offset = sizeof(header);
+        while (buffer.size() - offset >= sizeof(SongCacheFileRecord) + sizeof(JournalChecksum)) {
+            SongCacheFileRecord record;
+            std::memcpy(&record, buffer.data() + offset, sizeof(record));
+            uint64_t stringsLength = static_cast<uint64_t>(record.pathLength) + ((record.flags & HasLevelMetadata) ? record.metadataLength : 0);
+            if (stringsLength > buffer.size() - offset - sizeof(record) - sizeof(JournalChecksum)) break;
+
+            size_t checksumOffset = offset + sizeof(record) + stringsLength;
+            JournalChecksum checksum;
+            std::memcpy(&checksum, buffer.data() + checksumOffset, sizeof(checksum));
+            if (XXHash64::Hash(buffer.data() + offset, checksumOffset - offset) != checksum) break;
+
+            std::string_view levelPath(reinterpret_cast<char const*>(buffer.data() + offset + sizeof(record)), record.pathLength);
+            std::string_view metadata(levelPath.data() + levelPath.size(), stringsLength - record.pathLength);
+            func(levelPath, (record.flags & Removed) ? std::nullopt : std::optional<CachedSongData>(ToCachedSongData(record, metadata)));
+            offset = checksumOffset + sizeof(checksum);
+            count++;
+        }
+
+        // everything from a record that was cut off or damaged on is dropped, otherwise the next append would continue after it
+        if (offset != buffer.size()) {
+            WARNING("Song cache journal {} ends in an incomplete or damaged record, dropping its last {} bytes", journalPath.string(), buffer.size() - offset);
+            ftruncate(fd, offset);
+        }
+        close(fd);
+        return count;
+    }
+
+    bool TrimSongCacheJournal(std::filesystem::path const& journalPath, uint64_t compactedSize) {
+        // the journal was empty, everything in it now came after
+        if (compactedSize == 0) return true;
+
+        int fd = open(journalPath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            if (errno == ENOENT) return true;
+            ERROR("Could not open the song cache journal {}: {}", journalPath.string(), strerror(errno));
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ERROR("Could not stat the song cache journal {}: {}", journalPath.string(), strerror(errno));
+            close(fd);
+            return false;
+        }
+
+        // nothing was appended while compacting, so the journal can simply be emptied
+        if (static_cast<uint64_t>(st.st_size) <= compactedSize) {
+            close(fd);
+            if (truncate(journalPath.c_str(), 0) == 0) return true;
+            ERROR("Could not reset the song cache journal {}: {}", journalPath.string(), strerror(errno));
+            return false;
+        }
+
+        // the records appended since go into a new journal of their own
+        JournalHeader header { .magic = JOURNAL_MAGIC, .version = JOURNAL_VERSION };
+        std::vector<uint8_t> buffer(sizeof(header) + st.st_size - compactedSize);
+        std::memcpy(buffer.data(), &header, sizeof(header));
+        size_t offset = sizeof(header);
+        while (offset < buffer.size()) {
+            auto bytesRead = pread(fd, buffer.data() + offset, buffer.size() - offset, compactedSize + offset - sizeof(header));
+            if (bytesRead < 0 && errno == EINTR) continue;
+            if (bytesRead <= 0) break;
+            offset += bytesRead;
+        }
+        close(fd);
+        if (offset != buffer.size()) {
+            ERROR("Could not read the song cache journal {}: {}", journalPath.string(), strerror(errno));
+            return false;
+        }
+
+        if (WriteFileAtomically(journalPath, buffer)) return true;
+        ERROR("Could not trim the song cache journal {}: {}", journalPath.string(), strerror(errno));
+        return false;
+    }
+}
@@ -0,0 +1,112 @@
+#include "Utils/ThreadPool.hpp"
+#include "logging.hpp"
+#include "config.hpp"
+
+#include "beatsaber-hook/shared/utils/il2cpp-utils.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace SongCore::Utils {
+    /// @brief the pool never gets fewer threads than this, as a single refresh pipeline already keeps several blocked on each other
+    static constexpr size_t MIN_POOL_THREADS = 8;
+    static constexpr auto POOL_IDLE_TIMEOUT = std::chrono::seconds(60);
+
+    ThreadPool::ThreadPool(size_t baseWorkers, size_t maxWorkers, std::chrono::milliseconds idleTimeout) :
+        _baseWorkers(baseWorkers),
+        _maxWorkers(std::max<size_t>(maxWorkers, 1)),
+        _idleTimeout(idleTimeout) {}
+
+    void ThreadPool::Enqueue(TaskPriority priority, std::function<void()> work) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _queues[static_cast<size_t>(priority)].emplace_back(std::move(work));
+        _queued++;
+
+        // every queued item needs an idle thread to pick it up, otherwise it could wait on work that is itself waiting on it
+        if (_queued > _idle && _workers < _maxWorkers) {
+            SpawnWorker();
+        } else {
+            lock.unlock();
+            _workAvailable.notify_one();
+        }
+    }
+
+    void ThreadPool::SpawnWorker() {
+        _workers++;
+        _peakWorkers = std::max(_peakWorkers, _workers);
+        il2cpp_utils::il2cpp_aware_thread(&ThreadPool::WorkerThread, this).detach();
+    }
+
+    void ThreadPool::WorkerThread() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            if (_queued > 0) {
+                auto& queue = *std::find_if(_queues.begin(), _queues.end(), [](auto const& queue){ return !queue.empty(); });
+                auto work = std::move(queue.front());
+                queue.pop_front();
+                _queued--;
+                _active++;
+                lock.unlock();
+
+                try {
+                    work();
+                } catch (std::exception const& e) {
+                    ERROR("Caught exception of type {} in thread pool work, what: {}", typeid(e).name(), e.what());
+                } catch (...) {
+                    ERROR("Caught exception of unknown type in thread pool work");
+                }
+
+                // destroy captured state before taking the lock again
+                work = nullptr;
+                lock.lock();
+                _active--;
+                _completed++;
+                continue;
+            }
+
+            _idle++;
+            bool gotWork = _workAvailable.wait_for(lock, _idleTimeout, [this](){ return _queued > 0; });
+            _idle--;
+
+            if (!gotWork && _workers > _baseWorkers) {
+                _workers--;
+                return;
+            }
+        }
+    }
+
+    size_t ThreadPool::get_QueueLength() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _queued;
+    }
+
+    size_t ThreadPool::get_ActiveWorkers() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _active;
+    }
+
+    size_t ThreadPool::get_WorkerCount() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _workers;
+    }
+
+    size_t ThreadPool::get_PeakWorkerCount() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _peakWorkers;
+    }
+
+    size_t ThreadPool::get_CompletedCount() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _completed;
+    }
+
+    ThreadPool& GetThreadPool() {
+        // never destroyed, detached pool threads might still reference it while the process exits
+        static ThreadPool* pool = new ThreadPool(
+            std::max<size_t>(std::thread::hardware_concurrency(), 1),
+            std::max<size_t>(config.maxLoaderThreads, MIN_POOL_THREADS),
+            POOL_IDLE_TIMEOUT
+        );
+        return *pool;
+    }
+}
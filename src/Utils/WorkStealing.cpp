@@ -0,0 +1,61 @@
+#include "Utils/WorkStealing.hpp"
+
+#include <algorithm>
+
+namespace SongCore::Utils {
+    WorkStealingRanges::WorkStealingRanges(size_t itemCount, size_t workerCount) :
+        _workerCount(std::max<size_t>(workerCount, 1)),
+        _ranges(std::make_unique<Range[]>(_workerCount)) {
+        auto itemsPerWorker = itemCount / _workerCount;
+        auto remainder = itemCount % _workerCount;
+
+        uint32_t begin = 0;
+        for (size_t i = 0; i < _workerCount; i++) {
+            // spread the remainder over the first workers
+            uint32_t end = begin + itemsPerWorker + (i < remainder ? 1 : 0);
+            _ranges[i].bounds.store(Pack(begin, end), std::memory_order_relaxed);
+            begin = end;
+        }
+    }
+
+    std::optional<size_t> WorkStealingRanges::Next(size_t workerIndex) {
+        auto& range = _ranges[workerIndex].bounds;
+        auto bounds = range.load(std::memory_order_acquire);
+
+        while (Begin(bounds) < End(bounds)) {
+            // on failure bounds is reloaded, which happens when a thief took part of our range
+            if (range.compare_exchange_weak(bounds, Pack(Begin(bounds) + 1, End(bounds)), std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return Begin(bounds);
+            }
+        }
+
+        return Steal(workerIndex);
+    }
+
+    std::optional<size_t> WorkStealingRanges::Steal(size_t workerIndex) {
+        // keep scanning as long as there's anything left anywhere, a single failed CAS doesn't mean there's nothing to steal
+        bool foundWork = true;
+        while (foundWork) {
+            foundWork = false;
+            for (size_t offset = 1; offset < _workerCount; offset++) {
+                auto& victim = _ranges[(workerIndex + offset) % _workerCount].bounds;
+                auto bounds = victim.load(std::memory_order_acquire);
+                auto begin = Begin(bounds);
+                auto end = End(bounds);
+                if (begin >= end) continue;
+                foundWork = true;
+
+                // take the back half, rounded up so a single remaining item can be stolen as well
+                auto stealCount = (end - begin + 1) / 2;
+                auto newEnd = end - stealCount;
+                if (!victim.compare_exchange_strong(bounds, Pack(begin, newEnd), std::memory_order_acq_rel, std::memory_order_acquire)) continue;
+
+                // our own range is empty here so nobody else will successfully CAS it, the first stolen item is ours right away
+                _ranges[workerIndex].bounds.store(Pack(newEnd + 1, end), std::memory_order_release);
+                return newEnd;
+            }
+        }
+
+        return std::nullopt;
+    }
+}
@@ -0,0 +1,109 @@
+#include "Utils/XXHash64.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace SongCore::Utils {
+    static constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+    static constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+    static constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ULL;
+
+    static inline uint64_t RotateLeft(uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    // quest and every other platform we build for is little endian, which is what xxhash reads words as
+    static inline uint64_t Read64(uint8_t const* data) {
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    static inline uint32_t Read32(uint8_t const* data) {
+        uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return value;
+    }
+
+    static inline uint64_t Round(uint64_t accumulator, uint64_t input) {
+        accumulator += input * PRIME2;
+        accumulator = RotateLeft(accumulator, 31);
+        return accumulator * PRIME1;
+    }
+
+    static inline uint64_t MergeRound(uint64_t accumulator, uint64_t value) {
+        accumulator ^= Round(0, value);
+        return accumulator * PRIME1 + PRIME4;
+    }
+
+    XXHash64::XXHash64(uint64_t seed) :
+        _seed(seed),
+        _accumulators{ seed + PRIME1 + PRIME2, seed + PRIME2, seed, seed - PRIME1 } {}
+
+    void XXHash64::Update(void const* data, size_t size) {
+        auto bytes = static_cast<uint8_t const*>(data);
+        _totalSize += size;
+
+        if (_bufferSize > 0) {
+            size_t toCopy = std::min(size, STRIPE_SIZE - _bufferSize);
+            std::memcpy(_buffer.data() + _bufferSize, bytes, toCopy);
+            _bufferSize += toCopy;
+            bytes += toCopy;
+            size -= toCopy;
+
+            if (_bufferSize < STRIPE_SIZE) return;
+            for (size_t i = 0; i < 4; i++) _accumulators[i] = Round(_accumulators[i], Read64(_buffer.data() + i * 8));
+            _bufferSize = 0;
+        }
+
+        for (; size >= STRIPE_SIZE; bytes += STRIPE_SIZE, size -= STRIPE_SIZE) {
+            for (size_t i = 0; i < 4; i++) _accumulators[i] = Round(_accumulators[i], Read64(bytes + i * 8));
+        }
+
+        std::memcpy(_buffer.data(), bytes, size);
+        _bufferSize = size;
+    }
+
+    uint64_t XXHash64::Digest() const {
+        uint64_t hash;
+        if (_totalSize >= STRIPE_SIZE) {
+            auto const& [a1, a2, a3, a4] = _accumulators;
+            hash = RotateLeft(a1, 1) + RotateLeft(a2, 7) + RotateLeft(a3, 12) + RotateLeft(a4, 18);
+            for (auto accumulator : _accumulators) hash = MergeRound(hash, accumulator);
+        } else {
+            hash = _seed + PRIME5;
+        }
+        hash += _totalSize;
+
+        auto bytes = _buffer.data();
+        auto end = bytes + _bufferSize;
+        for (; bytes + 8 <= end; bytes += 8) {
+            hash ^= Round(0, Read64(bytes));
+            hash = RotateLeft(hash, 27) * PRIME1 + PRIME4;
+        }
+        if (bytes + 4 <= end) {
+            hash ^= uint64_t(Read32(bytes)) * PRIME1;
+            hash = RotateLeft(hash, 23) * PRIME2 + PRIME3;
+            bytes += 4;
+        }
+        for (; bytes < end; bytes++) {
+            hash ^= *bytes * PRIME5;
+            hash = RotateLeft(hash, 11) * PRIME1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= PRIME2;
+        hash ^= hash >> 29;
+        hash *= PRIME3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    uint64_t XXHash64::Hash(void const* data, size_t size, uint64_t seed) {
+        XXHash64 hasher(seed);
+        hasher.Update(data, size);
+        return hasher.Digest();
+    }
+}
@@ -26,6 +26,10 @@ void SaveConfig() {
     SET(customSongEnvironmentColors);
     SET(disableOneSaberOverride);
     SET(dontShowSongloaderWarningAgain);
+    SET(enableLibraryWatcher);
+    SET(progressiveLoading);
+    SET(maxLoaderThreads);
+    SET(verifyLevelHashFiles);
 
     rapidjson::Value rootCustomLevelPaths;
     rootCustomLevelPaths.SetArray();
@@ -43,6 +47,14 @@ void SaveConfig() {
     }
     doc.AddMember("RootCustomWIPLevelPaths", rootCustomWIPLevelPaths, allocator);
 
+    rapidjson::Value contentFingerprintRootPaths;
+    contentFingerprintRootPaths.SetArray();
+    for (auto& path : config.ContentFingerprintRootPaths) {
+        auto pathString = path.string();
+        contentFingerprintRootPaths.PushBack(rapidjson::Value(pathString.c_str(), pathString.length(), allocator), allocator);
+    }
+    doc.AddMember("ContentFingerprintRootPaths", contentFingerprintRootPaths, allocator);
+
     get_config().Write();
     INFO("Config Saved!");
 }
@@ -64,6 +76,10 @@ bool LoadConfig() {
     GET(customSongEnvironmentColors);
     GET(disableOneSaberOverride);
     GET(dontShowSongloaderWarningAgain);
+    GET(enableLibraryWatcher);
+    GET(progressiveLoading);
+    GET(maxLoaderThreads);
+    GET(verifyLevelHashFiles);
 
     auto RootCustomLevelPathsItr = doc.FindMember("RootCustomLevelPaths");
     if (RootCustomLevelPathsItr != doc.MemberEnd() && RootCustomLevelPathsItr->value.IsArray()) {
@@ -87,6 +103,17 @@ bool LoadConfig() {
         foundEverything = false;
     }
 
+    auto ContentFingerprintRootPathsItr = doc.FindMember("ContentFingerprintRootPaths");
+    if (ContentFingerprintRootPathsItr != doc.MemberEnd() && ContentFingerprintRootPathsItr->value.IsArray()) {
+        config.ContentFingerprintRootPaths.clear();
+        auto arr = ContentFingerprintRootPathsItr->value.GetArray();
+        for (auto itr = arr.Begin(); itr != arr.End(); itr++) {
+            config.ContentFingerprintRootPaths.emplace_back(itr->Get<std::string>());
+        }
+    } else {
+        foundEverything = false;
+    }
+
     if (foundEverything)
         INFO("Config Loaded!");
 
@@ -12,6 +12,7 @@
 #include "UI/RefreshSongButton.hpp"
 #include "UI/SongLoaderWarning.hpp"
 #include "Utils/Cache.hpp"
+#include "Utils/DirectoryManifest.hpp"
 
 #include "UI/ProgressBar.hpp"
 #include "_config.h"
@@ -56,6 +57,9 @@ SONGCORE_EXPORT_FUNC void setup(CModInfo* info) {
     info->version = VERSION;
 
     getConfig().Load();
+    // the cache and the directory manifest load while the game does, anything using them waits until they're done
+    SongCore::Utils::LoadSongInfoCacheAsync();
+    SongCore::Utils::LoadDirectoryManifestAsync();
     INFO("Completed setup!");
 }
 
@@ -89,9 +93,6 @@ SONGCORE_EXPORT_FUNC void late_load() {
     SongCore::Hooking::InstallHooks();
     auto z = Lapiz::Zenject::Zenjector::Get();
 
-    // load cached hashes n stuff
-    if (!SongCore::Utils::LoadSongInfoCache()) SongCore::Utils::SaveSongInfoCache();
-
     EnsureNoMedia();
 
     auto preferredCustomLevelPath = SongCore::API::Loading::GetPreferredCustomLevelPath();
@@ -0,0 +1,133 @@
+#include "tracing.hpp"
+
+#ifdef SONGCORE_TRACING
+
+#include "config.hpp"
+#include "logging.hpp"
+#include "beatsaber-hook/shared/config/rapidjson-utils.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <vector>
+#include <unistd.h>
+
+namespace SongCore::Tracing {
+    /// @brief events past this are dropped until the next flush, so a forgotten flush can't eat all memory
+    static constexpr size_t MAX_EVENTS = 1'000'000;
+
+    struct Event {
+        std::string_view name;
+        std::string detail;
+        /// @brief 'X' for complete events, 'i' for instant ones
+        char phase;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::nanoseconds duration;
+        pid_t threadId;
+    };
+
+    static std::mutex _eventsMutex;
+    static std::vector<Event> _events;
+    static size_t _droppedEvents = 0;
+    static std::filesystem::path _tracePath = SONGCORE_DATA_PATH "/Traces";
+    /// @brief timestamps are written relative to this, perfetto doesn't care where they start
+    static auto const _epoch = std::chrono::steady_clock::now();
+
+    static void Record(Event event) {
+        std::lock_guard<std::mutex> lock(_eventsMutex);
+        if (_events.size() >= MAX_EVENTS) {
+            _droppedEvents++;
+            return;
+        }
+        _events.emplace_back(std::move(event));
+    }
+
+    Scope::Scope(std::string_view name, std::string_view detail) :
+        _name(name),
+        _detail(detail),
+        _start(std::chrono::steady_clock::now()) {}
+
+    Scope::~Scope() {
+        Record({ _name, std::move(_detail), 'X', _start, std::chrono::steady_clock::now() - _start, gettid() });
+    }
+
+    void Instant(std::string_view name, std::string_view detail) {
+        Record({ name, std::string(detail), 'i', std::chrono::steady_clock::now(), std::chrono::nanoseconds(0), gettid() });
+    }
+
+    static double ToMicroseconds(std::chrono::nanoseconds time) {
+        return std::chrono::duration<double, std::micro>(time).count();
+    }
+
+    void Flush(std::string_view label) {
+        std::vector<Event> events;
+        size_t droppedEvents;
+        {
+            std::lock_guard<std::mutex> lock(_eventsMutex);
+            events.swap(_events);
+            droppedEvents = _droppedEvents;
+            _droppedEvents = 0;
+        }
+        if (events.empty()) return;
+
+        // written with the sax writer, a document of every event would double the memory used
+        rapidjson::StringBuffer buff;
+        rapidjson::Writer writer(buff);
+        auto pid = getpid();
+
+        writer.StartObject();
+        writer.Key("traceEvents");
+        writer.StartArray();
+        for (auto const& event : events) {
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(event.name.data(), event.name.size());
+            writer.Key("cat");
+            writer.String("songcore");
+            writer.Key("ph");
+            writer.String(&event.phase, 1);
+            writer.Key("ts");
+            writer.Double(ToMicroseconds(event.start - _epoch));
+            if (event.phase == 'X') {
+                writer.Key("dur");
+                writer.Double(ToMicroseconds(event.duration));
+            } else {
+                // instant events are scoped to their thread
+                writer.Key("s");
+                writer.String("t");
+            }
+            writer.Key("pid");
+            writer.Int(pid);
+            writer.Key("tid");
+            writer.Int(event.threadId);
+            if (!event.detail.empty()) {
+                writer.Key("args");
+                writer.StartObject();
+                writer.Key("detail");
+                writer.String(event.detail.c_str(), event.detail.size());
+                writer.EndObject();
+            }
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.Key("displayTimeUnit");
+        writer.String("ms");
+        writer.EndObject();
+
+        std::error_code error;
+        std::filesystem::create_directories(_tracePath, error);
+        auto filePath = _tracePath / fmt::format("{}-{}.json", label, std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+
+        std::ofstream traceFile(filePath, std::ios::out);
+        if (!traceFile.is_open()) {
+            ERROR("Could not open trace file {}", filePath.string());
+            return;
+        }
+        traceFile.write(buff.GetString(), buff.GetLength());
+
+        if (droppedEvents > 0) WARNING("Dropped {} trace events after reaching the limit of {}", droppedEvents, MAX_EVENTS);
+        INFO("Wrote {} trace events to {}", events.size(), filePath.string());
+    }
+}
+
+#endif
@@ -0,0 +1,28 @@
+#pragma once
+// helpers shared by the host benchmarks. They are run by hand and print their timings, they don't fail on them
+#include "TestHelpers.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+
+namespace SongCore::Benchmarks {
+    /// @brief runs the function the given amount of times, the best run is what's left after the noise of the machine
+    /// @return milliseconds of the fastest run
+    template<typename Function>
+    double MeasureBest(int runs, Function&& function) {
+        double best = std::numeric_limits<double>::max();
+        for (int i = 0; i < runs; i++) {
+            auto start = std::chrono::steady_clock::now();
+            function();
+            best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    }
+
+    /// @brief integer argument of the benchmark, or the fallback if it wasn't given
+    inline long ArgumentOr(int argc, char** argv, int index, long fallback) {
+        return argc > index ? std::atol(argv[index]) : fallback;
+    }
+}
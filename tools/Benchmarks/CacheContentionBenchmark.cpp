@@ -0,0 +1,125 @@
+// hammers the song info cache from 8, 12 and 16 threads with the lookups and updates the hash and duration stages of a refresh make,
+// against the single mutex over one map the cache used to be. Both take the same directory fingerprint, so the difference is the locking and copying
+#include "BenchmarkHelpers.hpp"
+#include "SongLoader/LevelMetadata.hpp"
+#include "Utils/Cache.hpp"
+#include "Utils/Directory.hpp"
+#include "Utils/Fingerprint.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace SongCore;
+
+struct BenchmarkLevel {
+    std::filesystem::path path;
+    std::vector<Utils::DirectoryEntry> entries;
+};
+
+/// @brief the cache before it was sharded: one shared mutex over one map, and updates are a copy of the entry that's set again
+class SingleMutexCache {
+    public:
+        void Set(std::filesystem::path const& levelPath, Utils::CachedSongData const& data) {
+            std::unique_lock<std::shared_mutex> lock(_mutex);
+            _songData[levelPath.string()] = data;
+        }
+
+        std::optional<Utils::CachedSongData> Get(BenchmarkLevel const& level) {
+            auto fingerprint = Utils::GetDirectoryFingerprint(level.path, level.entries);
+            if (!fingerprint.has_value()) return std::nullopt;
+            std::shared_lock<std::shared_mutex> lock(_mutex);
+            auto itr = _songData.find(level.path.string());
+            if (itr == _songData.end() || itr->second.directoryFingerprint != *fingerprint) return std::nullopt;
+            return itr->second;
+        }
+
+        void UpdateDuration(BenchmarkLevel const& level, float duration) {
+            std::optional<Utils::CachedSongData> data;
+            {
+                std::shared_lock<std::shared_mutex> lock(_mutex);
+                auto itr = _songData.find(level.path.string());
+                if (itr != _songData.end()) data = itr->second;
+            }
+            if (!data.has_value()) return;
+            data->songDuration = duration;
+            Set(level.path, *data);
+        }
+    private:
+        std::shared_mutex _mutex;
+        std::unordered_map<std::string, Utils::CachedSongData> _songData;
+};
+
+/// @brief runs the function on the given amount of threads, each going over every level from its own starting point like workers spread over a refresh
+/// @return milliseconds until the last thread finished
+template<typename Function>
+static double RunThreads(int threadCount, int rounds, std::vector<BenchmarkLevel> const& levels, Function&& function) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t](){
+            size_t offset = levels.size() * t / threadCount;
+            for (int round = 0; round < rounds; round++) {
+                for (size_t i = 0; i < levels.size(); i++) function(levels[(offset + i) % levels.size()]);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv) {
+    long levelCount = Benchmarks::ArgumentOr(argc, argv, 1, 1000);
+    int rounds = Benchmarks::ArgumentOr(argc, argv, 2, 5);
+    auto directory = Tests::EnterTestDirectory("CacheContentionBenchmark");
+
+    // real folders, the lookups take their fingerprint like the read stage does
+    std::vector<BenchmarkLevel> levels(levelCount);
+    SingleMutexCache singleMutexCache;
+    for (long i = 0; i < levelCount; i++) {
+        auto& level = levels[i];
+        level.path = directory / "CustomLevels" / fmt::format("Level{}", i);
+        Tests::WriteLevel(level.path, level.path.filename().string());
+        CHECK(Utils::ListDirectory(level.path, level.entries));
+
+        SongLoader::LevelMetadata metadata;
+        metadata.songName = level.path.filename().string();
+        auto data = Utils::GetCachedInfo(level.path, level.entries);
+        CHECK(data.has_value());
+        data->sha1 = std::string(40, 'A');
+        data->songDuration = 0;
+        data->levelMetadata = metadata.Serialize();
+        Utils::SetCachedInfo(level.path, *data);
+        singleMutexCache.Set(level.path, *data);
+    }
+
+    // with fewer cores than threads they mostly take turns, the locks only get contended on as many cores as the quest has
+    fmt::print("{} levels, {} rounds per thread, a lookup and an update per level, {} cores\n", levelCount, rounds, std::thread::hardware_concurrency());
+    fmt::print("{:>8} {:>16} {:>16} {:>10}\n", "threads", "sharded ops/s", "one mutex ops/s", "speedup");
+    for (int threadCount : { 8, 12, 16 }) {
+        std::atomic<size_t> misses = 0;
+        double shardedTime = RunThreads(threadCount, rounds, levels, [&](BenchmarkLevel const& level){
+            auto data = Utils::GetCachedInfo(level.path, level.entries);
+            if (!data.has_value() || !data->sha1.has_value()) misses++;
+            Utils::UpdateCachedInfo(level.path, [](Utils::CachedSongData& data){ data.songDuration = 1; });
+        });
+        double singleMutexTime = RunThreads(threadCount, rounds, levels, [&](BenchmarkLevel const& level){
+            if (!singleMutexCache.Get(level).has_value()) misses++;
+            singleMutexCache.UpdateDuration(level, 1);
+        });
+        CHECK(misses == 0);
+
+        double ops = 2.0 * threadCount * rounds * levelCount;
+        fmt::print("{:>8} {:>16.0f} {:>16.0f} {:>9.2f}x\n", threadCount, ops / (shardedTime / 1000), ops / (singleMutexTime / 1000), singleMutexTime / shardedTime);
+    }
+
+    Tests::LeaveTestDirectory(directory);
+    return 0;
+}
@@ -0,0 +1,59 @@
+// compares finding the level folders of a generated library through getdents listings against the recursive_directory_iterator walk it replaced
+#include "BenchmarkHelpers.hpp"
+#include "Utils/Directory.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace SongCore;
+
+/// @brief the level discovery from before the getdents listings, a stat for every directory entry and every info.dat candidate
+static void CollectLevelFoldersIterator(std::filesystem::path const& root, std::vector<std::filesystem::path>& out) {
+    std::error_code error_code;
+    auto iterator = std::filesystem::recursive_directory_iterator(root, error_code);
+    if (error_code) return;
+
+    for (auto entry : iterator) {
+        if (!entry.is_directory()) continue;
+        auto songPath = entry.path();
+        if (songPath.string().ends_with("autosaves")) continue;
+
+        auto dataPath = songPath / "info.dat";
+        if (!std::filesystem::exists(dataPath)) {
+            dataPath = songPath / "Info.dat";
+            if (!std::filesystem::exists(dataPath)) continue;
+        }
+        out.emplace_back(songPath);
+    }
+}
+
+int main(int argc, char** argv) {
+    long levelCount = Benchmarks::ArgumentOr(argc, argv, 1, 2000);
+    int runs = Benchmarks::ArgumentOr(argc, argv, 2, 10);
+    auto directory = Tests::EnterTestDirectory("DirectoryListingBenchmark");
+
+    // a library like a real one, levels in packs next to loose ones, with a few files each
+    auto root = directory / "CustomLevels";
+    for (long i = 0; i < levelCount; i++) {
+        auto levelPath = i % 4 == 0 ? root / fmt::format("Pack{}", i / 100) / fmt::format("Level{}", i) : root / fmt::format("Level{}", i);
+        Tests::WriteLevel(levelPath, fmt::format("Level{}", i));
+        Tests::WriteFile(levelPath / "Hard.dat", "{}");
+        Tests::WriteFile(levelPath / "song.ogg", "");
+        Tests::WriteFile(levelPath / "cover.jpg", "");
+    }
+
+    std::vector<std::filesystem::path> getdentsFolders, iteratorFolders;
+    double getdentsTime = Benchmarks::MeasureBest(runs, [&](){ getdentsFolders.clear(); Utils::CollectLevelFolders(root, getdentsFolders); });
+    double iteratorTime = Benchmarks::MeasureBest(runs, [&](){ iteratorFolders.clear(); CollectLevelFoldersIterator(root, iteratorFolders); });
+    CHECK(getdentsFolders.size() == static_cast<size_t>(levelCount));
+    CHECK(iteratorFolders.size() == static_cast<size_t>(levelCount));
+
+    // both walks run on a warm page cache, this compares the syscalls and not the storage
+    fmt::print("{} levels, best of {} runs\n", levelCount, runs);
+    fmt::print("getdents listings:            {:8.2f} ms\n", getdentsTime);
+    fmt::print("recursive_directory_iterator: {:8.2f} ms, {:.2f}x slower\n", iteratorTime, iteratorTime / getdentsTime);
+
+    Tests::LeaveTestDirectory(directory);
+    return 0;
+}
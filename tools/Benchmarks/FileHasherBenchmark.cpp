@@ -0,0 +1,96 @@
+// compares hashing generated levels with FileHasher against reading every file through its own std::ifstream, like the per file sources it replaced.
+// CryptoPP isn't part of the host build, so its FileSource is stood in for by an ifstream per file read in 4 KB pieces into the portable sha1 kernel
+#include "BenchmarkHelpers.hpp"
+#include "Utils/FileHasher.hpp"
+#include "Utils/Sha1.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace SongCore;
+
+using Level = std::vector<std::filesystem::path>;
+
+/// @brief the hashing from before FileHasher, a stream per file that goes through its own small buffer
+static std::string HashFilesIfstream(Level const& files, Utils::Sha1 sha1) {
+    static constexpr char hexChars[] = "0123456789ABCDEF";
+
+    for (auto const& file : files) {
+        std::ifstream stream(file, std::ios::binary);
+        char buffer[4096];
+        while (stream.read(buffer, sizeof(buffer)) || stream.gcount() > 0) {
+            sha1.Update(reinterpret_cast<uint8_t const*>(buffer), stream.gcount());
+        }
+    }
+
+    std::string hex;
+    for (auto b : sha1.Final()) {
+        hex.push_back(hexChars[b >> 4]);
+        hex.push_back(hexChars[b & 0xF]);
+    }
+    return hex;
+}
+
+static std::string HashFilesFileHasher(Level const& files) {
+    Utils::FileHasher hasher;
+    for (auto const& file : files) CHECK(hasher.AddFile(file));
+    return hasher.FinalHex();
+}
+
+/// @brief writes a level of files with the given sizes, each size offset by the level index so no two levels hash the same
+static Level WriteLevel(std::filesystem::path const& levelPath, long index, std::vector<size_t> const& sizes, size_t& totalBytes) {
+    Level files;
+    for (size_t i = 0; i < sizes.size(); i++) {
+        files.emplace_back(levelPath / (i == 0 ? std::string("info.dat") : fmt::format("File{}.dat", i)));
+        Tests::WriteFile(files.back(), std::string(sizes[i] + index, static_cast<char>('a' + i)));
+        totalBytes += sizes[i] + index;
+    }
+    return files;
+}
+
+static void Compare(std::string_view name, std::vector<Level> const& levels, size_t totalBytes, int runs) {
+    auto portable = Utils::Sha1::GetAvailableKernels().front().compress;
+    std::vector<std::string> hasherHashes(levels.size()), ifstreamHashes(levels.size()), standInHashes(levels.size());
+    double hasherTime = Benchmarks::MeasureBest(runs, [&](){ for (size_t i = 0; i < levels.size(); i++) hasherHashes[i] = HashFilesFileHasher(levels[i]); });
+    double ifstreamTime = Benchmarks::MeasureBest(runs, [&](){ for (size_t i = 0; i < levels.size(); i++) ifstreamHashes[i] = HashFilesIfstream(levels[i], Utils::Sha1()); });
+    double standInTime = Benchmarks::MeasureBest(runs, [&](){ for (size_t i = 0; i < levels.size(); i++) standInHashes[i] = HashFilesIfstream(levels[i], Utils::Sha1(portable)); });
+    CHECK(hasherHashes == ifstreamHashes);
+    CHECK(hasherHashes == standInHashes);
+
+    double megabytes = totalBytes / (1024.0 * 1024.0);
+    fmt::print("{}: {} levels, {:.1f} MB, best of {} runs\n", name, levels.size(), megabytes, runs);
+    fmt::print("  FileHasher:                          {:8.2f} ms, {:8.1f} MB/s\n", hasherTime, megabytes / (hasherTime / 1000));
+    fmt::print("  ifstream per file, same kernel:      {:8.2f} ms, {:8.1f} MB/s, {:.2f}x slower\n", ifstreamTime, megabytes / (ifstreamTime / 1000), ifstreamTime / hasherTime);
+    fmt::print("  CryptoPP stand-in, portable kernel:  {:8.2f} ms, {:8.1f} MB/s, {:.2f}x slower\n", standInTime, megabytes / (standInTime / 1000), standInTime / hasherTime);
+}
+
+int main(int argc, char** argv) {
+    long levelCount = Benchmarks::ArgumentOr(argc, argv, 1, 50);
+    int runs = Benchmarks::ArgumentOr(argc, argv, 2, 5);
+    auto directory = Tests::EnterTestDirectory("FileHasherBenchmark");
+
+    // levels are hashed without their audio in v2, so a level is an info.dat and a few beatmaps of a few hundred KB
+    std::vector<Level> beatmapLevels;
+    size_t beatmapBytes = 0;
+    for (long i = 0; i < levelCount; i++) {
+        beatmapLevels.emplace_back(WriteLevel(directory / fmt::format("Beatmaps{}", i), i, { 2048, 256 * 1024, 512 * 1024, 768 * 1024, 1024 * 1024 }, beatmapBytes));
+    }
+
+    // files the size of a song's audio, a few MB each, where the read size and the buffering matter the most
+    std::vector<Level> audioLevels;
+    size_t audioBytes = 0;
+    for (long i = 0; i < std::max(levelCount / 5, 1L); i++) {
+        audioLevels.emplace_back(WriteLevel(directory / fmt::format("Audio{}", i), i, { 2048, 3 * 1024 * 1024, 5 * 1024 * 1024, 8 * 1024 * 1024 }, audioBytes));
+    }
+
+    // everything is read from a warm page cache, this compares the reads and the hashing and not the storage
+    fmt::print("sha1 on {}. The baseline is a stand-in for the CryptoPP FileSource the mod hashed with before, not CryptoPP itself:\n"
+               "an ifstream per file read in 4 KB pieces into the portable kernel\n", Utils::Sha1::get_KernelName());
+    Compare("beatmap sized files", beatmapLevels, beatmapBytes, runs);
+    Compare("audio sized files", audioLevels, audioBytes, runs);
+
+    Tests::LeaveTestDirectory(directory);
+    return 0;
+}
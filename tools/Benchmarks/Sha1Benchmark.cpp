@@ -0,0 +1,46 @@
+// hashes the same buffer with every sha1 kernel this cpu has, the same list Sha1Test checks, and prints the throughput of each against the portable one
+#include "BenchmarkHelpers.hpp"
+#include "Utils/Sha1.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <random>
+#include <vector>
+
+using namespace SongCore;
+
+int main(int argc, char** argv) {
+    long megabytes = Benchmarks::ArgumentOr(argc, argv, 1, 64);
+    int runs = Benchmarks::ArgumentOr(argc, argv, 2, 5);
+
+    // random contents, so nothing about the data makes one kernel look better than it is
+    std::vector<uint8_t> data(megabytes * 1024 * 1024);
+    std::mt19937 random(42);
+    for (auto& b : data) b = static_cast<uint8_t>(random());
+
+    auto kernels = Utils::Sha1::GetAvailableKernels();
+    fmt::print("{} MB, best of {} runs, the refresh hashes on {}\n", megabytes, runs, Utils::Sha1::get_KernelName());
+
+    std::optional<Utils::Sha1::Digest> portableDigest;
+    double portableTime = 0;
+    for (auto const& kernel : kernels) {
+        Utils::Sha1::Digest digest;
+        double time = Benchmarks::MeasureBest(runs, [&](){
+            // fed in the chunk size FileHasher reads files with
+            Utils::Sha1 sha1(kernel.compress);
+            for (size_t offset = 0; offset < data.size(); offset += 1024 * 1024) {
+                sha1.Update(data.data() + offset, std::min<size_t>(1024 * 1024, data.size() - offset));
+            }
+            digest = sha1.Final();
+        });
+
+        // the portable kernel comes first, every other one has to agree with it
+        if (!portableDigest.has_value()) {
+            portableDigest = digest;
+            portableTime = time;
+        }
+        CHECK(digest == *portableDigest);
+        fmt::print("{:<12} {:8.2f} ms, {:8.1f} MB/s, {:.2f}x the portable kernel\n", kernel.name, time, megabytes / (time / 1000), portableTime / time);
+    }
+    return 0;
+}
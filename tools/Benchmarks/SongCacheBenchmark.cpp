@@ -0,0 +1,92 @@
+// saves and loads song info caches of generated entries at 1k, 10k and 100k levels, the binary cache file against the json cache it replaced.
+// The json numbers are from the rapidjson the host tools build with, they are a baseline for the trend and not the exact time on the quest
+#include "BenchmarkHelpers.hpp"
+#include "SongLoader/LevelMetadata.hpp"
+#include "Utils/Cache.hpp"
+#include "Utils/SongCacheFile.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace SongCore;
+
+/// @brief entries like a refresh caches them, sorted on path like the cache file keeps them
+static std::vector<std::pair<std::string, Utils::CachedSongData>> GenerateEntries(size_t count) {
+    std::mt19937_64 random(42);
+    std::vector<std::pair<std::string, Utils::CachedSongData>> entries;
+    entries.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        SongLoader::LevelMetadata metadata;
+        metadata.songName = fmt::format("Song {}", i);
+        metadata.songAuthorName = "Author";
+        metadata.levelAuthorName = "Mapper";
+
+        Utils::CachedSongData data;
+        data.directoryFingerprint = random();
+        data.sha1 = fmt::format("{:016X}{:016X}{:08X}", random(), random(), static_cast<uint32_t>(random()));
+        data.songDuration = 120 + i % 180;
+        data.levelMetadata = metadata.Serialize();
+        entries.emplace_back(fmt::format("/sdcard/ModData/com.beatgames.beatsaber/Mods/SongCore/CustomLevels/{:x} (Song {} - Mapper)", i, i), std::move(data));
+    }
+    std::sort(entries.begin(), entries.end(), [](auto const& a, auto const& b){ return a.first < b.first; });
+    return entries;
+}
+
+/// @brief replaces whatever the cache has with the entries, as unsaved changes
+static void FillCache(std::vector<std::pair<std::string, Utils::CachedSongData>> const& entries) {
+    Utils::ClearSongInfoCache();
+    for (auto const& [levelPath, data] : entries) Utils::SetCachedInfo(levelPath, data);
+}
+
+int main(int argc, char** argv) {
+    int runs = Benchmarks::ArgumentOr(argc, argv, 1, 5);
+    auto directory = Tests::EnterTestDirectory("SongCacheBenchmark");
+    std::filesystem::path const cachePath = SONGCORE_DATA_PATH "/CachedSongData.bin";
+    std::filesystem::path const jsonPath = "CachedSongData.json";
+
+    fmt::print("best of {} runs\n", runs);
+    fmt::print("{:>8} {:>12} {:>12} {:>12} {:>12} {:>14} {:>12}\n", "entries", "save ms", "load ms", "lookups ms", "json save", "json load ms", "file MB");
+    for (size_t count : { 1000, 10000, 100000 }) {
+        auto entries = GenerateEntries(count);
+
+        // a save after a clear rewrites the whole file, the same as the compaction after a refresh
+        double saveTime = std::numeric_limits<double>::max();
+        for (int i = 0; i < runs; i++) {
+            FillCache(entries);
+            saveTime = std::min(saveTime, Benchmarks::MeasureBest(1, [](){ Utils::SaveSongInfoCache(); }));
+        }
+        CHECK(std::filesystem::exists(cachePath));
+        auto fileSize = std::filesystem::file_size(cachePath);
+
+        double loadTime = Benchmarks::MeasureBest(runs, [](){
+            Utils::ClearSongInfoCache();
+            CHECK(Utils::LoadSongInfoCache());
+        });
+
+        // what the read stage does for every level once the cache is loaded
+        Utils::MappedSongCache mapped;
+        CHECK(mapped.Open(cachePath));
+        CHECK(mapped.get_Count() == count);
+        double lookupTime = Benchmarks::MeasureBest(runs, [&](){
+            for (auto const& [levelPath, data] : entries) CHECK(mapped.Find(levelPath) == data);
+        });
+        mapped.Close();
+
+        FillCache(entries);
+        double jsonSaveTime = Benchmarks::MeasureBest(runs, [&](){ CHECK(Utils::ExportSongInfoCacheJson(jsonPath)); });
+        double jsonLoadTime = Benchmarks::MeasureBest(runs, [&](){
+            Utils::ClearSongInfoCache();
+            CHECK(Utils::ImportSongInfoCacheJson(jsonPath));
+        });
+
+        fmt::print("{:>8} {:>12.2f} {:>12.2f} {:>12.2f} {:>12.2f} {:>14.2f} {:>12.2f}\n", count, saveTime, loadTime, lookupTime, jsonSaveTime, jsonLoadTime, fileSize / (1024.0 * 1024.0));
+    }
+
+    Tests::LeaveTestDirectory(directory);
+    return 0;
+}
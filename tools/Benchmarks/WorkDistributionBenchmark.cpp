@@ -0,0 +1,85 @@
+// compares distributing refresh work through the work stealing ranges against the static split and the shared locked iterator they replaced, from 1 to 16 workers,
+// on work where a few items take much longer than the rest like large levels do
+#include "BenchmarkHelpers.hpp"
+#include "Utils/WorkStealing.hpp"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace SongCore;
+
+/// @brief busy work standing in for loading a level, so the measurement isn't about the scheduler waking threads
+static uint64_t Work(uint32_t cost) {
+    uint64_t value = cost;
+    for (uint32_t i = 0; i < cost * 64; i++) value = value * 6364136223846793005ull + 1442695040888963407ull;
+    return value;
+}
+
+/// @brief runs one thread per worker that claims items through the function until it returns nullopt
+static double Run(int runs, size_t workerCount, std::vector<uint32_t> const& costs, std::function<std::function<std::optional<size_t>(size_t)>()> const& makeClaimer) {
+    std::atomic<uint64_t> sink = 0;
+    return Benchmarks::MeasureBest(runs, [&](){
+        auto claim = makeClaimer();
+        std::vector<std::thread> threads;
+        for (size_t worker = 0; worker < workerCount; worker++) {
+            threads.emplace_back([&, worker](){
+                uint64_t value = 0;
+                while (auto index = claim(worker)) value += Work(costs[*index]);
+                sink += value;
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    });
+}
+
+int main(int argc, char** argv) {
+    size_t itemCount = Benchmarks::ArgumentOr(argc, argv, 1, 20000);
+    int runs = Benchmarks::ArgumentOr(argc, argv, 2, 5);
+
+    // most levels are small, a few are large, and they cluster like packs of big maps do in a sorted library
+    std::mt19937 random(42);
+    std::vector<uint32_t> costs(itemCount);
+    for (size_t i = 0; i < itemCount; i++) costs[i] = 10 + random() % 20;
+    for (size_t i = itemCount / 3; i < itemCount / 3 + itemCount / 50; i++) costs[i] = 1000;
+
+    fmt::print("{} items, best of {} runs, in items/s\n", itemCount, runs);
+    fmt::print("{:>7} {:>14} {:>14} {:>14} {:>9}\n", "workers", "static split", "locked", "stealing", "vs static");
+    // the refresh runs anywhere from a single worker on a busy pool to twice the cores of the quest for reading
+    for (size_t workerCount : { 1, 2, 4, 8, 16 }) {
+        double staticTime = Run(runs, workerCount, costs, [&](){
+            // every worker gets a fixed contiguous range up front, like the refresh split its levels before
+            auto next = std::make_shared<std::vector<size_t>>(workerCount);
+            return [=](size_t worker) -> std::optional<size_t> {
+                size_t end = itemCount * (worker + 1) / workerCount;
+                size_t& index = (*next)[worker];
+                if (index == 0) index = itemCount * worker / workerCount;
+                if (index >= end) return std::nullopt;
+                return index++;
+            };
+        });
+
+        double lockedTime = Run(runs, workerCount, costs, [&](){
+            // a single iterator behind a mutex, shared by every worker
+            auto state = std::make_shared<std::pair<std::mutex, size_t>>();
+            return [=](size_t) -> std::optional<size_t> {
+                std::lock_guard<std::mutex> lock(state->first);
+                if (state->second >= itemCount) return std::nullopt;
+                return state->second++;
+            };
+        });
+
+        double stealingTime = Run(runs, workerCount, costs, [&](){
+            auto ranges = std::make_shared<Utils::WorkStealingRanges>(itemCount, workerCount);
+            return [=](size_t worker){ return ranges->Next(worker); };
+        });
+
+        auto itemsPerSecond = [&](double milliseconds){ return itemCount / (milliseconds / 1000); };
+        fmt::print("{:>7} {:>14.0f} {:>14.0f} {:>14.0f} {:>8.2f}x\n", workerCount, itemsPerSecond(staticTime), itemsPerSecond(lockedTime), itemsPerSecond(stealingTime), staticTime / stealingTime);
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "Utils/Cache.hpp"
+#include "Utils/Directory.hpp"
+#include "Utils/FileHasher.hpp"
+#include "Utils/Fingerprint.hpp"
+#include "Utils/HashedLevelFiles.hpp"
+#include "Utils/OggVorbis.hpp"
+#include "Utils/SongCacheFile.hpp"
+#include "Utils/WavRiff.hpp"
+#include "logging.hpp"
+#include "beatsaber-hook/shared/config/rapidjson-utils.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace SongCore::Utils;
+
+/// @brief string member of a json object, or nullopt if it isn't there or isn't a string
+static std::optional<std::string> GetString(rapidjson::Value const& value, char const* name) {
+    if (!value.IsObject()) return std::nullopt;
+    auto itr = value.FindMember(name);
+    if (itr == value.MemberEnd() || !itr->value.IsString()) return std::nullopt;
+    return itr->value.Get<std::string>();
+}
+
+/// @brief valid length of an audio file, trying ogg and then wav like the mod does
+static std::optional<float> GetSongDuration(std::filesystem::path const& songPath) {
+    if (!std::filesystem::exists(songPath)) return std::nullopt;
+    for (auto getLength : { +[](std::filesystem::path const& path){ return GetLengthFromOggVorbis(path); }, +[](std::filesystem::path const& path){ return GetLengthFromWavRiff(path); } }) {
+        float songDuration = getLength(songPath);
+        if (songDuration >= 0 && !std::isnan(songDuration)) return songDuration;
+    }
+    return std::nullopt;
+}
+
+/// @brief calculates what the mod would cache for a level, keyed on nothing yet
+/// @return the data, or nullopt if the folder can't be read or isn't a level
+static std::optional<CachedSongData> PrebuildLevel(std::filesystem::path const& levelPath) {
+    std::vector<DirectoryEntry> entries;
+    if (!ListDirectory(levelPath, entries)) return std::nullopt;
+    auto infoName = FindInfoDat(entries);
+    if (!infoName.has_value()) return std::nullopt;
+
+    // the device only trusts prebuilt entries whose sampled content matches, the other fingerprints don't survive a copy
+    CachedSongData data;
+    data.contentFingerprint = GetContentFingerprint(levelPath, entries);
+    if (!data.contentFingerprint.has_value()) return std::nullopt;
+
+    auto infoPath = levelPath / *infoName;
+    std::ifstream infoFile(infoPath, std::ios::binary);
+    std::string infoText((std::istreambuf_iterator<char>(infoFile)), std::istreambuf_iterator<char>());
+    rapidjson::Document doc;
+    doc.Parse(infoText);
+    if (doc.HasParseError() || !doc.IsObject()) {
+        WARNING("{} is not a json object, skipping the level", infoPath.string());
+        return std::nullopt;
+    }
+
+    // the same files in the same order GetCustomLevelHash hashes for each version
+    std::optional<std::vector<std::filesystem::path>> files;
+    std::optional<std::string> songFilename;
+    if (GetString(doc, "version").value_or("").starts_with("4")) {
+        auto audio = doc.FindMember("audio");
+        if (audio != doc.MemberEnd()) songFilename = GetString(audio->value, "songFilename");
+        files = GetHashedLevelFilesV4(levelPath, infoPath, doc);
+    } else {
+        songFilename = GetString(doc, "_songFilename");
+        files = GetHashedLevelFilesV2(levelPath, infoPath, doc);
+    }
+
+    if (files.has_value()) {
+        FileHasher hasher;
+        bool hashed = std::all_of(files->begin(), files->end(), [&hasher](auto const& file){ return hasher.AddFile(file); });
+        if (hashed) data.sha1 = hasher.FinalHex();
+    }
+
+    // a duration that only comes from the beatmaps is left to the device
+    if (songFilename.has_value()) data.songDuration = GetSongDuration(levelPath / *songFilename);
+    return data;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        fmt::print(stderr, "usage: {} <custom levels folder> [threads]\n"
+                           "writes {} into the folder, copy it to the quest along with the levels\n", argv[0], PREBUILT_CACHE_FILE_NAME);
+        return 2;
+    }
+
+    std::filesystem::path root = argv[1];
+    unsigned threadCount = argc == 3 ? std::atoi(argv[2]) : std::thread::hardware_concurrency();
+    threadCount = std::max(threadCount, 1u);
+
+    std::vector<std::filesystem::path> levelFolders;
+    if (!CollectLevelFolders(root, levelFolders)) {
+        ERROR("Could not list {}", root.string());
+        return 1;
+    }
+    INFO("Prebuilding {} levels in {} on {} threads", levelFolders.size(), root.string(), threadCount);
+
+    std::vector<std::optional<CachedSongData>> prebuilt(levelFolders.size());
+    std::atomic<size_t> nextLevel = 0;
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < threadCount; i++) {
+        threads.emplace_back([&](){
+            for (size_t level = nextLevel++; level < levelFolders.size(); level = nextLevel++) {
+                prebuilt[level] = PrebuildLevel(levelFolders[level]);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    // keys are relative to the root, that's all that stays the same once the library is copied somewhere else
+    std::vector<std::pair<std::string, CachedSongData>> entries;
+    for (size_t i = 0; i < levelFolders.size(); i++) {
+        if (!prebuilt[i].has_value()) continue;
+        entries.emplace_back(levelFolders[i].lexically_relative(root).generic_string(), std::move(*prebuilt[i]));
+    }
+    std::sort(entries.begin(), entries.end(), [](auto const& a, auto const& b){ return a.first < b.first; });
+
+    auto filePath = root / PREBUILT_CACHE_FILE_NAME;
+    if (!WriteSongCacheFile(filePath, entries)) {
+        ERROR("Could not write {}", filePath.string());
+        return 1;
+    }
+
+    auto hashedCount = std::count_if(entries.begin(), entries.end(), [](auto const& entry){ return entry.second.sha1.has_value(); });
+    INFO("Wrote {} levels to {}, {} of them hashed", entries.size(), filePath.string(), hashedCount);
+    return 0;
+}
@@ -0,0 +1,46 @@
+// checks the manifest is saved without leaving a temporary file behind, and that a walk after the background load only reports what changed since the save
+#include "TestHelpers.hpp"
+#include "Utils/DirectoryManifest.hpp"
+
+#include <filesystem>
+#include <vector>
+
+using namespace SongCore;
+
+int main() {
+    auto directory = Tests::EnterTestDirectory("DirectoryManifestTest");
+    auto root = directory / "CustomLevels";
+    Tests::WriteLevel(root / "LevelA", "A");
+    Tests::WriteLevel(root / "Pack/LevelB", "B");
+
+    std::vector<std::filesystem::path> levels, changedLevels;
+    Utils::CollectLevelFoldersIncremental(root, false, levels, changedLevels);
+    Utils::PruneDirectoryManifest();
+    CHECK(levels.size() == 2);
+    CHECK(changedLevels.size() == 2);
+
+    Utils::SaveDirectoryManifest();
+    std::filesystem::path manifestPath = SONGCORE_DATA_PATH "/DirectoryManifest.json";
+    CHECK(std::filesystem::exists(manifestPath));
+    CHECK(!std::filesystem::exists(SONGCORE_DATA_PATH "/DirectoryManifest.json.tmp"));
+
+    // like a restart, the walk waits for the background load and then only lists what changed
+    Utils::ClearDirectoryManifest();
+    Utils::LoadDirectoryManifestAsync();
+    Tests::WriteLevel(root / "Pack/LevelC", "C");
+
+    levels.clear();
+    changedLevels.clear();
+    Utils::CollectLevelFoldersIncremental(root, false, levels, changedLevels);
+    CHECK(levels.size() == 3);
+    CHECK(changedLevels == std::vector<std::filesystem::path>{ root / "Pack/LevelC" });
+
+    // saving again replaces the manifest in one piece
+    Utils::SaveDirectoryManifest();
+    CHECK(Utils::LoadDirectoryManifest());
+    CHECK(!std::filesystem::exists(SONGCORE_DATA_PATH "/DirectoryManifest.json.tmp"));
+
+    Tests::LeaveTestDirectory(directory);
+    fmt::print("passed\n");
+    return 0;
+}
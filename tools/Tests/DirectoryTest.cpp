@@ -0,0 +1,47 @@
+// checks which folders count as levels, from a single listing of each
+#include "TestHelpers.hpp"
+#include "Utils/Directory.hpp"
+
+#include <algorithm>
+#include <dirent.h>
+#include <filesystem>
+#include <vector>
+
+using namespace SongCore;
+
+static Utils::DirectoryEntry File(std::string name) {
+    return Utils::DirectoryEntry{ std::move(name), 0, DT_REG };
+}
+
+int main() {
+    auto directory = Tests::EnterTestDirectory("DirectoryTest");
+
+    // any casing is a level, but an exact info.dat wins wherever it is in the listing
+    std::vector<Utils::DirectoryEntry> entries { File("INFO.DAT"), File("Easy.dat"), File("info.dat") };
+    CHECK(Utils::FindInfoDat(entries) == "info.dat");
+    entries = { File("song.ogg"), File("Info.DAT") };
+    CHECK(Utils::FindInfoDat(entries) == "Info.DAT");
+    entries = { File("song.ogg"), File("info.dat.bak"), Utils::DirectoryEntry{ "info.dat", 0, DT_DIR } };
+    CHECK(!Utils::FindInfoDat(entries).has_value());
+
+    auto root = directory / "CustomLevels";
+    Tests::WriteLevel(root / "Lower", "Lower");
+    Tests::WriteFile(root / "Upper/INFO.DAT", "{}");
+    Tests::WriteLevel(root / "Pack/Nested", "Nested");
+    Tests::WriteLevel(root / "Wip/autosaves/Autosave", "Autosave");
+    Tests::WriteFile(root / "NotALevel/song.ogg", "");
+    std::filesystem::create_directory_symlink(root / "Lower", root / "Linked");
+
+    std::vector<std::filesystem::path> levelFolders;
+    CHECK(Utils::CollectLevelFolders(root, levelFolders));
+    std::sort(levelFolders.begin(), levelFolders.end());
+    std::vector<std::filesystem::path> expected { root / "Linked", root / "Lower", root / "Pack/Nested", root / "Upper" };
+    CHECK(levelFolders == expected);
+
+    CHECK(Utils::FindInfoDatPath(root / "Upper") == root / "Upper/INFO.DAT");
+    CHECK(!Utils::FindInfoDatPath(root / "NotALevel").has_value());
+
+    Tests::LeaveTestDirectory(directory);
+    fmt::print("passed\n");
+    return 0;
+}
@@ -0,0 +1,68 @@
+// checks that hashing files in blocks gives the sha1 of their concatenation, the answers come from sha1sum
+#include "TestHelpers.hpp"
+#include "Utils/FileHasher.hpp"
+
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace SongCore;
+
+/// @brief contents that don't repeat within a read block, so a block hashed twice or skipped changes the hash
+static std::string Pattern(size_t size) {
+    std::string contents(size, '\0');
+    for (size_t i = 0; i < size; i++) contents[i] = static_cast<char>((i * 31 + i / 4099) % 251);
+    return contents;
+}
+
+static std::string HashFiles(std::vector<std::filesystem::path> const& files) {
+    Utils::FileHasher hasher;
+    for (auto const& file : files) CHECK(hasher.AddFile(file));
+    return hasher.FinalHex();
+}
+
+int main() {
+    auto directory = Tests::EnterTestDirectory("FileHasherTest");
+
+    // around and across the 1MB read block
+    Tests::WriteFile(directory / "empty.dat", "");
+    Tests::WriteFile(directory / "abc.dat", "abc");
+    Tests::WriteFile(directory / "block.dat", Pattern(1024 * 1024));
+    Tests::WriteFile(directory / "large.dat", Pattern(3 * 1024 * 1024 + 17));
+
+    CHECK(HashFiles({ "empty.dat" }) == "DA39A3EE5E6B4B0D3255BFEF95601890AFD80709");
+    CHECK(HashFiles({ "abc.dat" }) == "A9993E364706816ABA3E25717850C26C9CD0D89D");
+    CHECK(HashFiles({ "block.dat" }) == "0002897DEF343EE822CB41D2778CC42FBEBF27D8");
+
+    // a level is hashed as the files one after the other
+    std::vector<std::filesystem::path> levelFiles { "empty.dat", "abc.dat", "block.dat", "large.dat" };
+    Utils::FileHasher hasher;
+    for (auto const& file : levelFiles) CHECK(hasher.AddFile(file));
+    CHECK(hasher.get_BytesHashed() == 4194324);
+    CHECK(hasher.FinalHex() == "946A017F45C6F681FDCFCCBD831C104D9E269A62");
+
+    // finishing resets the hash, the byte count keeps going
+    CHECK(hasher.AddFile("abc.dat"));
+    CHECK(hasher.FinalHex() == "A9993E364706816ABA3E25717850C26C9CD0D89D");
+    CHECK(hasher.get_BytesHashed() == 4194327);
+
+    // a file that can't be read is reported, the caller throws the hash away
+    Utils::FileHasher missingHasher;
+    CHECK(!missingHasher.AddFile("missing.dat"));
+    CHECK(!missingHasher.AddFile(directory));
+
+    // every thread reads into its own block
+    std::vector<std::string> threadHashes(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadHashes.size(); i++) {
+        threads.emplace_back([&, i](){
+            for (int run = 0; run < 4; run++) threadHashes[i] = HashFiles(levelFiles);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (auto const& hash : threadHashes) CHECK(hash == "946A017F45C6F681FDCFCCBD831C104D9E269A62");
+
+    Tests::LeaveTestDirectory(directory);
+    return 0;
+}
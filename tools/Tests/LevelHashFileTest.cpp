@@ -0,0 +1,85 @@
+// writes level hash files like a downloader would and checks the hash is only trusted while the folder has exactly the files listed in it
+#include "TestHelpers.hpp"
+#include "Utils/Directory.hpp"
+#include "Utils/Fingerprint.hpp"
+#include "Utils/LevelHashFile.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace SongCore;
+
+static std::string const easyContents = R"({"_version":"2.0.0","_notes":[],"_obstacles":[],"_events":[]})";
+
+/// @brief what a downloader writes, the info.dat of the level from WriteLevel and the given files
+static std::string HashFileContents(std::string_view hash, std::filesystem::path const& levelPath, std::string_view extraFiles = "") {
+    auto infoSize = std::filesystem::exists(levelPath / "info.dat") ? std::filesystem::file_size(levelPath / "info.dat") : 0;
+    return fmt::format(R"({{"hash":"{}","files":{{"info.dat":{},"Easy.dat":{}{}}}}})", hash, infoSize, easyContents.size(), extraFiles);
+}
+
+int main() {
+    auto directory = Tests::EnterTestDirectory("LevelHashFileTest");
+    auto level = directory / "CustomLevels/Level";
+    auto hashFile = level / Utils::LEVEL_HASH_FILE_NAME;
+    std::string const hash = "412c1bc897a6040e170e82c8d97ef82cf8ff873d";
+    std::string const upperHash = "412C1BC897A6040E170E82C8D97EF82CF8FF873D";
+
+    CHECK(Utils::NormalizeLevelHash(hash) == upperHash);
+    CHECK(!Utils::NormalizeLevelHash(hash.substr(1)).has_value());
+    CHECK(!Utils::NormalizeLevelHash("g" + hash.substr(1)).has_value());
+
+    // writing the hash file doesn't change the fingerprints the cache keeps for the folder
+    Tests::WriteLevel(level, "Level");
+    std::vector<Utils::DirectoryEntry> entries;
+    CHECK(Utils::ListDirectory(level, entries));
+    auto directoryFingerprint = Utils::GetDirectoryFingerprint(level, entries);
+    auto contentFingerprint = Utils::GetContentFingerprint(level, entries);
+    CHECK(!Utils::HasLevelHashFile(entries));
+    CHECK(!Utils::ReadLevelHashFile(level).has_value());
+
+    Tests::WriteFile(hashFile, HashFileContents(hash, level));
+    entries.clear();
+    CHECK(Utils::ListDirectory(level, entries));
+    CHECK(Utils::HasLevelHashFile(entries));
+    CHECK(Utils::GetDirectoryFingerprint(level, entries) == directoryFingerprint);
+    CHECK(Utils::GetContentFingerprint(level, entries) == contentFingerprint);
+    CHECK(Utils::ReadLevelHashFile(level) == upperHash);
+
+    // folders in the level aren't part of it
+    std::filesystem::create_directories(level / "autosaves");
+    CHECK(Utils::ReadLevelHashFile(level) == upperHash);
+
+    // a file that was added, changed size or is missing means the hash is for other files
+    Tests::WriteFile(level / "cover.jpg", "jpg");
+    CHECK(!Utils::ReadLevelHashFile(level).has_value());
+    Tests::WriteFile(hashFile, HashFileContents(hash, level, R"(,"cover.jpg":3)"));
+    CHECK(Utils::ReadLevelHashFile(level) == upperHash);
+    Tests::WriteFile(level / "cover.jpg", "jpeg");
+    CHECK(!Utils::ReadLevelHashFile(level).has_value());
+    std::filesystem::remove(level / "cover.jpg");
+    CHECK(!Utils::ReadLevelHashFile(level).has_value());
+
+    // the sizes are all that's compared, so the hash file can be written before the level is extracted
+    auto laterLevel = directory / "CustomLevels/Later";
+    std::filesystem::create_directories(laterLevel);
+    Tests::WriteFile(laterLevel / Utils::LEVEL_HASH_FILE_NAME, HashFileContents(hash, level));
+    CHECK(!Utils::ReadLevelHashFile(laterLevel).has_value());
+    Tests::WriteLevel(laterLevel, "Level");
+    CHECK(Utils::ReadLevelHashFile(laterLevel) == upperHash);
+
+    // anything else isn't trusted
+    for (auto const& contents : {
+        fmt::format(R"({{"hash":"{}","directoryFingerprint":{}}})", hash, *directoryFingerprint),
+        HashFileContents(hash.substr(1), level),
+        std::string(R"({"files":{}})"),
+        fmt::format(R"({{"hash":"{}","files":{{"info.dat":"big"}}}})", hash),
+        std::string("not json")
+    }) {
+        Tests::WriteFile(hashFile, contents);
+        CHECK(!Utils::ReadLevelHashFile(level).has_value());
+    }
+
+    Tests::LeaveTestDirectory(directory);
+    return 0;
+}
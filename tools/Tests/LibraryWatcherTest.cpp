@@ -0,0 +1,132 @@
+// creates, renames and deletes level and pack folders in watched roots, and checks a view kept like the loader keeps its dictionaries ends up matching the disk
+#include "TestHelpers.hpp"
+#include "SongLoader/LibraryWatcher.hpp"
+#include "Utils/Directory.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace SongCore;
+using namespace std::chrono_literals;
+
+/// @brief what the loader would have loaded from the reported levels, a level is there as long as it has an info.dat when reported
+struct LoaderView {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::map<std::filesystem::path, bool> levels;
+    int reports = 0;
+
+    void Report(std::filesystem::path const& levelPath, bool isWip) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (Utils::FindInfoDatPath(levelPath).has_value()) levels[levelPath] = isWip;
+        else levels.erase(levelPath);
+        reports++;
+        changed.notify_all();
+    }
+
+    /// @return whether the view became what was expected before the timeout
+    bool WaitFor(std::map<std::filesystem::path, bool> const& expected) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return changed.wait_for(lock, 10s, [&](){ return levels == expected; });
+    }
+};
+
+int main() {
+    auto directory = Tests::EnterTestDirectory("LibraryWatcherTest");
+    auto root = directory / "CustomLevels";
+    auto wipRoot = directory / "CustomWIPLevels";
+    std::filesystem::create_directories(root);
+    std::filesystem::create_directories(wipRoot);
+    // loaded by the refresh before the watcher started, so never reported
+    Tests::WriteLevel(root / "ExistingPack/OldLevel", "Old");
+
+    LoaderView view;
+    std::atomic<int> refreshesNeeded = 0;
+    auto watcher = std::make_shared<SongLoader::LibraryWatcher>(
+        [&view](std::filesystem::path const& levelPath, bool isWip){ view.Report(levelPath, isWip); },
+        [&refreshesNeeded](){ refreshesNeeded++; },
+        200ms
+    );
+    std::vector<std::filesystem::path> roots { root };
+    std::vector<std::filesystem::path> wipRoots { wipRoot };
+    CHECK(watcher->Start(roots, wipRoots));
+
+    // a level being copied in is only reported once its files stopped changing
+    Tests::WriteLevel(root / "LevelA", "A");
+    CHECK(view.WaitFor({ { root / "LevelA", false } }));
+
+    Tests::WriteLevel(wipRoot / "WipLevel", "Wip");
+    CHECK(view.WaitFor({ { root / "LevelA", false }, { wipRoot / "WipLevel", true } }));
+
+    // renaming reports both sides, the old path goes away and the new one is loaded
+    std::filesystem::rename(root / "LevelA", root / "LevelB");
+    CHECK(view.WaitFor({ { root / "LevelB", false }, { wipRoot / "WipLevel", true } }));
+
+    // a renamed folder that was created while watching still reports changes inside it under its new path
+    {
+        std::unique_lock<std::mutex> lock(view.mutex);
+        view.levels.erase(root / "LevelB");
+    }
+    Tests::WriteFile(root / "LevelB/Hard.dat", "{}");
+    CHECK(view.WaitFor({ { root / "LevelB", false }, { wipRoot / "WipLevel", true } }));
+
+    std::filesystem::remove_all(root / "LevelB");
+    std::filesystem::remove_all(wipRoot / "WipLevel");
+    CHECK(view.WaitFor({}));
+
+    // a folder without an info.dat is reported but never becomes a level
+    Tests::WriteFile(root / "NotALevel/song.ogg", "");
+    int reports;
+    {
+        std::unique_lock<std::mutex> lock(view.mutex);
+        reports = view.reports;
+        CHECK(view.changed.wait_for(lock, 10s, [&](){ return view.reports > reports; }));
+        CHECK(view.levels.empty());
+    }
+    std::filesystem::remove_all(root / "NotALevel");
+
+    // levels added to and removed from a pack that existed before watching are reported
+    Tests::WriteLevel(root / "ExistingPack/NewLevel", "New");
+    CHECK(view.WaitFor({ { root / "ExistingPack/NewLevel", false } }));
+    std::filesystem::remove_all(root / "ExistingPack/NewLevel");
+    CHECK(view.WaitFor({}));
+
+    // a pack that is moved in reports the levels in it, also the ones in packs nested in it, but never the pack itself
+    Tests::WriteLevel(directory / "Staging/MovedPack/LevelC", "C");
+    Tests::WriteLevel(directory / "Staging/MovedPack/NestedPack/LevelD", "D");
+    std::filesystem::rename(directory / "Staging/MovedPack", root / "MovedPack");
+    CHECK(view.WaitFor({ { root / "MovedPack/LevelC", false }, { root / "MovedPack/NestedPack/LevelD", false } }));
+
+    // a pack that is written in place reports its levels once they settled, including one added later
+    Tests::WriteLevel(wipRoot / "WrittenPack/LevelE", "E");
+    CHECK(view.WaitFor({ { root / "MovedPack/LevelC", false }, { root / "MovedPack/NestedPack/LevelD", false }, { wipRoot / "WrittenPack/LevelE", true } }));
+    Tests::WriteLevel(wipRoot / "WrittenPack/LevelF", "F");
+    CHECK(view.WaitFor({
+        { root / "MovedPack/LevelC", false }, { root / "MovedPack/NestedPack/LevelD", false },
+        { wipRoot / "WrittenPack/LevelE", true }, { wipRoot / "WrittenPack/LevelF", true }
+    }));
+    CHECK(refreshesNeeded == 0);
+
+    // a pack that is moved out doesn't report its levels one by one, the loader has to refresh to find out what it lost
+    std::filesystem::rename(root / "MovedPack", directory / "MovedPack");
+    auto refreshDeadline = std::chrono::steady_clock::now() + 10s;
+    while (refreshesNeeded == 0 && std::chrono::steady_clock::now() < refreshDeadline) std::this_thread::sleep_for(10ms);
+    CHECK(refreshesNeeded == 1);
+
+    watcher->Stop();
+    auto stopDeadline = std::chrono::steady_clock::now() + 10s;
+    while (watcher->get_IsRunning() && std::chrono::steady_clock::now() < stopDeadline) std::this_thread::sleep_for(10ms);
+    CHECK(!watcher->get_IsRunning());
+    CHECK(refreshesNeeded == 1);
+
+    Tests::LeaveTestDirectory(directory);
+    fmt::print("passed\n");
+    return 0;
+}
@@ -0,0 +1,64 @@
+// prebuilds a library with the real CachePrebuilder, copies it like it would be copied to a quest and checks the cache accepts exactly the levels that didn't change
+#include "TestHelpers.hpp"
+#include "Utils/Cache.hpp"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace SongCore;
+
+int main(int argc, char** argv) {
+    CHECK(argc == 2);
+    std::filesystem::path prebuilder = std::filesystem::absolute(argv[1]);
+    auto directory = Tests::EnterTestDirectory("PrebuiltCacheTest");
+
+    Tests::WriteLevel("Library/LevelA", "A");
+    Tests::WriteLevel("Library/Pack/LevelB", "B");
+    Tests::WriteLevel("Library/Pack/LevelC", "C");
+    // a v4 level whose first difficulty lost its beatmap, the lightshow it shares with the second one is only hashed once
+    Tests::WriteFile("Library/LevelD/Info.dat", R"({"version":"4.0.0","audio":{"audioDataFilename":"AudioData.dat"},"difficultyBeatmaps":[)"
+                                                R"({"beatmapDataFilename":"Easy.dat","lightshowDataFilename":"Lightshow.dat"},)"
+                                                R"({"beatmapDataFilename":"Normal.dat","lightshowDataFilename":"Lightshow.dat"}]})");
+    Tests::WriteFile("Library/LevelD/AudioData.dat", R"({"version":"4.0.0"})");
+    Tests::WriteFile("Library/LevelD/Normal.dat", R"({"version":"4.0.0","colorNotes":[]})");
+    Tests::WriteFile("Library/LevelD/Lightshow.dat", R"({"version":"4.0.0","basicEvents":[]})");
+    CHECK(std::system(fmt::format("\"{}\" Library 2", prebuilder.string()).c_str()) == 0);
+    CHECK(std::filesystem::exists(std::filesystem::path("Library") / Utils::PREBUILT_CACHE_FILE_NAME));
+
+    // a copy has new inodes and modification times, only the relative paths and the content survive it
+    auto root = directory / "CustomLevels";
+    std::filesystem::copy("Library", root, std::filesystem::copy_options::recursive);
+    Tests::WriteFile(root / "Pack/LevelC/Easy.dat", R"({"_version":"2.0.0","_notes":[{"_time":1}],"_obstacles":[],"_events":[]})");
+
+    std::vector<std::filesystem::path> roots { root };
+    Utils::LoadPrebuiltSongCaches(roots);
+
+    // sha1sum of info.dat followed by Easy.dat
+    auto levelA = Utils::GetCachedInfo(root / "LevelA");
+    CHECK(levelA.has_value());
+    CHECK(levelA->sha1 == "412C1BC897A6040E170E82C8D97EF82CF8FF873D");
+    auto levelB = Utils::GetCachedInfo(root / "Pack/LevelB");
+    CHECK(levelB.has_value());
+    CHECK(levelB->sha1 == "6DFCA10C39411EC0791E136BCDC8222AD738FC77");
+
+    // sha1sum of Info.dat, AudioData.dat, Normal.dat and Lightshow.dat, like GetCustomLevelHash lists them
+    auto levelD = Utils::GetCachedInfo(root / "LevelD");
+    CHECK(levelD.has_value());
+    CHECK(levelD->sha1 == "3A240E9F26E801DDA922B560FB290D707A67CE08");
+
+    // the changed level has to be hashed on the device again
+    auto levelC = Utils::GetCachedInfo(root / "Pack/LevelC");
+    CHECK(levelC.has_value());
+    CHECK(!levelC->sha1.has_value());
+
+    // a prebuilt entry only applies to its own relative path
+    std::filesystem::copy(root / "LevelA", root / "Pack/LevelA", std::filesystem::copy_options::recursive);
+    auto movedLevelA = Utils::GetCachedInfo(root / "Pack/LevelA");
+    CHECK(movedLevelA.has_value());
+    CHECK(!movedLevelA->sha1.has_value());
+
+    Tests::LeaveTestDirectory(directory);
+    fmt::print("passed\n");
+    return 0;
+}
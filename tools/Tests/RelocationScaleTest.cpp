@@ -0,0 +1,113 @@
+// hashes 1,000 levels, moves every one of them to the other root, into subfolders and back, and checks each keeps its hash without a single file being hashed or opened again
+#include "TestHelpers.hpp"
+#include "Utils/Cache.hpp"
+#include "Utils/FileHasher.hpp"
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace SongCore;
+
+static constexpr size_t levelCount = 1000;
+
+/// @brief the hash stage for a level: the cached hash if there is one, otherwise its files are hashed and the hash is cached
+static std::string HashLevel(std::filesystem::path const& levelPath, size_t& levelsHashed) {
+    auto cachedInfo = Utils::GetCachedInfo(levelPath);
+    CHECK(cachedInfo.has_value());
+    if (cachedInfo->sha1.has_value()) return *cachedInfo->sha1;
+
+    levelsHashed++;
+    Utils::FileHasher hasher;
+    CHECK(hasher.AddFile(levelPath / "info.dat"));
+    CHECK(hasher.AddFile(levelPath / "Easy.dat"));
+    auto sha1 = hasher.FinalHex();
+    CHECK(Utils::UpdateCachedInfo(levelPath, [&sha1](Utils::CachedSongData& data){ data.sha1 = sha1; }));
+    return sha1;
+}
+
+/// @brief amount of files opened in the watched folders since the last call, hashing a level opens all of its files
+static size_t CountFileOpens(int inotifyFd) {
+    size_t opens = 0;
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+        for (char* ptr = buffer; ptr < buffer + length; ) {
+            auto event = reinterpret_cast<inotify_event const*>(ptr);
+            // events without a name are for the watched folder itself, which listing it opens
+            if (event->len > 0) opens++;
+            ptr += sizeof(inotify_event) + event->len;
+        }
+    }
+    return opens;
+}
+
+/// @brief moves every level and checks the hash stage finds all of their hashes in the cache
+static void MoveLevels(std::vector<std::filesystem::path>& levels, std::vector<std::string> const& hashes, int inotifyFd, std::function<std::filesystem::path(size_t index)> const& destination) {
+    for (size_t i = 0; i < levelCount; i++) {
+        auto movedPath = destination(i);
+        std::filesystem::create_directories(movedPath.parent_path());
+        std::filesystem::rename(levels[i], movedPath);
+        levels[i] = movedPath;
+    }
+
+    size_t levelsHashed = 0;
+    for (size_t i = 0; i < levelCount; i++) CHECK(HashLevel(levels[i], levelsHashed) == hashes[i]);
+    CHECK(levelsHashed == 0);
+    CHECK(CountFileOpens(inotifyFd) == 0);
+}
+
+int main() {
+    auto directory = Tests::EnterTestDirectory("RelocationScaleTest");
+    auto songCoreRoot = directory / "SongCore/CustomLevels";
+    auto songLoaderRoot = directory / "SongLoader/CustomLevels";
+
+    std::vector<std::filesystem::path> levels;
+    for (size_t i = 0; i < levelCount; i++) {
+        auto& levelPath = levels.emplace_back(songCoreRoot / fmt::format("Level{}", i));
+        Tests::WriteLevel(levelPath, levelPath.filename().string());
+    }
+
+    // the first refresh hashes everything
+    size_t levelsHashed = 0;
+    std::vector<std::string> hashes;
+    for (auto const& levelPath : levels) hashes.emplace_back(HashLevel(levelPath, levelsHashed));
+    CHECK(levelsHashed == levelCount);
+
+    // inotify watches follow the folders wherever they're moved
+    int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    CHECK(inotifyFd >= 0);
+    for (auto const& levelPath : levels) CHECK(inotify_add_watch(inotifyFd, levelPath.c_str(), IN_OPEN) >= 0);
+
+    // after a restart the moved levels are found through the fingerprint index of the saved cache file
+    Utils::SaveSongInfoCache();
+    Utils::ClearSongInfoCache();
+    CHECK(Utils::LoadSongInfoCache());
+    MoveLevels(levels, hashes, inotifyFd, [&](size_t i){
+        switch (i % 3) {
+            case 0: return songLoaderRoot / fmt::format("Level{}", i);
+            case 1: return songCoreRoot / fmt::format("Pack{}", i % 10) / fmt::format("Level{}", i);
+            default: return songLoaderRoot / "Pack" / fmt::format("Renamed{}", i);
+        }
+    });
+
+    // without one they're found through the changes since the last save
+    MoveLevels(levels, hashes, inotifyFd, [&](size_t i){
+        return songCoreRoot / "Moved" / fmt::format("Level{}", i);
+    });
+
+    // the counts do see a level that has to be hashed again
+    Tests::WriteFile(levels.front() / "Easy.dat", R"({"_version":"2.0.0","_notes":[{"_time":1}],"_obstacles":[],"_events":[]})");
+    CountFileOpens(inotifyFd);
+    CHECK(HashLevel(levels.front(), levelsHashed) != hashes.front());
+    CHECK(levelsHashed == levelCount + 1);
+    CHECK(CountFileOpens(inotifyFd) == 2);
+
+    close(inotifyFd);
+    Tests::LeaveTestDirectory(directory);
+    return 0;
+}
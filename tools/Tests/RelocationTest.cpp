@@ -0,0 +1,66 @@
+// moves and copies level folders around and checks the cache takes over the hash of the folder they came from, unless one of their files changed
+#include "TestHelpers.hpp"
+#include "Utils/Cache.hpp"
+#include "config.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+using namespace SongCore;
+
+/// @brief sets the hash of a level, on top of the fingerprints the cache takes for it
+static void SetSha1(std::filesystem::path const& levelPath, std::string const& sha1) {
+    auto data = Utils::GetCachedInfo(levelPath);
+    CHECK(data.has_value());
+    data->sha1 = sha1;
+    Utils::SetCachedInfo(levelPath, *data);
+}
+
+static std::optional<std::string> Sha1Of(std::filesystem::path const& levelPath) {
+    auto data = Utils::GetCachedInfo(levelPath);
+    CHECK(data.has_value());
+    return data->sha1;
+}
+
+int main() {
+    auto directory = Tests::EnterTestDirectory("RelocationTest");
+    auto root = directory / "CustomLevels";
+    std::string const hashA(40, 'A'), hashB(40, 'B'), hashC(40, 'C');
+
+    // found through the changes since the last save
+    Tests::WriteLevel(root / "A", "A");
+    SetSha1(root / "A", hashA);
+    std::filesystem::rename(root / "A", root / "MovedA");
+    CHECK(Sha1Of(root / "MovedA") == hashA);
+
+    // found through the fingerprint index of the saved cache file, after a restart
+    Tests::WriteLevel(root / "B", "B");
+    SetSha1(root / "B", hashB);
+    Utils::SaveSongInfoCache();
+    Utils::LoadSongInfoCache();
+    std::filesystem::create_directories(root / "Pack");
+    std::filesystem::rename(root / "B", root / "Pack/B");
+    CHECK(Sha1Of(root / "Pack/B") == hashB);
+
+    // a moved level with a changed file is a different level
+    std::filesystem::rename(root / "MovedA", root / "ChangedA");
+    Tests::WriteFile(root / "ChangedA/Easy.dat", R"({"_version":"2.0.0","_notes":[{"_time":1}],"_obstacles":[],"_events":[]})");
+    CHECK(!Sha1Of(root / "ChangedA").has_value());
+    std::filesystem::rename(root / "Pack/B", root / "ChangedB");
+    Tests::WriteFile(root / "ChangedB/Easy.dat", R"({"_version":"2.0.0","_notes":[{"_time":1}],"_obstacles":[],"_events":[]})");
+    CHECK(!Sha1Of(root / "ChangedB").has_value());
+
+    // a copy gets new inodes and modification times, only roots that fingerprint the content find it
+    config.ContentFingerprintRootPaths = { root };
+    Tests::WriteLevel(root / "C", "C");
+    SetSha1(root / "C", hashC);
+    std::filesystem::copy(root / "C", root / "CopiedC", std::filesystem::copy_options::recursive);
+    CHECK(Sha1Of(root / "CopiedC") == hashC);
+    std::filesystem::copy(root / "C", root / "ChangedC", std::filesystem::copy_options::recursive);
+    Tests::WriteFile(root / "ChangedC/Easy.dat", R"({"_version":"2.0.0","_notes":[{"_time":1}],"_obstacles":[],"_events":[]})");
+    CHECK(!Sha1Of(root / "ChangedC").has_value());
+
+    Tests::LeaveTestDirectory(directory);
+    return 0;
+}
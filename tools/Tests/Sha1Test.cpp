@@ -0,0 +1,91 @@
+// runs every sha1 kernel this cpu has through the NIST vectors, fed whole and in pieces, and compares the kernels with each other
+// with the name of a kernel as argument it also fails if that kernel isn't available, so a run on a cpu with sha1 instructions can't quietly only test the portable one
+#include "TestHelpers.hpp"
+#include "Utils/Sha1.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace SongCore;
+
+static std::string ToHex(Utils::Sha1::Digest const& digest) {
+    static constexpr char hexChars[] = "0123456789ABCDEF";
+    std::string hex;
+    for (auto b : digest) {
+        hex.push_back(hexChars[b >> 4]);
+        hex.push_back(hexChars[b & 0xF]);
+    }
+    return hex;
+}
+
+/// @brief hashes the input in pieces of the given size, so the block buffering in Update is tested around the block size
+static std::string Hash(Utils::Sha1& sha1, std::string_view input, size_t pieceSize) {
+    auto data = reinterpret_cast<uint8_t const*>(input.data());
+    for (size_t offset = 0; offset < input.size(); offset += pieceSize) {
+        sha1.Update(data + offset, std::min(pieceSize, input.size() - offset));
+    }
+    return ToHex(sha1.Final());
+}
+
+int main(int argc, char** argv) {
+    struct KnownAnswer {
+        std::string input;
+        std::string_view digest;
+    };
+    // FIPS 180 examples and the NIST SHAVS long message
+    std::vector<KnownAnswer> const knownAnswers {
+        { "", "DA39A3EE5E6B4B0D3255BFEF95601890AFD80709" },
+        { "abc", "A9993E364706816ABA3E25717850C26C9CD0D89D" },
+        { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", "84983E441C3BD26EBAAE4AA1F95129E5E54670F1" },
+        { "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu", "A49B2446A02C645BF419F995B67091253A04A259" },
+        { std::string(1000000, 'a'), "34AA973CD4C4DAA4F61EEB2BDBAD27316534016F" }
+    };
+    static constexpr size_t pieceSizes[] = { 1, 3, 55, 56, 63, 64, 65, 127, 1000, 1024 * 1024 };
+
+    auto kernels = Utils::Sha1::GetAvailableKernels();
+    CHECK(!kernels.empty() && kernels.front().name == "portable");
+    for (auto const& kernel : kernels) fmt::print("testing the {} kernel\n", kernel.name);
+    if (argc > 1) {
+        std::string_view required = argv[1];
+        CHECK(std::any_of(kernels.begin(), kernels.end(), [required](auto const& kernel){ return kernel.name == required; }));
+    }
+
+    for (auto const& kernel : kernels) {
+        Utils::Sha1 sha1(kernel.compress);
+        for (auto const& knownAnswer : knownAnswers) {
+            for (auto pieceSize : pieceSizes) {
+                if (Hash(sha1, knownAnswer.input, pieceSize) != knownAnswer.digest) {
+                    fmt::print(stderr, "{} kernel, {} bytes in pieces of {}\n", kernel.name, knownAnswer.input.size(), pieceSize);
+                    CHECK(false);
+                }
+            }
+        }
+    }
+
+    // the kernel picked for this cpu is one of them
+    Utils::Sha1 picked;
+    CHECK(Hash(picked, "abc", 3) == "A9993E364706816ABA3E25717850C26C9CD0D89D");
+    CHECK(std::any_of(kernels.begin(), kernels.end(), [](auto const& kernel){ return kernel.name == Utils::Sha1::get_KernelName(); }));
+
+    // every length around a few blocks, with contents the vectors don't have
+    std::mt19937 random(1234);
+    for (size_t size = 0; size < 64 * 5; size++) {
+        std::string input(size, '\0');
+        for (auto& c : input) c = static_cast<char>(random());
+
+        Utils::Sha1 portable(kernels.front().compress);
+        auto expected = Hash(portable, input, size + 1);
+        for (auto const& kernel : kernels) {
+            Utils::Sha1 sha1(kernel.compress);
+            if (Hash(sha1, input, size + 1) != expected || Hash(sha1, input, 7) != expected) {
+                fmt::print(stderr, "{} kernel differs from portable at {} bytes\n", kernel.name, size);
+                CHECK(false);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+// damages the cache files like storage or a torn write would, and checks the checksums keep the damage from being loaded and replacing a file never leaves half of one
+#include "TestHelpers.hpp"
+#include "Utils/Cache.hpp"
+#include "Utils/File.hpp"
+#include "Utils/SongCacheFile.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+using namespace SongCore;
+
+static std::filesystem::path const cachePath = SONGCORE_DATA_PATH "/CachedSongData.bin";
+static std::filesystem::path const journalPath = SONGCORE_DATA_PATH "/CachedSongData.journal";
+
+/// @brief sets the hash of a level, on top of the fingerprints the cache takes for it
+static void SetSha1(std::filesystem::path const& levelPath, char hashChar) {
+    auto data = Utils::GetCachedInfo(levelPath);
+    CHECK(data.has_value());
+    data->sha1 = std::string(40, hashChar);
+    Utils::SetCachedInfo(levelPath, *data);
+}
+
+static std::optional<std::string> Sha1Of(std::filesystem::path const& levelPath) {
+    auto data = Utils::GetCachedInfo(levelPath);
+    CHECK(data.has_value());
+    return data->sha1;
+}
+
+static std::string Hash(char hashChar) {
+    return std::string(40, hashChar);
+}
+
+static std::string FlipByte(std::string contents, size_t offset) {
+    CHECK(offset < contents.size());
+    contents[offset] ^= 0x40;
+    return contents;
+}
+
+int main() {
+    auto directory = Tests::EnterTestDirectory("SongCacheChecksumTest");
+    auto levelA = directory / "CustomLevels/A";
+    auto levelB = directory / "CustomLevels/B";
+    auto levelC = directory / "CustomLevels/C";
+    Tests::WriteLevel(levelA, "A");
+    Tests::WriteLevel(levelB, "B");
+    Tests::WriteLevel(levelC, "C");
+
+    // a cache file with the first hashes, and a journal with a changed hash and then a removal
+    Utils::ClearSongInfoCache();
+    SetSha1(levelA, '1');
+    SetSha1(levelB, '1');
+    SetSha1(levelC, '1');
+    Utils::SaveSongInfoCache();
+    SetSha1(levelB, '2');
+    Utils::SaveSongInfoCache();
+    Utils::RemoveCachedInfo(levelC);
+    Utils::SaveSongInfoCache();
+    auto cacheFile = Tests::ReadFile(cachePath);
+    auto journal = Tests::ReadFile(journalPath);
+
+    // the first journal record starts after the 8 byte header with a 64 byte record, followed by the path it's for.
+    // a damaged record and everything after it is dropped, what's left is the cache file as it was written
+    Tests::WriteFile(journalPath, FlipByte(journal, 8 + 64));
+    Utils::LoadSongInfoCache();
+    CHECK(Sha1Of(levelA) == Hash('1'));
+    CHECK(Sha1Of(levelB) == Hash('1'));
+    CHECK(Sha1Of(levelC) == Hash('1'));
+    CHECK(std::filesystem::file_size(journalPath) == 8);
+
+    // the journal ends in the checksum of the last record
+    Tests::WriteFile(journalPath, FlipByte(journal, journal.size() - 1));
+    Utils::LoadSongInfoCache();
+    CHECK(Sha1Of(levelA) == Hash('1'));
+    CHECK(Sha1Of(levelB) == Hash('2'));
+    CHECK(Sha1Of(levelC) == Hash('1'));
+
+    // a damaged or torn cache file is ignored instead of being read, the levels in it are hashed again while the journal still applies
+    for (auto const& damaged : { FlipByte(cacheFile, cacheFile.size() - 1), cacheFile.substr(0, cacheFile.size() / 2) }) {
+        Tests::WriteFile(cachePath, damaged);
+        Tests::WriteFile(journalPath, journal);
+        Utils::MappedSongCache mapped;
+        CHECK(!mapped.Open(cachePath));
+        Utils::LoadSongInfoCache();
+        CHECK(!Sha1Of(levelA).has_value());
+        CHECK(Sha1Of(levelB) == Hash('2'));
+        CHECK(!Sha1Of(levelC).has_value());
+    }
+
+    // a cache file that is replaced while it's mapped stays intact for whoever still reads it
+    Tests::WriteFile(cachePath, cacheFile);
+    Tests::WriteFile(journalPath, "");
+    Utils::MappedSongCache oldMapping;
+    CHECK(oldMapping.Open(cachePath));
+    Utils::LoadSongInfoCache();
+    Utils::ClearSongInfoCache();
+    SetSha1(levelA, '3');
+    Utils::SaveSongInfoCache();
+    CHECK(oldMapping.Find(levelA.string())->sha1 == Hash('1'));
+    CHECK(oldMapping.Find(levelC.string())->sha1 == Hash('1'));
+    Utils::MappedSongCache newMapping;
+    CHECK(newMapping.Open(cachePath));
+    CHECK(newMapping.get_Count() == 1);
+    CHECK(newMapping.Find(levelA.string())->sha1 == Hash('3'));
+    CHECK(!std::filesystem::exists(SONGCORE_DATA_PATH "/CachedSongData.bin.tmp"));
+
+    // a replacement that can't be renamed into place leaves what was there and no temporary file
+    std::filesystem::path blockedPath = SONGCORE_DATA_PATH "/Blocked";
+    Tests::WriteFile(blockedPath / "kept", "kept");
+    std::string replacement = "replacement";
+    CHECK(!Utils::WriteFileAtomically(blockedPath, std::span(reinterpret_cast<uint8_t const*>(replacement.data()), replacement.size())));
+    CHECK(Tests::ReadFile(blockedPath / "kept") == "kept");
+    CHECK(!std::filesystem::exists(SONGCORE_DATA_PATH "/Blocked.tmp"));
+
+    Tests::LeaveTestDirectory(directory);
+    return 0;
+}
@@ -0,0 +1,131 @@
+// leaves the cache files like a crash would while saving to the journal or compacting it, and checks loading them gets back the last complete save
+#include "TestHelpers.hpp"
+#include "Utils/Cache.hpp"
+#include "Utils/SongCacheFile.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace SongCore;
+
+static std::filesystem::path const cachePath = SONGCORE_DATA_PATH "/CachedSongData.bin";
+static std::filesystem::path const journalPath = SONGCORE_DATA_PATH "/CachedSongData.journal";
+
+/// @brief sets the hash of a level, on top of the fingerprints the cache takes for it
+static void SetSha1(std::filesystem::path const& levelPath, char hashChar) {
+    auto data = Utils::GetCachedInfo(levelPath);
+    CHECK(data.has_value());
+    data->sha1 = std::string(40, hashChar);
+    Utils::SetCachedInfo(levelPath, *data);
+}
+
+static std::optional<std::string> Sha1Of(std::filesystem::path const& levelPath) {
+    auto data = Utils::GetCachedInfo(levelPath);
+    CHECK(data.has_value());
+    return data->sha1;
+}
+
+static std::string Hash(char hashChar) {
+    return std::string(40, hashChar);
+}
+
+int main() {
+    auto directory = Tests::EnterTestDirectory("SongCacheJournalTest");
+    auto levelA = directory / "CustomLevels/A";
+    auto levelB = directory / "CustomLevels/B";
+    auto levelC = directory / "CustomLevels/C";
+    Tests::WriteLevel(levelA, "A");
+    Tests::WriteLevel(levelB, "B");
+    Tests::WriteLevel(levelC, "C");
+
+    // clearing makes the next save compact, so the cache file holds the first hashes and the journal starts out empty
+    Utils::ClearSongInfoCache();
+    SetSha1(levelA, '1');
+    SetSha1(levelB, '1');
+    SetSha1(levelC, '1');
+    Utils::SaveSongInfoCache();
+    CHECK(std::filesystem::exists(cachePath));
+    CHECK(!std::filesystem::exists(journalPath) || std::filesystem::file_size(journalPath) == 0);
+
+    // two saves, so the journal holds the changed hash and then the removal
+    SetSha1(levelB, '2');
+    Utils::SaveSongInfoCache();
+    Utils::RemoveCachedInfo(levelC);
+    Utils::SaveSongInfoCache();
+    auto cacheFile = Tests::ReadFile(cachePath);
+    auto journal = Tests::ReadFile(journalPath);
+
+    Utils::LoadSongInfoCache();
+    CHECK(Sha1Of(levelA) == Hash('1'));
+    CHECK(Sha1Of(levelB) == Hash('2'));
+    CHECK(!Sha1Of(levelC).has_value());
+
+    // killed while appending the removal: it never completed, everything before it did
+    Tests::WriteFile(journalPath, journal.substr(0, journal.size() - 5));
+    Utils::LoadSongInfoCache();
+    CHECK(Sha1Of(levelA) == Hash('1'));
+    CHECK(Sha1Of(levelB) == Hash('2'));
+    CHECK(Sha1Of(levelC) == Hash('1'));
+
+    // the torn record is cut off, so the next save appends behind the last complete one
+    CHECK(std::filesystem::file_size(journalPath) < journal.size() - 5);
+    Utils::RemoveCachedInfo(levelC);
+    Utils::SaveSongInfoCache();
+    Utils::LoadSongInfoCache();
+    CHECK(Sha1Of(levelB) == Hash('2'));
+    CHECK(!Sha1Of(levelC).has_value());
+
+    // killed while compacting, before the new cache file was renamed over the old one
+    Tests::WriteFile(cachePath, cacheFile);
+    Tests::WriteFile(journalPath, journal);
+    Tests::WriteFile(SONGCORE_DATA_PATH "/CachedSongData.bin.tmp", cacheFile.substr(0, cacheFile.size() / 2));
+    Utils::LoadSongInfoCache();
+    CHECK(Sha1Of(levelA) == Hash('1'));
+    CHECK(Sha1Of(levelB) == Hash('2'));
+    CHECK(!Sha1Of(levelC).has_value());
+
+    // the next compaction writes over what the interrupted one left behind
+    Utils::ClearSongInfoCache();
+    SetSha1(levelA, '1');
+    SetSha1(levelB, '2');
+    Utils::SaveSongInfoCache();
+    CHECK(!std::filesystem::exists(SONGCORE_DATA_PATH "/CachedSongData.bin.tmp"));
+    CHECK(std::filesystem::file_size(journalPath) == 0);
+
+    // killed while compacting, after the rename but before the journal was emptied: replaying it again changes nothing
+    Tests::WriteFile(journalPath, journal);
+    Utils::LoadSongInfoCache();
+    CHECK(Sha1Of(levelA) == Hash('1'));
+    CHECK(Sha1Of(levelB) == Hash('2'));
+    CHECK(!Sha1Of(levelC).has_value());
+
+    // compacting only drops the records that were in the journal when it collected the entries, what was appended while it wrote the cache file is kept
+    Utils::ClearSongInfoCache();
+    SetSha1(levelA, '1');
+    SetSha1(levelB, '1');
+    SetSha1(levelC, '1');
+    Utils::SaveSongInfoCache();
+    SetSha1(levelB, '2');
+    Utils::SaveSongInfoCache();
+    auto compactedSize = std::filesystem::file_size(journalPath);
+    Utils::RemoveCachedInfo(levelC);
+    Utils::SaveSongInfoCache();
+    CHECK(Utils::TrimSongCacheJournal(journalPath, compactedSize));
+    std::vector<std::pair<std::string, bool>> replayed;
+    CHECK(Utils::ReplaySongCacheJournal(journalPath, [&](std::string_view levelPath, std::optional<Utils::CachedSongData> const& data){ replayed.emplace_back(levelPath, data.has_value()); }) == 1);
+    CHECK(replayed.size() == 1 && replayed[0].first == levelC.string() && !replayed[0].second);
+    // the trimmed journal is appended to like any other
+    SetSha1(levelA, '3');
+    Utils::SaveSongInfoCache();
+    Utils::LoadSongInfoCache();
+    CHECK(Sha1Of(levelA) == Hash('3'));
+    CHECK(!Sha1Of(levelC).has_value());
+    // nothing appended meanwhile empties it
+    CHECK(Utils::TrimSongCacheJournal(journalPath, std::filesystem::file_size(journalPath)));
+    CHECK(std::filesystem::file_size(journalPath) == 0);
+
+    Tests::LeaveTestDirectory(directory);
+    return 0;
+}
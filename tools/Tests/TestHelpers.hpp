@@ -0,0 +1,55 @@
+#pragma once
+// helpers shared by the host tests. Every test is its own executable, it stops at the first failed check and leaves its folder behind to look at
+#include <fmt/core.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#define CHECK(condition) do { \
+    if (!(condition)) { \
+        fmt::print(stderr, "{}:{}: check failed: {}\n", __FILE__, __LINE__, #condition); \
+        std::exit(1); \
+    } \
+} while (0)
+
+namespace SongCore::Tests {
+    /// @brief makes a new empty folder for the test and makes it the working directory, so the caches kept in SONGCORE_DATA_PATH are the test's own
+    /// @return absolute path of the folder
+    inline std::filesystem::path EnterTestDirectory(std::string_view testName) {
+        auto pattern = (std::filesystem::temp_directory_path() / fmt::format("{}-XXXXXX", testName)).string();
+        CHECK(mkdtemp(pattern.data()) != nullptr);
+        std::filesystem::path directory = pattern;
+        std::filesystem::current_path(directory);
+        std::filesystem::create_directory(SONGCORE_DATA_PATH);
+        fmt::print("running in {}\n", directory.string());
+        return directory;
+    }
+
+    /// @brief removes the folder of a test that passed
+    inline void LeaveTestDirectory(std::filesystem::path const& directory) {
+        std::filesystem::current_path(directory.parent_path());
+        std::filesystem::remove_all(directory);
+    }
+
+    inline void WriteFile(std::filesystem::path const& filePath, std::string_view contents) {
+        std::filesystem::create_directories(filePath.parent_path());
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        file.write(contents.data(), contents.size());
+        CHECK(file.good());
+    }
+
+    inline std::string ReadFile(std::filesystem::path const& filePath) {
+        std::ifstream file(filePath, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    }
+
+    /// @brief writes a v2 level with a single difficulty, whose hash only depends on the song name
+    inline void WriteLevel(std::filesystem::path const& levelPath, std::string_view songName) {
+        WriteFile(levelPath / "info.dat", fmt::format(R"({{"_version":"2.0.0","_songName":"{}","_songFilename":"song.ogg","_difficultyBeatmapSets":[{{"_beatmapCharacteristicName":"Standard","_difficultyBeatmaps":[{{"_difficulty":"Easy","_beatmapFilename":"Easy.dat"}}]}}]}})", songName));
+        WriteFile(levelPath / "Easy.dat", R"({"_version":"2.0.0","_notes":[],"_obstacles":[],"_events":[]})");
+    }
+}
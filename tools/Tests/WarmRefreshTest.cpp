@@ -0,0 +1,96 @@
+// runs what the read stage of a refresh does for every level twice, like a cold and a warm refresh after a restart, and checks the warm one neither parses nor opens a single info.dat
+#include "TestHelpers.hpp"
+#include "SongLoader/LevelMetadata.hpp"
+#include "Utils/Cache.hpp"
+#include "Utils/Directory.hpp"
+
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace SongCore;
+
+static constexpr size_t levelCount = 200;
+
+/// @brief the read stage for a level: it's constructed from the song info cache if that has everything for it, otherwise its info.dat is parsed.
+/// The parse, hash and construct stages end up caching the hash, duration and metadata, which is all done here right away
+static void ReadLevel(std::filesystem::path const& levelPath, size_t& infoParses) {
+    std::vector<Utils::DirectoryEntry> entries;
+    CHECK(Utils::ListDirectory(levelPath, entries));
+    auto infoName = Utils::FindInfoDat(entries);
+    CHECK(infoName.has_value());
+
+    auto cachedInfo = Utils::GetCachedInfo(levelPath, entries);
+    CHECK(cachedInfo.has_value());
+    if (auto metadata = SongLoader::LevelMetadata::FromCachedInfo(*cachedInfo)) {
+        CHECK(metadata->songName == levelPath.filename().string());
+        return;
+    }
+
+    infoParses++;
+    CHECK(!Tests::ReadFile(levelPath / *infoName).empty());
+    SongLoader::LevelMetadata metadata;
+    metadata.songName = levelPath.filename().string();
+    CHECK(Utils::UpdateCachedInfo(levelPath, [&metadata](Utils::CachedSongData& data){
+        data.sha1 = std::string(40, 'A');
+        data.songDuration = 1;
+        data.levelMetadata = metadata.Serialize();
+    }));
+}
+
+/// @brief amount of times an info.dat was opened in the watched folders since the last call
+static size_t CountInfoDatOpens(int inotifyFd) {
+    size_t opens = 0;
+    alignas(inotify_event) char buffer[4096];
+    ssize_t length;
+    while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+        for (char* ptr = buffer; ptr < buffer + length; ) {
+            auto event = reinterpret_cast<inotify_event const*>(ptr);
+            if (event->len > 0 && std::string_view(event->name) == "info.dat") opens++;
+            ptr += sizeof(inotify_event) + event->len;
+        }
+    }
+    return opens;
+}
+
+int main() {
+    auto directory = Tests::EnterTestDirectory("WarmRefreshTest");
+    auto root = directory / "CustomLevels";
+    std::vector<std::filesystem::path> levels;
+    for (size_t i = 0; i < levelCount; i++) {
+        auto& levelPath = levels.emplace_back(root / fmt::format("Level{}", i));
+        Tests::WriteLevel(levelPath, levelPath.filename().string());
+    }
+
+    // the cold refresh parses everything
+    size_t infoParses = 0;
+    for (auto const& levelPath : levels) ReadLevel(levelPath, infoParses);
+    CHECK(infoParses == levelCount);
+
+    // the warm refresh after a restart only has what was saved
+    Utils::SaveSongInfoCache();
+    Utils::ClearSongInfoCache();
+    CHECK(Utils::LoadSongInfoCache());
+
+    int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    CHECK(inotifyFd >= 0);
+    for (auto const& levelPath : levels) CHECK(inotify_add_watch(inotifyFd, levelPath.c_str(), IN_OPEN) >= 0);
+
+    infoParses = 0;
+    for (auto const& levelPath : levels) ReadLevel(levelPath, infoParses);
+    CHECK(infoParses == 0);
+    CHECK(CountInfoDatOpens(inotifyFd) == 0);
+
+    // only a level that changed since is parsed again
+    Tests::WriteFile(levels.front() / "Easy.dat", R"({"_version":"2.0.0","_notes":[{"_time":1}],"_obstacles":[],"_events":[]})");
+    for (auto const& levelPath : levels) ReadLevel(levelPath, infoParses);
+    CHECK(infoParses == 1);
+    CHECK(CountInfoDatOpens(inotifyFd) == 1);
+
+    close(inotifyFd);
+    Tests::LeaveTestDirectory(directory);
+    return 0;
+}
@@ -0,0 +1,60 @@
+// hammers the work stealing ranges from many threads, every item has to be claimed exactly once no matter how the ranges get stolen
+#include "TestHelpers.hpp"
+#include "Utils/WorkStealing.hpp"
+
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace SongCore;
+
+/// @brief claims everything with one thread per worker, some of which are slowed down so the others have to steal from them
+static void RunRound(size_t itemCount, size_t workerCount, unsigned seed) {
+    Utils::WorkStealingRanges ranges(itemCount, workerCount);
+    CHECK(ranges.get_WorkerCount() == std::max<size_t>(workerCount, 1));
+    auto claims = std::make_unique<std::atomic<uint32_t>[]>(itemCount);
+
+    std::atomic<bool> start = false;
+    std::vector<std::thread> threads;
+    for (size_t worker = 0; worker < ranges.get_WorkerCount(); worker++) {
+        threads.emplace_back([&, worker](){
+            std::mt19937 random(seed + worker);
+            bool slow = random() % 4 == 0;
+            while (!start) std::this_thread::yield();
+            while (auto index = ranges.Next(worker)) {
+                CHECK(*index < itemCount);
+                claims[*index]++;
+                if (slow) std::this_thread::yield();
+            }
+            // once empty it stays empty
+            CHECK(!ranges.Next(worker).has_value());
+        });
+    }
+    start = true;
+    for (auto& thread : threads) thread.join();
+
+    for (size_t i = 0; i < itemCount; i++) {
+        if (claims[i] != 1) fmt::print(stderr, "item {} of {} over {} workers was claimed {} times\n", i, itemCount, workerCount, claims[i].load());
+        CHECK(claims[i] == 1);
+    }
+}
+
+int main() {
+    // edge cases first: nothing to do, fewer items than workers, and no workers at all
+    for (size_t workerCount : { 0, 1, 2, 7, 16 }) {
+        for (size_t itemCount : { 0, 1, 2, 3, 15, 16, 17 }) RunRound(itemCount, workerCount, 1);
+    }
+
+    unsigned hardwareConcurrency = std::max(std::thread::hardware_concurrency(), 2u);
+    std::mt19937 random(1234);
+    for (int round = 0; round < 300; round++) {
+        size_t workerCount = 1 + random() % (hardwareConcurrency * 2);
+        size_t itemCount = random() % 20000;
+        RunRound(itemCount, workerCount, random());
+    }
+
+    fmt::print("passed\n");
+    return 0;
+}
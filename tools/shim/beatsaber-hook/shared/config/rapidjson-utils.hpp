@@ -0,0 +1,6 @@
+#pragma once
+// stands in for beatsaber-hook's rapidjson include, with the same std::string support
+#define RAPIDJSON_HAS_STDSTRING 1
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
@@ -0,0 +1,13 @@
+#pragma once
+// stands in for the parts of beatsaber-hook's il2cpp utils the shared utils use, there is no il2cpp to attach to on the host
+#include <filesystem>
+#include <string_view>
+#include <thread>
+
+namespace il2cpp_utils {
+    using il2cpp_aware_thread = std::thread;
+}
+
+inline bool fileexists(std::string_view filename) {
+    return std::filesystem::exists(filename);
+}
@@ -0,0 +1,4 @@
+#include "config.hpp"
+
+// the host tools run with the default config, they never load the mod's config file
+Config config;
@@ -0,0 +1,10 @@
+#pragma once
+// stands in for the mod's logging.hpp, so the shared utils log to stderr on the host
+#include <fmt/core.h>
+#include <cstdio>
+
+#define INFO(str, ...) fmt::print(stderr, "[INFO] " str "\n" __VA_OPT__(, __VA_ARGS__))
+#define ERROR(str, ...) fmt::print(stderr, "[ERROR] " str "\n" __VA_OPT__(, __VA_ARGS__))
+#define CRITICAL(str, ...) fmt::print(stderr, "[CRITICAL] " str "\n" __VA_OPT__(, __VA_ARGS__))
+#define DEBUG(str, ...) do {} while (0)
+#define WARNING(str, ...) fmt::print(stderr, "[WARNING] " str "\n" __VA_OPT__(, __VA_ARGS__))
@@ -0,0 +1,3 @@
+#pragma once
+// stands in for paper's bundled utfcpp with the system one
+#include <utf8.h>